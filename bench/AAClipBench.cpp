@@ -240,6 +240,88 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench tests combining two complex aaclips.
+class AAClipOpBench : public Benchmark {
+    SkString        fName;
+    SkAAClip        fA, fB;
+    SkRegion::Op    fOp;
+
+public:
+    AAClipOpBench(SkRegion::Op op, const char name[]) : fOp(op) {
+        fName.printf("aaclip_op_%s", name);
+
+        const SkRegion clip(SkIRect::MakeWH(640, 480));
+        SkPath path;
+        // rings, so that every row has several runs
+        for (int i = 0; i < 4; ++i) {
+            path.addCircle(200, 240, 40.5f + 40 * i);
+        }
+        path.setFillType(SkPathFillType::kEvenOdd);
+        fA.setPath(path, &clip, true);
+        path.offset(240, 0);
+        fB.setPath(path, &clip, true);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkAAClip clip;
+            clip.op(fA, fB, fOp);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// This bench sets up the same nested clips for each of many cells, as a UI drawing
+// a list does, with clip paths that are kept from one draw to the next.
+class RepeatedNestedClipBench : public Benchmark {
+    static constexpr int kCells = 8;
+    static constexpr int kCellSize = 50;
+
+    SkPath  fOuter;
+    SkPath  fInner[kCells];
+
+public:
+    RepeatedNestedClipBench() {
+        fOuter.addRoundRect(SkRect::MakeWH(kCells * kCellSize, kCells * kCellSize), 20, 20);
+        for (int i = 0; i < kCells; ++i) {
+            fInner[i].addRoundRect(SkRect::MakeXYWH(2.5f, i * kCellSize + 2.5f,
+                                                    kCells * kCellSize - 5, kCellSize - 5),
+                                   8, 8);
+        }
+    }
+
+protected:
+    const char* onGetName() override { return "nested_aaclip_repeated_AA"; }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            canvas->save();
+            canvas->clipPath(fOuter, true);
+            for (int j = 0; j < kCells; ++j) {
+                canvas->save();
+                canvas->clipPath(fInner[j], true);
+                paint.setColor(0xFF000000 | (j * 0x1F3D5B));
+                canvas->drawPaint(paint);
+                canvas->restore();
+            }
+            canvas->restore();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new AAClipBuilderBench(false, false);)
@@ -253,3 +335,7 @@ DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
+DEF_BENCH(return new AAClipOpBench(SkRegion::kIntersect_Op, "intersect");)
+DEF_BENCH(return new AAClipOpBench(SkRegion::kUnion_Op, "union");)
+DEF_BENCH(return new AAClipOpBench(SkRegion::kDifference_Op, "difference");)
+DEF_BENCH(return new RepeatedNestedClipBench();)
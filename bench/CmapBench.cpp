@@ -12,6 +12,8 @@
 #include "include/utils/SkRandom.h"
 #include "src/utils/SkCharToGlyphCache.h"
 #include "src/utils/SkUTF.h"
+#include "tools/Resources.h"
+#include "tools/ToolUtils.h"
 
 enum {
     NGLYPHS = 100
@@ -65,6 +67,18 @@ static void findcache_proc(const Rec& r) {
     }
 }
 
+enum class CmapText {
+    kRandomBMP,  // any character in the Basic Multilingual Plane
+    kLatin1,     // mostly ASCII, as in most Western text
+};
+
+// Which typeface to map characters with, to compare the font managers.
+enum class CmapFace {
+    kDefault,   // the platform font manager's default typeface
+    kResource,  // a font file loaded by the platform font manager, FreeType on Linux
+    kPortable,  // the test typefaces from tools/fonts, which have their own cmap
+};
+
 class CMAPBench : public Benchmark {
     TypefaceProc fProc;
     SkString     fName;
@@ -72,21 +86,42 @@ class CMAPBench : public Benchmark {
     SkFont       fFont;
     SkCharToGlyphCache fCache;
     int          fCount;
+    CmapFace     fFace;
 
 public:
-    CMAPBench(TypefaceProc proc, const char name[], int count) {
+    CMAPBench(TypefaceProc proc, const char name[], int count,
+              CmapText text = CmapText::kRandomBMP, CmapFace face = CmapFace::kDefault) {
         SkASSERT(count <= NGLYPHS);
 
         fProc = proc;
         fName.printf("%s_%d", name, count);
+        if (text == CmapText::kLatin1) {
+            fName.append("_latin1");
+        }
+        if (face == CmapFace::kResource) {
+            fName.append("_resource");
+        } else if (face == CmapFace::kPortable) {
+            fName.append("_portable");
+        }
         fCount = count;
+        fFace = face;
 
         SkRandom rand;
         for (int i = 0; i < count; ++i) {
-            fText[i] = rand.nextU() & 0xFFFF;
+            if (text == CmapText::kLatin1) {
+                // Latin-1 text repeats characters; only the first of each goes in fCache.
+                fText[i] = ' ' + rand.nextULessThan(0x5F);
+                if (fCache.findGlyphIndex(fText[i]) >= 0) {
+                    continue;
+                }
+            } else {
+                // Keep the characters unique, so addcache_proc adds every one of them.
+                do {
+                    fText[i] = rand.nextU() & 0xFFFF;
+                } while (fCache.findGlyphIndex(fText[i]) >= 0);
+            }
             fCache.addCharAndGlyph(fText[i], i);
         }
-        fFont.setTypeface(SkTypeface::MakeDefault());
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -98,6 +133,22 @@ protected:
         return fName.c_str();
     }
 
+    void onDelayedSetup() override {
+        sk_sp<SkTypeface> face;
+        switch (fFace) {
+            case CmapFace::kDefault:
+                face = SkTypeface::MakeDefault();
+                break;
+            case CmapFace::kResource:
+                face = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+                break;
+            case CmapFace::kPortable:
+                face = ToolUtils::create_portable_typeface("sans-serif", SkFontStyle());
+                break;
+        }
+        fFont.setTypeface(face ? face : SkTypeface::MakeDefault());
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
         fProc({fCache, loops, fFont, fText, fCount});
     }
@@ -122,3 +173,14 @@ DEF_BENCH( return new CMAPBench(textToGlyphs_proc, "font_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(addcache_proc, "addcache_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(findcache_proc, "findcache_charToGlyph", BIG); )
+
+DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG,
+                                CmapText::kLatin1); )
+DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG,
+                                CmapText::kLatin1, CmapFace::kResource); )
+DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG,
+                                CmapText::kRandomBMP, CmapFace::kResource); )
+DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG,
+                                CmapText::kLatin1, CmapFace::kPortable); )
+DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG,
+                                CmapText::kRandomBMP, CmapFace::kPortable); )
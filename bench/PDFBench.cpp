@@ -153,15 +153,61 @@ private:
     sk_sp<SkImage> fImage;
 };
 
+/** Draw a 512x512 JPEG at 64x64 points, with and without
+    SkPDF::Metadata::fDownsampleJpegs. */
+class PDFJpegDownsampleBench : public Benchmark {
+public:
+    PDFJpegDownsampleBench(bool downsample) : fDownsample(downsample) {}
+
+protected:
+    const char* onGetName() override {
+        return fDownsample ? "PDFJpegDownsample_on" : "PDFJpegDownsample_off";
+    }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        fImage = GetResourceAsImage("images/mandrill_512_q075.jpg");
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fImage) {
+            return;
+        }
+        while (loops-- > 0) {
+            SkNullWStream nullStream;
+            this->makeDocument(&nullStream);
+        }
+    }
+
+private:
+    void makeDocument(SkWStream* stream) {
+        SkPDF::Metadata metadata;
+        metadata.fDownsampleJpegs = fDownsample;
+        auto doc = SkPDF::MakeDocument(stream, metadata);
+        SkCanvas* canvas = doc->beginPage(256, 256);
+        canvas->drawImageRect(fImage, SkRect::MakeWH(64, 64), nullptr);
+        doc->close();
+    }
+
+    bool fDownsample;
+    sk_sp<SkImage> fImage;
+};
+
 /** Test calling DEFLATE on a 78k PDF command stream. Used for measuring
-    alternate zlib settings, usage, and library versions. */
+    alternate zlib settings, usage, and library versions. Throughput in MB/s
+    is the 78k input divided by the measured time. */
 class PDFCompressionBench : public Benchmark {
 public:
-    PDFCompressionBench() {}
+    PDFCompressionBench(const char* name = "PDFCompression",
+                        SkPDF::Metadata::CompressionLevel level =
+                                SkPDF::Metadata::CompressionLevel::kDefault,
+                        SkPDF::Metadata::CompressionStrategy strategy =
+                                SkPDF::Metadata::CompressionStrategy::kDefault)
+        : fName(name), fLevel(level), fStrategy(strategy) {}
     ~PDFCompressionBench() override {}
 
 protected:
-    const char* onGetName() override { return "PDFCompression"; }
+    const char* onGetName() override { return fName; }
     bool isSuitableFor(Backend backend) override {
         return backend == kNonRendering_Backend;
     }
@@ -173,13 +219,23 @@ protected:
         if (!fAsset) { return; }
         while (loops-- > 0) {
             SkNullWStream wStream;
-            SkPDFDocument doc(&wStream, SkPDF::Metadata());
-            doc.beginPage(256, 256);
-            (void)SkPDFStreamOut(nullptr, fAsset->duplicate(), &doc, true);
+            this->compress(&wStream);
        }
     }
 
 private:
+    void compress(SkWStream* wStream) {
+        SkPDF::Metadata metadata;
+        metadata.fCompressionLevel = fLevel;
+        metadata.fCompressionStrategy = fStrategy;
+        SkPDFDocument doc(wStream, metadata);
+        doc.beginPage(256, 256);
+        (void)SkPDFStreamOut(nullptr, fAsset->duplicate(), &doc, true);
+    }
+
+    const char* fName;
+    SkPDF::Metadata::CompressionLevel fLevel;
+    SkPDF::Metadata::CompressionStrategy fStrategy;
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
@@ -199,8 +255,15 @@ struct PDFColorComponentBench : public Benchmark {
 };
 
 struct PDFShaderBench : public Benchmark {
+    PDFShaderBench(const char* name = "PDFShader",
+                   SkShader::GradientType type = SkShader::kLinear_GradientType,
+                   SkTileMode mode = SkTileMode::kClamp)
+        : fName(name), fType(type), fMode(mode) {}
+    const char* fName;
+    SkShader::GradientType fType;
+    SkTileMode fMode;
     sk_sp<SkShader> fShader;
-    const char* onGetName() final { return "PDFShader"; }
+    const char* onGetName() final { return fName; }
     bool isSuitableFor(Backend b) final { return b == kNonRendering_Backend; }
     void onDelayedSetup() final {
         const SkPoint pts[2] = {{0.0f, 0.0f}, {100.0f, 100.0f}};
@@ -208,9 +271,13 @@ struct PDFShaderBench : public Benchmark {
             SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE,
             SK_ColorWHITE, SK_ColorBLACK,
         };
-        fShader = SkGradientShader::MakeLinear(
-                pts, colors, nullptr, SK_ARRAY_COUNT(colors),
-                SkTileMode::kClamp);
+        if (fType == SkShader::kRadial_GradientType) {
+            fShader = SkGradientShader::MakeRadial(
+                    pts[0], 50.0f, colors, nullptr, SK_ARRAY_COUNT(colors), fMode);
+        } else {
+            fShader = SkGradientShader::MakeLinear(
+                    pts, colors, nullptr, SK_ARRAY_COUNT(colors), fMode);
+        }
     }
     void onDraw(int loops, SkCanvas*) final {
         SkASSERT(fShader);
@@ -304,9 +371,27 @@ struct PDFClipPathBenchmark : public Benchmark {
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
+DEF_BENCH(return new PDFJpegDownsampleBench(false);)
+DEF_BENCH(return new PDFJpegDownsampleBench(true);)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFCompressionBench("PDFCompression_level1",
+                                         SkPDF::Metadata::CompressionLevel::kLowButFast);)
+DEF_BENCH(return new PDFCompressionBench("PDFCompression_level9",
+                                         SkPDF::Metadata::CompressionLevel::kHighButSlow);)
+DEF_BENCH(return new PDFCompressionBench("PDFCompression_rle",
+                                         SkPDF::Metadata::CompressionLevel::kDefault,
+                                         SkPDF::Metadata::CompressionStrategy::kRLE);)
+DEF_BENCH(return new PDFCompressionBench("PDFCompression_huffman",
+                                         SkPDF::Metadata::CompressionLevel::kDefault,
+                                         SkPDF::Metadata::CompressionStrategy::kHuffmanOnly);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
+DEF_BENCH(return new PDFShaderBench("PDFShader_linear_repeat", SkShader::kLinear_GradientType,
+                                    SkTileMode::kRepeat);)
+DEF_BENCH(return new PDFShaderBench("PDFShader_linear_mirror", SkShader::kLinear_GradientType,
+                                    SkTileMode::kMirror);)
+DEF_BENCH(return new PDFShaderBench("PDFShader_radial_repeat", SkShader::kRadial_GradientType,
+                                    SkTileMode::kRepeat);)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 DEF_BENCH(return new PDFClipPathBenchmark;)
 
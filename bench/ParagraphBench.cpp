@@ -12,6 +12,7 @@
 #include "tools/Resources.h"
 
 #include <cfloat>
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
@@ -46,10 +47,73 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
+        }
+    }
+};
+
+// Lays out many small paragraphs sharing one FontCollection, either one after another or all
+// at once with layoutAll() on a thread pool.
+struct ParagraphBatchBench : public Benchmark {
+    ParagraphBatchBench(const char* r, const char* n, bool parallel)
+            : fResource(r), fName(n), fParallel(parallel) {}
+    const char* fResource;
+    const char* fName;
+    bool fParallel;
+    sk_sp<FontCollection> fFontCollection;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+    std::vector<Paragraph*> fBatch;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData(fResource);
+        if (!data) {
+            return;
+        }
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+
+        // Every sentence of the resource, many times over, is its own paragraph.
+        const char* text = (const char*)data->data();
+        const char* end = text + data->size();
+        for (int copy = 0; copy < 16; ++copy) {
+            for (const char* start = text; start < end;) {
+                const char* stop = start;
+                while (stop < end && *stop != '.' && *stop != '\n') { ++stop; }
+                if (stop < end) { ++stop; }
+                ParagraphBuilderImpl builder(paragraph_style, fFontCollection);
+                builder.addText(start, stop - start);
+                fParagraphs.push_back(builder.Build());
+                fBatch.push_back(fParagraphs.back().get());
+                start = stop;
+            }
+        }
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (fBatch.empty()) {
+            return;
+        }
+        while (loops-- > 0) {
+            for (Paragraph* paragraph : fBatch) {
+                paragraph->markDirty();
+            }
+            fFontCollection->getParagraphCache()->reset();
+            if (fParallel) {
+                layoutAll(SkMakeSpan(fBatch), 300, *fExecutor);
+            } else {
+                for (Paragraph* paragraph : fBatch) {
+                    paragraph->layout(300);
+                }
+            }
         }
     }
 };
@@ -61,4 +125,7 @@ struct ParagraphBench : public Benchmark {
 PARAGRAPH_BENCH(english)
 #undef PARAGRAPH_BENCH
 
+DEF_BENCH(return new ParagraphBatchBench("text/english.txt", "paragraph_batch_english_serial", false);)
+DEF_BENCH(return new ParagraphBatchBench("text/english.txt", "paragraph_batch_english_parallel", true);)
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -9,10 +9,13 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorPriv.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
+#include "include/effects/SkDashPathEffect.h"
 #include "include/private/SkTArray.h"
 #include "include/utils/SkRandom.h"
 
@@ -1108,6 +1111,194 @@ private:
 };
 
 
+// Draws the same icon sized path at many places, like the markers on a map, with and without
+// the raster backend's path mask cache.
+class SamePathManyTimesBench : public Benchmark {
+    SkString fName;
+    SkPath   fPath;
+    bool     fStroke;
+    bool     fCached;
+    size_t   fOldLimit = 0;
+
+public:
+    SamePathManyTimesBench(bool stroke, bool cached) : fStroke(stroke), fCached(cached) {
+        fName.printf("path_same_many_times_%s%s", stroke ? "stroke" : "fill",
+                     cached ? "_cached" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        // A pin: a circle on top of a point, with a hole in the middle.
+        fPath.moveTo(16, 40);
+        fPath.cubicTo(10, 28, 2, 22, 2, 14);
+        fPath.cubicTo(2, 6, 8, 0, 16, 0);
+        fPath.cubicTo(24, 0, 30, 6, 30, 14);
+        fPath.cubicTo(30, 22, 22, 28, 16, 40);
+        fPath.close();
+        fPath.addCircle(16, 14, 6, SkPathDirection::kCCW);
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        fOldLimit = SkGraphics::SetPathMaskCacheByteLimit(fCached ? 1 << 20 : 0);
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        SkGraphics::SetPathMaskCacheByteLimit(fOldLimit);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        if (fStroke) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(2);
+        }
+        for (int i = 0; i < loops; i++) {
+            for (int y = 0; y < 10; ++y) {
+                for (int x = 0; x < 10; ++x) {
+                    canvas->save();
+                    canvas->translate(x * 40.0f, y * 44.0f);
+                    canvas->drawPath(fPath, paint);
+                    canvas->restore();
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+// Appends points to a path one at a time, and looks at the path after each one, like a drawing
+// tool showing a stroke as it is being drawn.
+class PathStreamingBench : public Benchmark {
+    static constexpr int kPoints = 4096;
+
+    SkString fName;
+    SkPoint  fPoints[kPoints];
+    bool     fUseBuilder;
+
+public:
+    PathStreamingBench(bool useBuilder) : fUseBuilder(useBuilder) {
+        fName.printf("path_streaming_%s", useBuilder ? "builder" : "path");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kPoints; ++i) {
+            fPoints[i].set(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        volatile SkScalar junk = 0;
+        for (int i = 0; i < loops; i++) {
+            if (fUseBuilder) {
+                SkPathBuilder builder;
+                builder.moveTo(fPoints[0]);
+                for (int j = 1; j < kPoints; ++j) {
+                    builder.lineTo(fPoints[j]);
+                    SkPath frame = builder.snapshot();
+                    junk = junk + frame.getBounds().width();
+                }
+            } else {
+                SkPath path;
+                path.moveTo(fPoints[0]);
+                for (int j = 1; j < kPoints; ++j) {
+                    path.lineTo(fPoints[j]);
+                    SkPath frame = path;
+                    junk = junk + frame.getBounds().width();
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+// Strokes a long polyline, like a GPS track or a dense chart series, either directly or by
+// building the outline of the stroke as a path and filling that.
+class PolylineStrokeBench : public Benchmark {
+    SkString fName;
+    SkPath   fPath;
+    bool     fDashed;
+    bool     fDirect;
+
+public:
+    PolylineStrokeBench(bool dashed, bool direct) : fDashed(dashed), fDirect(direct) {
+        fName.printf("path_polyline_stroke%s_%s", dashed ? "_dashed" : "",
+                     direct ? "direct" : "outline");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        constexpr int kPoints = 10000;
+        SkRandom rand;
+        fPath.incReserve(kPoints);
+        for (int i = 0; i < kPoints; ++i) {
+            SkScalar x = i * (620.0f / kPoints) + 10,
+                     y = 240 + 150 * SkScalarSin(x * 0.02f) + rand.nextSScalar1() * 2;
+            if (i == 0) {
+                fPath.moveTo(x, y);
+            } else {
+                fPath.lineTo(x, y);
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setStrokeWidth(4);
+        paint.setStrokeJoin(SkPaint::kRound_Join);
+        if (fDashed) {
+            const SkScalar intervals[] = { 12, 6 };
+            paint.setPathEffect(SkDashPathEffect::Make(intervals, 2, 0));
+        }
+        for (int i = 0; i < loops; i++) {
+            if (fDirect) {
+                canvas->drawPath(fPath, paint);
+            } else {
+                SkPath outline;
+                paint.getFillPath(fPath, &outline);
+                SkPaint fillPaint;
+                fillPaint.setAntiAlias(true);
+                canvas->drawPath(outline, fillPaint);
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 const SkRect ConservativelyContainsBench::kBounds = SkRect::MakeWH(SkIntToScalar(100), SkIntToScalar(100));
 const SkSize ConservativelyContainsBench::kQueryMin = {SkIntToScalar(1), SkIntToScalar(1)};
 const SkSize ConservativelyContainsBench::kQueryMax = {SkIntToScalar(40), SkIntToScalar(40)};
@@ -1147,6 +1338,19 @@ DEF_BENCH( return new AAAConcavePathBench(FLAGS10); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS00); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS10); )
 
+DEF_BENCH( return new SamePathManyTimesBench(false, false); )
+DEF_BENCH( return new SamePathManyTimesBench(false, true); )
+DEF_BENCH( return new SamePathManyTimesBench(true, false); )
+DEF_BENCH( return new SamePathManyTimesBench(true, true); )
+
+DEF_BENCH( return new PathStreamingBench(false); )
+DEF_BENCH( return new PathStreamingBench(true); )
+
+DEF_BENCH( return new PolylineStrokeBench(false, false); )
+DEF_BENCH( return new PolylineStrokeBench(false, true); )
+DEF_BENCH( return new PolylineStrokeBench(true, false); )
+DEF_BENCH( return new PolylineStrokeBench(true, true); )
+
 DEF_BENCH( return new SawToothPathBench(FLAGS00); )
 DEF_BENCH( return new SawToothPathBench(FLAGS01); )
 
@@ -8,6 +8,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorPriv.h"
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
@@ -120,8 +121,69 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Finds evenly spaced positions and tangents along a contour of curves, like placing glyphs or
+// stamps along a path, one distance at a time or all together.
+class ContourMeasurePosTanBench : public Benchmark {
+    static constexpr int kCount = 4096;
+
+    SkString                fName;
+    sk_sp<SkContourMeasure> fContour;
+    SkScalar                fDistances[kCount];
+    SkPoint                 fPositions[kCount];
+    SkVector                fTangents[kCount];
+    bool                    fBatch;
+
+public:
+    ContourMeasurePosTanBench(bool batch) : fBatch(batch) {
+        fName.printf("contourmeasure_postan_%s", batch ? "batch" : "single");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPath path;
+        path.moveTo(0, 0);
+        for (int i = 0; i < 100; ++i) {
+            SkPoint pts[4];
+            rand_pts(rand, pts);
+            path.cubicTo(pts[0] * 100, pts[1] * 100, pts[2] * 100);
+        }
+        fContour = SkContourMeasureIter(path, false).next();
+
+        for (int i = 0; i < kCount; ++i) {
+            fDistances[i] = fContour->length() * i / kCount;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fBatch) {
+                (void)fContour->getPosTans(fDistances, kCount, fPositions, fTangents);
+            } else {
+                for (int j = 0; j < kCount; ++j) {
+                    (void)fContour->getPosTan(fDistances[j], &fPositions[j], &fTangents[j]);
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new PathIterBench(PathIterType::kIter); )
 DEF_BENCH( return new PathIterBench(PathIterType::kRaw); )
 DEF_BENCH( return new PathIterBench(PathIterType::kEdge); )
+
+DEF_BENCH( return new ContourMeasurePosTanBench(false); )
+DEF_BENCH( return new ContourMeasurePosTanBench(true); )
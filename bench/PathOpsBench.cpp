@@ -6,6 +6,7 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
@@ -51,9 +52,11 @@ private:
 class PathOpsSimplifyBench : public Benchmark {
     SkString    fName;
     SkPath      fPath;
+    int         fRepeat;
 
 public:
-    PathOpsSimplifyBench(const char suffix[], const SkPath& path) : fPath(path) {
+    PathOpsSimplifyBench(const char suffix[], const SkPath& path, int repeat = 100)
+            : fPath(path), fRepeat(repeat) {
         fName.printf("pathops_simplify_%s", suffix);
     }
 
@@ -68,7 +71,7 @@ protected:
 
     void onDraw(int loops, SkCanvas* canvas) override {
         for (int i = 0; i < loops; i++) {
-            for (int j = 0; j < 100; ++j) {
+            for (int j = 0; j < fRepeat; ++j) {
                 SkPath result;
                 Simplify(fPath, &result);
             }
@@ -96,3 +99,95 @@ static SkPath makerects() {
 }
 
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
+
+// Two overlapping rings, each a closed polyline with count jittered points. Each ring has many
+// segments but few of them cross, which is the case where testing every pair of segments for
+// intersection costs the most.
+static SkPath makepolyline(int count) {
+    SkRandom rand;
+    SkPath path;
+    for (SkScalar cx : {400.0f, 600.0f}) {
+        for (int i = 0; i < count; ++i) {
+            SkScalar angle = i * 2 * SK_ScalarPI / count;
+            SkScalar radius = 300 + rand.nextSScalar1() * 4;
+            SkPoint pt = {cx + radius * SkScalarCos(angle), 500 + radius * SkScalarSin(angle)};
+            if (i == 0) {
+                path.moveTo(pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+    }
+    return path;
+}
+
+DEF_BENCH( return new PathOpsSimplifyBench("polyline_1000", makepolyline(1000), 1); )
+DEF_BENCH( return new PathOpsSimplifyBench("polyline_10000", makepolyline(10000), 1); )
+
+// Unions many small, partly overlapping shapes with SkOpBuilder, as when merging map features.
+class PathOpsUnionBench : public Benchmark {
+public:
+    enum class Mode { kResolve, kBalanced, kBalancedThreaded };
+
+    PathOpsUnionBench(int count, Mode mode) : fMode(mode) {
+        static const char* kModeNames[] = {"resolve", "balanced", "balanced_threaded"};
+        fName.printf("pathops_union_%d_%s", count, kModeNames[(int)mode]);
+
+        SkRandom rand;
+        for (int i = 0; i < count; ++i) {
+            SkScalar x = rand.nextRangeScalar(0, 2000),
+                     y = rand.nextRangeScalar(0, 2000),
+                     r = rand.nextRangeScalar(2, 12);
+            SkPath& path = fPaths.push_back();
+            if (rand.nextBool()) {
+                path.addCircle(x, y, r);
+            } else {
+                path.addRect({x - r, y - r, x + r, y + r});
+            }
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        if (fMode == Mode::kBalancedThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            if (fMode == Mode::kResolve) {
+                builder.resolve(&result);
+            } else {
+                builder.resolveBalanced(&result, fExecutor.get());
+            }
+        }
+    }
+
+private:
+    SkString                    fName;
+    SkTArray<SkPath>            fPaths;
+    Mode                        fMode;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsUnionBench(1000, PathOpsUnionBench::Mode::kResolve); )
+DEF_BENCH( return new PathOpsUnionBench(1000, PathOpsUnionBench::Mode::kBalanced); )
+DEF_BENCH( return new PathOpsUnionBench(10000, PathOpsUnionBench::Mode::kBalanced); )
+DEF_BENCH( return new PathOpsUnionBench(10000, PathOpsUnionBench::Mode::kBalancedThreaded); )
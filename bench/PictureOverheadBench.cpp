@@ -6,9 +6,13 @@
  */
 
 #include "bench/Benchmark.h"
+#include "bench/RecordingBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRRect.h"
+#include "include/utils/SkRandom.h"
 
 class ClipOverheadRecordingBench : public Benchmark {
 public:
@@ -40,3 +44,31 @@ private:
     }
 };
 DEF_BENCH( return new ClipOverheadRecordingBench; )
+
+// A serialized picture of many small paths, like a map tile, where loading the picture can
+// take longer than drawing the part of it that is visible.
+static sk_sp<SkData> make_many_paths_picture() {
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording({0,0, 1024,1024});
+
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 2000; i++) {
+        SkScalar x = rand.nextRangeScalar(0, 1024),
+                 y = rand.nextRangeScalar(0, 1024);
+        SkPath path;
+        path.moveTo(x, y);
+        for (int j = 0; j < 8; j++) {
+            path.lineTo(x + rand.nextRangeScalar(-20, 20), y + rand.nextRangeScalar(-20, 20));
+        }
+        path.close();
+        paint.setColor(rand.nextU() | 0xff000000);
+        canvas->drawPath(path, paint);
+    }
+    return rec.finishRecordingAsPicture()->serialize();
+}
+DEF_BENCH( return new FirstPixelPictureBench("picture_many_paths", make_many_paths_picture(),
+                                             false); )
+DEF_BENCH( return new FirstPixelPictureBench("picture_many_paths", make_many_paths_picture(),
+                                             true); )
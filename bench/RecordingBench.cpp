@@ -71,3 +71,41 @@ void DeserializePictureBench::onDraw(int loops, SkCanvas*) {
         SkPicture::MakeFromData(fEncodedPicture.get());
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "include/core/SkCanvas.h"
+
+FirstPixelPictureBench::FirstPixelPictureBench(const char* name, sk_sp<SkData> data, bool lazy)
+    : fName(SkStringPrintf("%s_first_pixel%s", name, lazy ? "_lazy" : ""))
+    , fEncodedPicture(std::move(data))
+    , fLazy(lazy)
+{}
+
+const char* FirstPixelPictureBench::onGetName() {
+    return fName.c_str();
+}
+
+bool FirstPixelPictureBench::isSuitableFor(Backend backend) {
+    return backend == kNonRendering_Backend;
+}
+
+SkIPoint FirstPixelPictureBench::onGetSize() {
+    return SkIPoint::Make(256, 256);
+}
+
+void FirstPixelPictureBench::onDelayedSetup() {
+    fBitmap.allocN32Pixels(256, 256);
+}
+
+void FirstPixelPictureBench::onDraw(int loops, SkCanvas*) {
+    for (int i = 0; i < loops; ++i) {
+        fPicture = nullptr;
+        fPicture = fLazy ? SkPicture::MakeLazyFromData(fEncodedPicture)
+                         : SkPicture::MakeFromData(fEncodedPicture.get());
+        if (fPicture) {
+            SkCanvas canvas(fBitmap);
+            canvas.clear(SK_ColorWHITE);
+            canvas.drawPicture(fPicture);
+        }
+    }
+}
@@ -9,6 +9,7 @@
 #define RecordingBench_DEFINED
 
 #include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkPicture.h"
 
 class PictureCentricBench : public Benchmark {
@@ -57,4 +58,28 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Loads an encoded picture and draws it once into a small raster canvas: the time until the
+// first pixels of a picture loaded from a file are ready. The last picture loaded is kept, so
+// the memory it uses is included in the resident set size nanobench reports.
+class FirstPixelPictureBench : public Benchmark {
+public:
+    FirstPixelPictureBench(const char* name, sk_sp<SkData> encodedPicture, bool lazy);
+
+protected:
+    const char* onGetName() override;
+    bool isSuitableFor(Backend) override;
+    SkIPoint onGetSize() override;
+    void onDelayedSetup() override;
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    SkString         fName;
+    sk_sp<SkData>    fEncodedPicture;
+    bool             fLazy;
+    SkBitmap         fBitmap;
+    sk_sp<SkPicture> fPicture;
+
+    typedef Benchmark INHERITED;
+};
+
 #endif//RecordingBench_DEFINED
@@ -11,7 +11,7 @@
 #include "include/utils/SkRandom.h"
 
 #include "src/core/SkMathPriv.h"
-#include "src/gpu/GrRectanizerSkyline.h"
+#include "src/core/SkRectanizerSkyline.h"
 
 /**
  * This bench exercises Ganesh' GrRectanizer classes. It exercises the following
@@ -66,7 +66,7 @@ protected:
     void onDelayedSetup() override {
         SkASSERT(nullptr == fRectanizer.get());
 
-        fRectanizer.reset(new GrRectanizerSkyline(kWidth, kHeight));
+        fRectanizer.reset(new SkRectanizerSkyline(kWidth, kHeight));
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -100,7 +100,7 @@ protected:
 private:
     SkString                    fName;
     RectType                    fRectType;
-    std::unique_ptr<GrRectanizerSkyline> fRectanizer;
+    std::unique_ptr<SkRectanizerSkyline> fRectanizer;
 
     typedef Benchmark INHERITED;
 };
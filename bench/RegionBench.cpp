@@ -19,6 +19,11 @@ static bool sect_proc(SkRegion& a, SkRegion& b) {
     return result.op(a, b, SkRegion::kIntersect_Op);
 }
 
+static bool xor_proc(SkRegion& a, SkRegion& b) {
+    SkRegion result;
+    return result.op(a, b, SkRegion::kXOR_Op);
+}
+
 static bool diff_proc(SkRegion& a, SkRegion& b) {
     SkRegion result;
     return result.op(a, b, SkRegion::kDifference_Op);
@@ -87,15 +92,19 @@ public:
         return SkIRect::MakeXYWH(x, y, w >> 1, h >> 1);
     }
 
-    RegionBench(int count, Proc proc, const char name[])  {
+    // With sideBySide, fB is moved right so that it only overlaps the right part of fA.
+    RegionBench(int count, Proc proc, const char name[], bool sideBySide = false)  {
         fProc = proc;
-        fName.printf("region_%s_%d", name, count);
+        fName.printf("region_%s%s_%d", name, sideBySide ? "_sidebyside" : "", count);
 
         SkRandom rand;
         for (int i = 0; i < count; i++) {
             fA.op(randrect(rand), SkRegion::kXOR_Op);
             fB.op(randrect(rand), SkRegion::kXOR_Op);
         }
+        if (sideBySide) {
+            fB.translate(W, 0);
+        }
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -129,3 +138,5 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+DEF_BENCH(return new RegionBench(SMALL, union_proc, "union", true);)
+DEF_BENCH(return new RegionBench(SMALL, xor_proc, "xor", true);)
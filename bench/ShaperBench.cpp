@@ -5,6 +5,7 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkString.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "tools/Resources.h"
 
@@ -35,8 +36,52 @@ struct ShaperBench : public Benchmark {
         }
     }
 };
+
+// Shapes the same paragraph many times with line wrapping, so every line of every repetition
+// goes back through the shaper with the same font.
+struct ShaperRepeatBench : public Benchmark {
+    ShaperRepeatBench(const char* r, const char* n, int repeat, bool wordCache = false)
+        : fResource(r), fName(n), fRepeat(repeat), fWordCache(wordCache) {}
+    std::unique_ptr<SkShaper> fShaper;
+    SkString fText;
+    const char* fResource;
+    const char* fName;
+    int fRepeat;
+    bool fWordCache;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        fShaper = SkShaper::Make();
+        sk_sp<SkData> data = GetResourceAsData(fResource);
+        if (!data) { return; }
+        for (int i = 0; i < fRepeat; ++i) {
+            fText.append((const char*)data->data(), data->size());
+            fText.append("\n");
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (fText.isEmpty() || !fShaper) { return; }
+        SkFont font;
+    #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+        SkShaper::SetWordCacheEnabled(fWordCache);
+    #endif
+        while (loops-- > 0) {
+            SkTextBlobBuilderRunHandler rh(fText.c_str(), {0, 0});
+            fShaper->shape(fText.c_str(), fText.size(), font, true, 600, &rh);
+            (void)rh.makeBlob();
+        }
+    #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+        SkShaper::SetWordCacheEnabled(false);
+    #endif
+    }
+};
 }  // namespace
 
+DEF_BENCH(return new ShaperRepeatBench("text/english.txt", "shaper_repeat_english", 32);)
+DEF_BENCH(return new ShaperRepeatBench("text/arabic.txt", "shaper_repeat_arabic", 32);)
+DEF_BENCH(return new ShaperRepeatBench("text/english.txt", "shaper_repeat_english_wordcache", 32, true);)
+DEF_BENCH(return new ShaperRepeatBench("text/arabic.txt", "shaper_repeat_arabic_wordcache", 32, true);)
+
 #define SHAPER_BENCH(X) DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X);)
 SHAPER_BENCH(arabic)
 SHAPER_BENCH(armenian)
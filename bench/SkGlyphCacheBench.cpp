@@ -11,6 +11,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
+#include "src/core/SkGlyphBuffer.h"
 #include "src/core/SkRemoteGlyphCache.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
@@ -112,10 +113,192 @@ private:
     SkString fName;
 };
 
+// Generates glyphs for several distinct faces, purging the cache each time so every lookup
+// reaches the font host. Compare the serial and parallel variants to see how glyph generation
+// scales across faces.
+class SkGlyphCacheMultiFace : public Benchmark {
+public:
+    explicit SkGlyphCacheMultiFace(bool parallel) : fParallel(parallel) { }
+
+protected:
+    const char* onGetName() override {
+        return fParallel ? "SkGlyphCacheMultiFace_parallel" : "SkGlyphCacheMultiFace_serial";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        for (const char* resource : {"fonts/Roboto-Regular.ttf",
+                                     "fonts/Funkster.ttf",
+                                     "fonts/Distortable.ttf",
+                                     "fonts/Roboto2-Regular_NoEmbed.ttf"}) {
+            if (sk_sp<SkTypeface> typeface = MakeResourceAsTypeface(resource)) {
+                fTypefaces.push_back(std::move(typeface));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fTypefaces.empty()) {
+            return;
+        }
+        auto generate = [&](int index) {
+            SkFont font;
+            font.setEdging(SkFont::Edging::kAntiAlias);
+            font.setSubpixel(true);
+            font.setTypeface(fTypefaces[index]);
+            do_font_stuff(&font);
+        };
+        int count = SkToInt(fTypefaces.size());
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            if (fParallel) {
+                SkTaskGroup().batch(count, generate);
+            } else {
+                for (int i = 0; i < count; i++) {
+                    generate(i);
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const bool fParallel;
+    std::vector<sk_sp<SkTypeface>> fTypefaces;
+};
+
+// Many threads looking up the same already cached glyphs in one strike. This measures contention
+// on the strike cache and the strike itself rather than glyph generation.
+class SkGlyphCacheContended : public Benchmark {
+public:
+    explicit SkGlyphCacheContended(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheContended_%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setSubpixel(true);
+        fFont.setSize(16);
+        fFont.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle()));
+        for (int c = ' '; c < 'z'; c++) {
+            fGlyphs.push_back(SkPackedGlyphID{fFont.unicharToGlyph(c)});
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPaint defaultPaint;
+        auto strikeSpec = SkStrikeSpec::MakeMask(
+                fFont, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        SkSpan<const SkPackedGlyphID> glyphIDs{fGlyphs.data(), fGlyphs.size()};
+
+        // Populate the strike so the timed loop only finds glyphs.
+        (void)SkBulkGlyphMetricsAndImages{strikeSpec}.glyphs(glyphIDs);
+
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup().batch(fThreads, [&](int) {
+                for (int lookups = 0; lookups < 100; lookups++) {
+                    SkBulkGlyphMetricsAndImages images{strikeSpec};
+                    (void)images.glyphs(glyphIDs);
+                }
+            });
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    SkString fName;
+    SkFont fFont;
+    std::vector<SkPackedGlyphID> fGlyphs;
+};
+
+// Many threads preparing the same already cached text for drawing on the raster backend, as
+// SkGlyphRunListPainter does. The text has spaces, which have no image.
+class SkGlyphCacheContendedDraw : public Benchmark {
+public:
+    explicit SkGlyphCacheContendedDraw(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheContendedDraw_%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setSubpixel(true);
+        fFont.setSize(16);
+        fFont.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle()));
+        const char text[] = "The quick brown fox jumps over the lazy dog";
+        fGlyphs.resize(fFont.countText(text, strlen(text), SkTextEncoding::kUTF8));
+        fFont.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8,
+                           fGlyphs.data(), fGlyphs.size());
+        fPositions.resize(fGlyphs.size());
+        fFont.getPos(fGlyphs.data(), fGlyphs.size(), fPositions.data(), {10, 20});
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPaint defaultPaint;
+        auto strikeSpec = SkStrikeSpec::MakeMask(
+                fFont, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+
+        auto prepare = [&] {
+            auto strike = strikeSpec.findOrCreateExclusiveStrike();
+            SkDrawableGlyphBuffer drawables;
+            drawables.ensureSize(fGlyphs.size());
+            drawables.startDevice(SkMakeZip(fGlyphs, fPositions), {0, 0}, SkMatrix::I(),
+                                  strike->roundingSpec());
+            strike->prepareForDrawingMasksCPU(&drawables);
+        };
+
+        // Populate the strike so the timed loop only finds glyphs.
+        prepare();
+
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup().batch(fThreads, [&](int) {
+                for (int draws = 0; draws < 100; draws++) {
+                    prepare();
+                }
+            });
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    SkString fName;
+    SkFont fFont;
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheMultiFace(false); )
+DEF_BENCH( return new SkGlyphCacheMultiFace(true); )
+DEF_BENCH( return new SkGlyphCacheContended(1); )
+DEF_BENCH( return new SkGlyphCacheContended(16); )
+DEF_BENCH( return new SkGlyphCacheContendedDraw(1); )
+DEF_BENCH( return new SkGlyphCacheContendedDraw(16); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
@@ -243,6 +426,57 @@ public:
     DiffCanvasBench(SkString n, std::function<std::unique_ptr<SkStreamAsset>()> f)
         : fBenchName(std::move(n)), fDataProvider(std::move(f)) {}
 };
+
+// Measures sending the glyphs for one frame of a text blob trace from a fresh SkStrikeServer to a
+// fresh SkStrikeClient.
+class StrikeTransferBench : public Benchmark {
+    SkString fBenchName;
+    std::function<std::unique_ptr<SkStreamAsset>()> fDataProvider;
+    const bool fCompact;
+    std::vector<SkTextBlobTrace::Record> fTrace;
+
+    const char* onGetName() override { return fBenchName.c_str(); }
+
+    bool isSuitableFor(Backend b) override { return b == kNonRendering_Backend; }
+
+    void transferFrame() {
+        auto discardableManager = sk_make_sp<DiscardableManager>();
+        SkStrikeServer server{discardableManager.get()};
+        server.setCompactWireFormat(fCompact);
+        const SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
+        SkTextBlobCacheDiffCanvas canvas{1024, 1024, props, &server};
+        for (const auto& record : fTrace) {
+            canvas.drawTextBlob(
+                    record.blob.get(), record.offset.x(), record.offset.y(), record.paint);
+        }
+
+        std::vector<uint8_t> strikeData;
+        server.writeStrikeData(&strikeData);
+
+        SkStrikeCache strikeCache;
+        SkStrikeClient client{discardableManager, false, &strikeCache};
+        if (!strikeData.empty()) {
+            client.readStrikeData(strikeData.data(), strikeData.size());
+        }
+        discardableManager->unlockAndDeleteAll();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            this->transferFrame();
+        }
+    }
+
+    void onDelayedSetup() override {
+        auto stream = fDataProvider();
+        fTrace = SkTextBlobTrace::CreateBlobTrace(stream.get());
+    }
+
+public:
+    StrikeTransferBench(SkString n, std::function<std::unique_ptr<SkStreamAsset>()> f,
+                        bool compact)
+        : fBenchName(std::move(n)), fDataProvider(std::move(f)), fCompact(compact) {}
+};
 }  // namespace
 
 Benchmark* CreateDiffCanvasBench(
@@ -253,3 +487,13 @@ Benchmark* CreateDiffCanvasBench(
 DEF_BENCH( return CreateDiffCanvasBench(
         SkString("SkDiffBench-lorem_ipsum"),
         [](){ return GetResourceAsStream("diff_canvas_traces/lorem_ipsum.trace"); }));
+
+DEF_BENCH( return new StrikeTransferBench(
+        SkString("SkStrikeTransfer-lorem_ipsum"),
+        [](){ return GetResourceAsStream("diff_canvas_traces/lorem_ipsum.trace"); },
+        false));
+
+DEF_BENCH( return new StrikeTransferBench(
+        SkString("SkStrikeTransfer-lorem_ipsum_compact"),
+        [](){ return GetResourceAsStream("diff_canvas_traces/lorem_ipsum.trace"); },
+        true));
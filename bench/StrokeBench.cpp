@@ -66,6 +66,22 @@ static SkPath line_path_maker() {
     }
     return path;
 }
+// A long, mostly smooth track, like a GPS trace or a dense chart series.
+static SkPath polyline_path_maker(int count) {
+    SkPath path;
+    SkRandom rand;
+    SkPoint pt = {0, 0};
+    SkScalar heading = 0;
+    path.incReserve(count + 1);
+    path.moveTo(pt);
+    for (int i = 0; i < count; ++i) {
+        heading += rand.nextSScalar1() * 0.5f;
+        pt += SkVector::Make(SkScalarCos(heading), SkScalarSin(heading));
+        path.lineTo(pt);
+    }
+    return path;
+}
+
 static SkPath quad_path_maker() {
     SkPath path;
     SkRandom rand;
@@ -117,3 +133,21 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+static SkPaint polyline_paint_maker(SkPaint::Join join) {
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(2);
+    paint.setStrokeJoin(join);
+    paint.setStrokeCap(SkPaint::kButt_Cap);
+    return paint;
+}
+
+DEF_BENCH(return new StrokeBench(polyline_path_maker(10000),
+                                 polyline_paint_maker(SkPaint::kMiter_Join), "polyline_10000", 1);)
+DEF_BENCH(return new StrokeBench(polyline_path_maker(10000),
+                                 polyline_paint_maker(SkPaint::kRound_Join), "polyline_10000", 1);)
+DEF_BENCH(return new StrokeBench(polyline_path_maker(10000),
+                                 polyline_paint_maker(SkPaint::kBevel_Join), "polyline_10000", 1);)
+DEF_BENCH(return new StrokeBench(polyline_path_maker(100000),
+                                 polyline_paint_maker(SkPaint::kMiter_Join), "polyline_100000", 1);)
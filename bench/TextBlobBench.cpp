@@ -11,6 +11,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTemplates.h"
@@ -109,3 +110,70 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+// Draws a few lines of text with A8 or LCD glyph masks into a raster surface, to measure how
+// fast the blitters put glyph masks on the screen. The glyphs are cached after the first draw.
+class TextBlobMaskBench : public Benchmark {
+public:
+    TextBlobMaskBench(SkFont::Edging edging, SkScalar textSize)
+            : fEdging{edging}, fTextSize{textSize} {
+        fName.printf("TextBlobMaskBench_%s_%g",
+                     edging == SkFont::Edging::kSubpixelAntiAlias ? "lcd" : "a8", textSize);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDelayedSetup() override {
+        // LCD masks are only used when the surface has a known pixel geometry.
+        SkSurfaceProps props{0, kRGB_H_SkPixelGeometry};
+        fSurface = SkSurface::MakeRasterN32Premul(kWidth, kHeight, &props);
+
+        SkFont font{ToolUtils::create_portable_typeface("serif", SkFontStyle()), fTextSize};
+        font.setEdging(fEdging);
+        font.setSubpixel(true);
+
+        const char* text = "The quick brown fox jumps over the lazy dog. 0123456789";
+        SkTextBlobBuilder builder;
+        SkScalar y = fTextSize;
+        for (int line = 0; line < 8 && y < kHeight; line++) {
+            int count = font.countText(text, strlen(text), SkTextEncoding::kUTF8);
+            const SkTextBlobBuilder::RunBuffer& run = builder.allocRunPosH(font, count, y);
+            font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, run.glyphs, count);
+            font.getXPos(run.glyphs, count, run.pos);
+            y += fTextSize * 1.25f;
+        }
+        fBlob = builder.make();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setColor(0xFF202020);
+        for (int i = 0; i < loops; i++) {
+            canvas->clear(SK_ColorWHITE);
+            canvas->drawTextBlob(fBlob, 4, 0, paint);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 1024;
+    static constexpr int kHeight = 512;
+
+    const SkFont::Edging fEdging;
+    const SkScalar fTextSize;
+    SkString fName;
+    sk_sp<SkSurface> fSurface;
+    sk_sp<SkTextBlob> fBlob;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kAntiAlias, 12); )
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kAntiAlias, 24); )
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kAntiAlias, 48); )
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kSubpixelAntiAlias, 12); )
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kSubpixelAntiAlias, 24); )
+DEF_BENCH( return new TextBlobMaskBench(SkFont::Edging::kSubpixelAntiAlias, 48); )
@@ -34,6 +34,7 @@
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkLeanWindows.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkPicturePriv.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSONWriter.h"
@@ -793,6 +794,39 @@ public:
             return new DeserializePictureBench(name.c_str(), std::move(data));
         }
 
+        // And again, written in the compact SkRecord format.
+        while (fCurrentRecordDeserialPicture < fSKPs.count()) {
+            const SkString& path = fSKPs[fCurrentRecordDeserialPicture++];
+            sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+            if (!pic) {
+                continue;
+            }
+            sk_sp<SkData> data = SkPicturePriv::SerializeRecord(pic.get());
+            SkString name = SkOSPath::Basename(path.c_str());
+            name.append("_record");
+            fSourceType = "skp";
+            fBenchType  = "deserial";
+            fSKPBytes = static_cast<double>(data->size());
+            fSKPOps   = 0;
+            return new DeserializePictureBench(name.c_str(), std::move(data));
+        }
+
+        // Add all .skps as FirstPixelPictureBenchs, loading them eagerly and then lazily.
+        while (fCurrentFirstPixelPicture < 2 * fSKPs.count()) {
+            const bool lazy = fCurrentFirstPixelPicture & 1;
+            const SkString& path = fSKPs[fCurrentFirstPixelPicture++ / 2];
+            sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+            if (!data) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            fSourceType = "skp";
+            fBenchType  = "first_pixel";
+            fSKPBytes = static_cast<double>(data->size());
+            fSKPOps   = 0;
+            return new FirstPixelPictureBench(name.c_str(), std::move(data), lazy);
+        }
+
         // Then once each for each scale as SKPBenches (playback).
         while (fCurrentScale < fScales.count()) {
             while (fCurrentSKP < fSKPs.count()) {
@@ -1109,6 +1143,8 @@ private:
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
     int fCurrentRecording = 0;
     int fCurrentDeserialPicture = 0;
+    int fCurrentRecordDeserialPicture = 0;
+    int fCurrentFirstPixelPicture = 0;
     int fCurrentScale = 0;
     int fCurrentSKP = 0;
     int fCurrentSVG = 0;
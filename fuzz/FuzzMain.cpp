@@ -53,6 +53,7 @@ static constexpr char g_type_message[] = "How to interpret --bytes, one of:\n"
                                          "image_scale\n"
                                          "json\n"
                                          "path_deserialize\n"
+                                         "record_deserialize\n"
                                          "region_deserialize\n"
                                          "region_set_path\n"
                                          "skdescriptor_deserialize\n"
@@ -82,6 +83,7 @@ static void fuzz_image_decode_incremental(sk_sp<SkData>);
 static void fuzz_img(sk_sp<SkData>, uint8_t, uint8_t);
 static void fuzz_json(sk_sp<SkData>);
 static void fuzz_path_deserialize(sk_sp<SkData>);
+static void fuzz_record_deserialize(sk_sp<SkData>);
 static void fuzz_region_deserialize(sk_sp<SkData>);
 static void fuzz_region_set_path(sk_sp<SkData>);
 static void fuzz_skdescriptor_deserialize(sk_sp<SkData>);
@@ -189,6 +191,10 @@ static int fuzz_file(SkString path, SkString type) {
         fuzz_path_deserialize(bytes);
         return 0;
     }
+    if (type.equals("record_deserialize")) {
+        fuzz_record_deserialize(bytes);
+        return 0;
+    }
     if (type.equals("region_deserialize")) {
         fuzz_region_deserialize(bytes);
         return 0;
@@ -266,6 +272,7 @@ static std::map<std::string, std::string> cf_map = {
     {"image_filter_deserialize", "filter_fuzz"},
     {"image_filter_deserialize_width", "filter_fuzz"},
     {"path_deserialize", "path_deserialize"},
+    {"record_deserialize", "record_deserialize"},
     {"region_deserialize", "region_deserialize"},
     {"region_set_path", "region_set_path"},
     {"skdescriptor_deserialize", "skdescriptor_deserialize"},
@@ -697,6 +704,16 @@ static void fuzz_path_deserialize(sk_sp<SkData> bytes) {
     SkDebugf("[terminated] path_deserialize didn't crash!\n");
 }
 
+bool FuzzRecordDeserialize(sk_sp<SkData> bytes);
+
+static void fuzz_record_deserialize(sk_sp<SkData> bytes) {
+    if (!FuzzRecordDeserialize(bytes)) {
+        SkDebugf("[terminated] Couldn't decode as a record picture.\n");
+        return;
+    }
+    SkDebugf("[terminated] Success! Decoded and rendered a record picture!\n");
+}
+
 bool FuzzRegionDeserialize(sk_sp<SkData> bytes);
 
 static void fuzz_region_deserialize(sk_sp<SkData> bytes) {
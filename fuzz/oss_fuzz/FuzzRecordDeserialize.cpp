@@ -0,0 +1,45 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecordSerialize.h"
+
+// The bytes are what follows the SkPictInfo of a picture whose trailing byte says it was written
+// by SkRecordSerialize(), as SkPicture::MakeFromData() and MakeFromStream() read it.
+bool FuzzRecordDeserialize(sk_sp<SkData> bytes) {
+    SkPictInfo info;
+    info.setVersion(SkPicturePriv::kCurrent_Version);
+    info.fCullRect = SkRect::MakeWH(128, 128);
+
+    SkMemoryStream stream(bytes);
+    sk_sp<SkPicture> pic = SkRecordDeserialize(&stream, info, SkDeserialProcs(), bytes.get());
+    if (!pic) {
+        return false;
+    }
+    auto s = SkSurface::MakeRasterN32Premul(128, 128);
+    if (!s) {
+        // May return nullptr in memory-constrained fuzzing environments
+        return false;
+    }
+    s->getCanvas()->drawPicture(pic);
+    return true;
+}
+
+#if defined(IS_FUZZING_WITH_LIBFUZZER)
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    auto bytes = SkData::MakeWithoutCopy(data, size);
+    FuzzRecordDeserialize(bytes);
+    return 0;
+}
+#endif
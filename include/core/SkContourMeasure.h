@@ -26,6 +26,15 @@ public:
     bool SK_WARN_UNUSED_RESULT getPosTan(SkScalar distance, SkPoint* position,
                                          SkVector* tangent) const;
 
+    /** Computes the position and tangent at each of count distances, as if by calling
+     *  getPosTan() for each one. positions or tangents may be null. Distances in increasing
+     *  order are found with one walk along the contour rather than a search each, and
+     *  distances on the same curve are evaluated together.
+     *  Returns false if any distance is NaN, leaving its position and tangent unchanged.
+     */
+    bool SK_WARN_UNUSED_RESULT getPosTans(const SkScalar distances[], int count,
+                                          SkPoint positions[], SkVector tangents[]) const;
+
     enum MatrixFlags {
         kGetPosition_MatrixFlag     = 0x01,
         kGetTangent_MatrixFlag      = 0x02,
@@ -84,6 +93,7 @@ private:
     ~SkContourMeasure() override {}
 
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
+    SkScalar distanceToT(int index, SkScalar distance) const;
 
     friend class SkContourMeasureIter;
 };
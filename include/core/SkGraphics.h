@@ -90,6 +90,20 @@ public:
      */
     static int SetFontCachePointSizeLimit(int maxPointSize);
 
+    /**
+     *  Keep the glyphs of the font cache in files in the given directory, so that later
+     *  processes can reuse them instead of generating them again. New cache entries are filled
+     *  from the directory, and WriteFontCacheToDirectory() saves the entries that have grown.
+     *  The directory must already exist. Pass nullptr to stop using a directory.
+     */
+    static void SetFontCacheDirectory(const char* directory);
+
+    /**
+     *  Save the font cache entries that have changed since they were read from, or last written
+     *  to, the directory given to SetFontCacheDirectory(). Does nothing if there is none.
+     */
+    static void WriteFontCacheToDirectory();
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
@@ -131,6 +145,18 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  The raster backend can keep the coverage masks of paths it draws in a cache of its own,
+     *  so that drawing the same non-volatile path again with the same matrix (up to its integer
+     *  translation) and stroke only blits the mask. Fractional translations are snapped to a
+     *  quarter of a pixel when the cache is used. These functions get/set the most memory the
+     *  cached masks may use; the least recently used masks are purged to stay within this.
+     *
+     *  Zero is the default value, meaning path masks are not cached.
+     */
+    static size_t GetPathMaskCacheByteLimit();
+    static size_t SetPathMaskCacheByteLimit(size_t newLimit);
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
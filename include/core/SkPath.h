@@ -1762,6 +1762,7 @@ private:
     friend class SkAutoDisableDirectionCheck;
     friend class SkPathEdgeIter;
     friend class SkPathWriter;
+    friend class SkPathBuilder;
     friend class SkOpBuilder;
     friend class SkBench_AddPathTest; // perf test reversePathTo
     friend class PathTest_Private; // unit test reversePathTo
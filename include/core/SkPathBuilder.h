@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathBuilder_DEFINED
+#define SkPathBuilder_DEFINED
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+
+class SkPathRef;
+
+/** \class SkPathBuilder
+    SkPathBuilder builds an SkPath one verb at a time, for callers that append to a path and
+    draw it as it grows, like a drawing tool adding the points of a stroke as they arrive.
+
+    Appending to an SkPath that is shared copies its points, and each SkPath computes its
+    bounds again after every edit. SkPathBuilder keeps its bounds up to date as verbs are
+    added, and snapshot() returns an SkPath that shares the builder's points. When that SkPath
+    has been destroyed by the next append, the builder appends in place, so building a path of
+    n verbs and taking a snapshot after each one costs O(n) in total. Keeping a snapshot alive
+    while appending copies the points once, as appending to a shared SkPath does.
+
+    Verbs are added with the same rules as SkPath: lineTo(), quadTo(), conicTo() and
+    cubicTo() start a contour with a move to the last contour's first point if needed.
+*/
+class SK_API SkPathBuilder {
+public:
+    SkPathBuilder();
+    explicit SkPathBuilder(SkPathFillType fillType);
+    ~SkPathBuilder();
+
+    SkPathBuilder(const SkPathBuilder&) = delete;
+    SkPathBuilder& operator=(const SkPathBuilder&) = delete;
+
+    SkPathFillType fillType() const { return fFillType; }
+    SkPathBuilder& setFillType(SkPathFillType fillType) {
+        fFillType = fillType;
+        return *this;
+    }
+
+    /** Sets whether the snapshots are volatile; see SkPath::setIsVolatile(). */
+    SkPathBuilder& setIsVolatile(bool isVolatile) {
+        fIsVolatile = isVolatile;
+        return *this;
+    }
+
+    int countPoints() const;
+    int countVerbs() const;
+
+    /** Returns the bounds of the points added so far, without looking at them again. If any
+        point is not finite, returns an empty rectangle, like SkPath::getBounds().
+    */
+    const SkRect& getBounds() const { return fBounds; }
+
+    /** Returns false if any point added so far is infinite or NaN. */
+    bool isFinite() const { return fIsFinite; }
+
+    /** Sets lastPt to the last point added and returns true, or returns false if there are no
+        points.
+    */
+    bool getLastPt(SkPoint* lastPt) const;
+
+    SkPathBuilder& moveTo(SkPoint pt);
+    SkPathBuilder& moveTo(SkScalar x, SkScalar y) { return this->moveTo({x, y}); }
+
+    SkPathBuilder& lineTo(SkPoint pt);
+    SkPathBuilder& lineTo(SkScalar x, SkScalar y) { return this->lineTo({x, y}); }
+
+    SkPathBuilder& quadTo(SkPoint pt1, SkPoint pt2);
+    SkPathBuilder& quadTo(SkScalar x1, SkScalar y1, SkScalar x2, SkScalar y2) {
+        return this->quadTo({x1, y1}, {x2, y2});
+    }
+
+    SkPathBuilder& conicTo(SkPoint pt1, SkPoint pt2, SkScalar w);
+    SkPathBuilder& conicTo(SkScalar x1, SkScalar y1, SkScalar x2, SkScalar y2, SkScalar w) {
+        return this->conicTo({x1, y1}, {x2, y2}, w);
+    }
+
+    SkPathBuilder& cubicTo(SkPoint pt1, SkPoint pt2, SkPoint pt3);
+    SkPathBuilder& cubicTo(SkScalar x1, SkScalar y1, SkScalar x2, SkScalar y2,
+                           SkScalar x3, SkScalar y3) {
+        return this->cubicTo({x1, y1}, {x2, y2}, {x3, y3});
+    }
+
+    SkPathBuilder& close();
+
+    /** Makes room for extraPtCount more points, and as many verbs. */
+    SkPathBuilder& incReserve(int extraPtCount);
+
+    /** Removes all verbs and points, keeping the storage if no snapshot still uses it. The
+        fill type and volatility are not changed.
+    */
+    SkPathBuilder& reset();
+
+    /** Returns an SkPath with the verbs and points added so far. The SkPath shares the
+        builder's storage, has its bounds already computed, and knows it is concave when that
+        has been seen while building. Calling snapshot() again without adding verbs returns a
+        path with the same generation ID.
+    */
+    SkPath snapshot();
+
+private:
+    // Make fPathRef ready to have verbCount verbs and pointCount points appended.
+    void prepareForAppend(int verbCount, int pointCount);
+    void injectMoveToIfNeeded();
+    SkPoint* growForVerb(SkPath::Verb verb, int pointCount, SkScalar weight = 0);
+    void addPoints(const SkPoint pts[], int count);
+    bool isKnownConcave() const;
+
+    sk_sp<SkPathRef> fPathRef;
+    SkRect           fBounds;
+    int              fLastMoveToIndex;
+    SkPathFillType   fFillType;
+    bool             fIsVolatile = false;
+    bool             fIsFinite;
+    bool             fShared;         // fPathRef may be held by a snapshot
+
+    // Tracks the same sign changes as the quick concavity check in SkPath's convexity test.
+    int              fMoveCount;
+    bool             fLastVerbIsMove;
+    SkPoint          fFirstPt, fSignPt;
+    int              fLastSx, fLastSy;
+    int              fDxes, fDyes;
+};
+
+#endif
@@ -80,6 +80,25 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, like MakeFromData(), but keeps data
+        and draws from it directly. Paths and images are only checked to be the right size when
+        loading, and are decoded the first time they are drawn. Loading takes less time and
+        memory, which helps most when data is mapped from a file with
+        SkData::MakeFromFileName() and only drawn a few times; each playback reads the
+        serialized commands again, so it is slower than playing back a picture from
+        MakeFromData().
+
+        The contents of data must not change while the SkPicture exists. procs is used as in
+        MakeFromData(), but its images may be decoded during playback, so procs->fImageCtx
+        must also live as long as the SkPicture.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture drawing from data
+    */
+    static sk_sp<SkPicture> MakeLazyFromData(sk_sp<SkData> data,
+                                             const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -234,13 +253,16 @@ private:
     SkPicture();
     friend class SkBigPicture;
     friend class SkEmptyPicture;
+    friend class SkLazyPicture;
     friend class SkPicturePriv;
     template <typename> friend class SkMiniPicture;
 
     void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces,
         bool textBlobsOnly=false) const;
+    // If lazySource is not null, stream reads from it, and the picture draws from it directly.
     static sk_sp<SkPicture> MakeFromStream(SkStream*, const SkDeserialProcs*,
-                                           class SkTypefacePlayback*);
+                                           class SkTypefacePlayback*,
+                                           SkData* lazySource = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
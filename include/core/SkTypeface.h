@@ -24,6 +24,7 @@ class SkFontDescriptor;
 class SkScalerContext;
 class SkStream;
 class SkStreamAsset;
+class SkTypefaceCmapCache;
 class SkWStream;
 struct SkAdvancedTypefaceMetrics;
 struct SkScalerContextEffects;
@@ -435,12 +436,18 @@ private:
     friend class SkFontPriv;       // GetDefaultTypeface
     friend class SkPaintPriv;      // GetDefaultTypeface
     friend class SkFont;           // getGlyphToUnicodeMap
+    friend class SkTypefaceCmapCache; // onCharsToGlyphs
+
+    // The cache for unicharsToGlyphs, created on first use.
+    SkTypefaceCmapCache* cmapCache() const;
 
 private:
     SkFontID            fUniqueID;
     SkFontStyle         fStyle;
     mutable SkRect      fBounds;
     mutable SkOnce      fBoundsOnce;
+    mutable std::unique_ptr<SkTypefaceCmapCache> fCmapCache;
+    mutable SkOnce      fCmapCacheOnce;
     bool                fIsFixedPitch;
 
     typedef SkWeakRefCnt INHERITED;
@@ -185,6 +185,40 @@ struct Metadata {
     */
     int fEncodingQuality = 101;
 
+    /** If true, a JPEG image that is drawn at less than half of its native
+        resolution (measured at fRasterDPI) is reduced by 1/2, 1/4 or 1/8
+        using the JPEG decoder's DCT scaling and re-encoded at that size,
+        instead of being embedded at full size.  The re-encoding uses
+        fEncodingQuality, or a default quality if that is lossless.
+
+        Experimental.
+    */
+    bool fDownsampleJpegs = false;
+
+    /** PDF streams are compressed with deflate to save space.  Use this to
+        choose the trade-off between compression time and document size.
+        kLowButFast is a good choice when generating many documents and the
+        output is CPU-bound; kNone stores streams uncompressed.
+    */
+    enum class CompressionLevel : int {
+        kDefault = -1,
+        kNone = 0,
+        kLowButFast = 1,
+        kAverage = 6,
+        kHighButSlow = 9,
+    } fCompressionLevel = CompressionLevel::kDefault;
+
+    /** The deflate strategy used for compressed streams.  kRLE is much
+        faster than kDefault and does well on image data, at the cost of
+        larger content streams.
+    */
+    enum class CompressionStrategy {
+        kDefault,
+        kFiltered,
+        kHuffmanOnly,
+        kRLE,
+    } fCompressionStrategy = CompressionStrategy::kDefault;
+
     /** An optional tree of structured document tags that provide
         a semantic representation of the content. The caller
         should retain ownership.
@@ -11,6 +11,7 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 
+class SkExecutor;
 class SkPath;
 struct SkRect;
 
@@ -101,6 +102,18 @@ public:
       */
     bool resolve(SkPath* result);
 
+    /** Like resolve(), but if every operand is a union, operands are grouped by overlapping
+        bounds, and each group is unioned pairwise in a balanced tree instead of one path at a
+        time. Groups, and pairs within a level of the tree, are resolved in parallel on executor
+        if it is not nullptr. The result covers the same area as resolve(), though its contours
+        may be split or ordered differently. Falls back to resolve() for other operators.
+
+        @param result The product of the operands.
+        @param executor Runs the unions in parallel if not nullptr.
+        @return True if the operation succeeded.
+      */
+    bool resolveBalanced(SkPath* result, SkExecutor* executor = nullptr);
+
 private:
     SkTArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
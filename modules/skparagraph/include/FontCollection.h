@@ -6,6 +6,7 @@
 #include <set>
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTHash.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/include/TextStyle.h"
@@ -63,8 +64,16 @@ private:
         };
     };
 
+    // The typeface lookups are split between shards by family key hash, each with its own lock,
+    // so that paragraphs can be laid out on many threads with one FontCollection.
+    static constexpr int kTypefaceShardCount = 8;
+    struct TypefaceShard {
+        SkMutex fMutex;
+        SkTHashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+    };
+
     bool fEnableFontFallback;
-    SkTHashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+    TypefaceShard fTypefaceShards[kTypefaceShardCount];
     sk_sp<SkFontMgr> fDefaultFontManager;
     sk_sp<SkFontMgr> fAssetFontManager;
     sk_sp<SkFontMgr> fDynamicFontManager;
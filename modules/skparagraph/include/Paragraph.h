@@ -6,8 +6,10 @@
 #include "modules/skparagraph/include/Metrics.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
 #include "modules/skparagraph/include/TextStyle.h"
+#include "src/core/SkSpan.h"
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -88,6 +90,12 @@ protected:
     SkScalar fLongestLine;
     bool fExceededMaxLines;
 };
+
+// Lays out all the paragraphs at the given width, shaping and breaking them into lines
+// concurrently on the executor, and returns once all of them are done.
+// The paragraphs may share a FontCollection, but each paragraph must appear only once.
+void layoutAll(SkSpan<Paragraph*> paragraphs, SkScalar width, SkExecutor& executor);
+
 }  // namespace textlayout
 }  // namespace skia
 
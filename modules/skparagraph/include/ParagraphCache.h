@@ -4,6 +4,7 @@
 
 #include "include/private/SkMutex.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
 #include <functional>  // std::function
 
 #define PARAGRAPH_CACHE_STATS
@@ -27,6 +28,8 @@ class ParagraphCacheValue;
 
 bool operator==(const ParagraphCacheKey& a, const ParagraphCacheKey& b);
 
+// Safe to use from many threads at once: the entries are split between shards by key hash,
+// each shard with its own lock, so paragraphs laid out in parallel rarely wait on each other.
 class ParagraphCache {
 public:
     ParagraphCache();
@@ -43,7 +46,7 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
 
  private:
 
@@ -51,23 +54,31 @@ public:
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
 
-     mutable SkMutex fParagraphMutex;
      std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
     static const int kMaxEntries = 128;
+    static const int kShardCount = 8;
 
     struct KeyHash {
         uint32_t mix(uint32_t hash, uint32_t data) const;
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
+    struct Shard {
+        Shard();
+        ~Shard();
+        SkMutex fParagraphMutex;
+        SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+    };
+    Shard& shardFor(const ParagraphCacheKey& key);
+
+    Shard fShards[kShardCount];
+    std::atomic<bool> fCacheIsOn;
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
+    std::atomic<int> fHashMisses; // cache hit but hash table missed
 #endif
 };
 
@@ -70,11 +70,18 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::getFontManagerOrder() const {
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    TypefaceShard& shard =
+            fTypefaceShards[FamilyKey::Hasher()(familyKey) % kTypefaceShardCount];
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        auto found = shard.fTypefaces.find(familyKey);
+        if (found) {
+            return *found;
+        }
     }
 
+    // Match without holding the lock; if another thread got here first the results are the same.
+
     std::vector<sk_sp<SkTypeface>> typefaces;
     for (const SkString& familyName : familyNames) {
         sk_sp<SkTypeface> match = matchTypeface(familyName, fontStyle);
@@ -90,7 +97,8 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
-    fTypefaces.set(familyKey, typefaces);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    shard.fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
 
@@ -1,6 +1,7 @@
 // Copyright 2019 Google LLC.
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
+#include "modules/skshaper/include/SkShaper.h"
 
 namespace skia {
 namespace textlayout {
@@ -178,7 +179,6 @@ struct ParagraphCache::Entry {
 
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
     , fCacheIsOn(true)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
@@ -189,6 +189,23 @@ ParagraphCache::ParagraphCache()
 
 ParagraphCache::~ParagraphCache() { }
 
+ParagraphCache::Shard::Shard() : fLRUCacheMap(kMaxEntries / kShardCount) { }
+
+ParagraphCache::Shard::~Shard() { }
+
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    return fShards[SkChecksum::CheapMix(KeyHash()(key)) % kShardCount];
+}
+
+int ParagraphCache::count() {
+    int count = 0;
+    for (auto& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fParagraphMutex);
+        count += shard.fLRUCacheMap.count();
+    }
+    return count;
+}
+
 void ParagraphCache::updateFrom(const ParagraphImpl* paragraph, Entry* entry) {
 
     for (size_t i = 0; i < paragraph->fRuns.size(); ++i) {
@@ -210,30 +227,41 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
 void ParagraphCache::printStatistics() {
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
+    int totalRequests = fTotalRequests;
+    int cacheMisses = fCacheMisses;
+    SkDebugf("Total requests: %d\n", totalRequests);
+    SkDebugf("Cache misses: %d\n", cacheMisses);
+    SkDebugf("Cache miss %%: %f\n", (totalRequests > 0) ? 100.f * cacheMisses / totalRequests : 0.f);
+    int cacheHits = totalRequests - cacheMisses;
     SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    auto words = SkShaper::GetWordCacheStats();
+    int wordRequests = words.fHits + words.fMisses;
+    SkDebugf("Shaped words: %d\n", words.fCount);
+    SkDebugf("Word cache miss %%: %f\n",
+             (wordRequests > 0) ? 100.f * words.fMisses / wordRequests : 0.f);
     SkDebugf("---------------------\n");
 }
 
 void ParagraphCache::abandon() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
-    fLRUCacheMap.foreach([](ParagraphCacheKey*, std::unique_ptr<Entry>* e) {
-    });
+    for (auto& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fParagraphMutex);
+        shard.fLRUCacheMap.foreach([](ParagraphCacheKey*, std::unique_ptr<Entry>* e) {
+        });
+    }
 
     this->reset();
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
 #endif
-    fLRUCacheMap.reset();
+    for (auto& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fParagraphMutex);
+        shard.fLRUCacheMap.reset();
+    }
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -243,9 +271,10 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fParagraphMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
@@ -267,12 +296,13 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fParagraphMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
         ParagraphCacheValue* value = new ParagraphCacheValue(paragraph);
-        fLRUCacheMap.insert(key, std::unique_ptr<Entry>(new Entry(value)));
+        shard.fLRUCacheMap.insert(key, std::unique_ptr<Entry>(new Entry(value)));
         fChecker(paragraph, "addedParagraph", true);
         return true;
     } else {
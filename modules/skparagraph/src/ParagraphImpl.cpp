@@ -8,6 +8,7 @@
 #include "modules/skparagraph/src/Run.h"
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "src/core/SkSpan.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkUTF.h"
 #include <algorithm>
 #include <unicode/ustring.h>
@@ -217,6 +218,14 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
     }
 }
 
+void layoutAll(SkSpan<Paragraph*> paragraphs, SkScalar width, SkExecutor& executor) {
+    SkTaskGroup taskGroup(executor);
+    taskGroup.batch(SkToInt(paragraphs.size()), [paragraphs, width](int i) {
+        paragraphs[i]->layout(width);
+    });
+    taskGroup.wait();
+}
+
 void ParagraphImpl::paint(SkCanvas* canvas, SkScalar x, SkScalar y) {
 
     if (fState < kDrawn) {
@@ -1150,6 +1159,7 @@ void ParagraphImpl::computeEmptyMetrics() {
 void ParagraphImpl::updateText(size_t from, SkString text) {
   fText.remove(from, from + text.size());
   fText.insert(from, text);
+  // The whole paragraph is shaped again on the next layout
   fState = kUnknown;
   fOldWidth = 0;
   fOldHeight = 0;
@@ -59,6 +59,22 @@ public:
 
     static std::unique_ptr<SkShaper> Make(sk_sp<SkFontMgr> = nullptr);
 
+    #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+    /** The HarfBuzz shapers can share a process wide cache of shaped words (some text and the
+     *  spaces after it), keyed by the font, whole-run features, script, direction and language.
+     *  It is off by default, since cached words do not see kerning or contextual substitutions
+     *  across the spaces around them.
+     */
+    static void SetWordCacheEnabled(bool);
+    struct WordCacheStats {
+        int fHits;
+        int fMisses;
+        int fCount;
+    };
+    static WordCacheStats GetWordCacheStats();
+    static void PurgeWordCache();
+    #endif
+
     SkShaper();
     virtual ~SkShaper();
 
@@ -16,15 +16,19 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkBitmaskEnum.h"
+#include "include/private/SkChecksum.h"
 #include "include/private/SkMalloc.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTFitsIn.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkSpan.h"
 #include "src/core/SkTDPQueue.h"
 #include "src/utils/SkUTF.h"
@@ -41,10 +45,12 @@
 #include <unicode/utext.h>
 #include <unicode/utypes.h>
 
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #if defined(SK_USING_THIRD_PARTY_ICU)
 #include "SkLoadICU.h"
@@ -271,15 +277,14 @@ hb_blob_t* skhb_get_table(hb_face_t* face, hb_tag_t tag, void* user_data) {
                           });
 }
 
-HBFont create_hb_font(const SkFont& font) {
-    SkASSERT(font.getTypeface());
+HBFace create_hb_face(SkTypeface& typeface) {
     int index;
-    std::unique_ptr<SkStreamAsset> typefaceAsset = font.getTypeface()->openStream(&index);
+    std::unique_ptr<SkStreamAsset> typefaceAsset = typeface.openStream(&index);
     HBFace face;
     if (!typefaceAsset) {
         face.reset(hb_face_create_for_tables(
             skhb_get_table,
-            reinterpret_cast<void *>(font.refTypeface().release()),
+            reinterpret_cast<void *>(SkRef(&typeface)),
             [](void* user_data){ SkSafeUnref(reinterpret_cast<SkTypeface*>(user_data)); }));
     } else {
         HBBlob blob(stream_to_blob(std::move(typefaceAsset)));
@@ -290,9 +295,15 @@ HBFont create_hb_font(const SkFont& font) {
         return nullptr;
     }
     hb_face_set_index(face.get(), (unsigned)index);
-    hb_face_set_upem(face.get(), font.getTypeface()->getUnitsPerEm());
+    hb_face_set_upem(face.get(), typeface.getUnitsPerEm());
+    // Shaping plans are cached on the face, so keep it immutable once shared between threads.
+    hb_face_make_immutable(face.get());
+    return face;
+}
 
-    HBFont otFont(hb_font_create(face.get()));
+HBFont create_hb_font(const SkFont& font, hb_face_t* face) {
+    SkASSERT(font.getTypeface());
+    HBFont otFont(hb_font_create(face));
     SkASSERT(otFont);
     if (!otFont) {
         return nullptr;
@@ -316,10 +327,94 @@ HBFont create_hb_font(const SkFont& font) {
                       [](void* user_data){ delete reinterpret_cast<SkFont*>(user_data); });
     int scale = skhb_position(font.getSize());
     hb_font_set_scale(skFont.get(), scale, scale);
+    hb_font_make_immutable(skFont.get());
 
     return skFont;
 }
 
+/** Everything about an SkFont which can change the result of shaping with it.
+ *  Variation coordinates are part of the typeface, so they are covered by its unique id.
+ */
+struct HBFontKey {
+    explicit HBFontKey(const SkFont& font)
+        : fTypefaceID(font.getTypeface()->uniqueID())
+        , fSize(font.getSize())
+        , fScaleX(font.getScaleX())
+        , fSkewX(font.getSkewX())
+        , fBits((font.isForceAutoHinting() ? 1 << 0 : 0) |
+                (font.isEmbeddedBitmaps()  ? 1 << 1 : 0) |
+                (font.isSubpixel()         ? 1 << 2 : 0) |
+                (font.isLinearMetrics()    ? 1 << 3 : 0) |
+                (font.isEmbolden()         ? 1 << 4 : 0) |
+                (font.isBaselineSnap()     ? 1 << 5 : 0) |
+                ((uint32_t)font.getEdging()  <<  8) |
+                ((uint32_t)font.getHinting() << 16)) {}
+
+    bool operator==(const HBFontKey& that) const {
+        return fTypefaceID == that.fTypefaceID &&
+               fSize       == that.fSize       &&
+               fScaleX     == that.fScaleX     &&
+               fSkewX      == that.fSkewX      &&
+               fBits       == that.fBits;
+    }
+
+    SkFontID fTypefaceID;
+    SkScalar fSize;
+    SkScalar fScaleX;
+    SkScalar fSkewX;
+    uint32_t fBits;
+};
+static_assert(sizeof(HBFontKey) == 5 * sizeof(uint32_t), "HBFontKey must not have padding.");
+
+/** Process wide cache of hb_face_t (one per typeface) and hb_font_t (one per HBFontKey).
+ *  Keeping the hb_face_t alive lets HarfBuzz reuse its table blobs and cached shaping plans.
+ *  The cached objects are immutable; callers get their own reference so eviction is safe.
+ */
+class HBFontCache {
+public:
+    static HBFontCache& Get() {
+        static HBFontCache* gCache = new HBFontCache;
+        return *gCache;
+    }
+
+    HBFont find(const SkFont& font) {
+        SkASSERT(font.getTypeface());
+        HBFontKey key(font);
+
+        SkAutoMutexExclusive lock(fMutex);
+        if (HBFont* cached = fFonts.find(key)) {
+            return HBFont(hb_font_reference(cached->get()));
+        }
+
+        SkFontID typefaceID = font.getTypeface()->uniqueID();
+        HBFace* face = fFaces.find(typefaceID);
+        if (!face) {
+            HBFace newFace(create_hb_face(*font.getTypeface()));
+            if (!newFace) {
+                return nullptr;
+            }
+            face = fFaces.insert(typefaceID, std::move(newFace));
+        }
+
+        HBFont hbFont(create_hb_font(font, face->get()));
+        if (!hbFont) {
+            return nullptr;
+        }
+        HBFont* cached = fFonts.insert(key, std::move(hbFont));
+        return HBFont(hb_font_reference(cached->get()));
+    }
+
+private:
+    static constexpr int kMaxFaces = 64;
+    static constexpr int kMaxFonts = 128;
+
+    HBFontCache() : fFaces(kMaxFaces), fFonts(kMaxFonts) {}
+
+    SkMutex fMutex;
+    SkLRUCache<SkFontID, HBFace> fFaces;
+    SkLRUCache<HBFontKey, HBFont> fFonts;
+};
+
 /** Replaces invalid utf-8 sequences with REPLACEMENT CHARACTER U+FFFD. */
 static inline SkUnichar utf8_next(const char** ptr, const char* end) {
     SkUnichar val = SkUTF::NextUTF8(ptr, end);
@@ -633,6 +728,113 @@ struct ShapedRunGlyphIterator {
     size_t fGlyphIndex;
 };
 
+/** Key for a shaped word: its utf8 text plus everything else given to HarfBuzz when shaping it.
+ *  Only whole-run features are allowed, so they are recorded as (tag, value) pairs.
+ */
+struct ShapedWordKey {
+    ShapedWordKey(const SkFont& font, hb_script_t script, hb_language_t language, bool rtl)
+        : fFont(font), fScript(script), fLanguage(language), fRTL(rtl) {}
+
+    bool operator==(const ShapedWordKey& that) const {
+        return fFont     == that.fFont     &&
+               fScript   == that.fScript   &&
+               fLanguage == that.fLanguage &&
+               fRTL      == that.fRTL      &&
+               fFeatures == that.fFeatures &&
+               fText     == that.fText;
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapedWordKey& key) const {
+            uint32_t hash = SkOpts::hash_fn(key.fText.c_str(), key.fText.size(), 0);
+            hash = SkOpts::hash_fn(&key.fFont, sizeof(key.fFont), hash);
+            hash = SkOpts::hash_fn(key.fFeatures.data(),
+                                   key.fFeatures.size() * sizeof(uint32_t), hash);
+            return SkChecksum::Mix(hash ^ key.fScript ^ (key.fRTL ? 0x80000000 : 0)) ^
+                   SkChecksum::Mix(SkToU32(reinterpret_cast<uintptr_t>(key.fLanguage)));
+        }
+    };
+
+    HBFontKey fFont;
+    hb_script_t fScript;
+    hb_language_t fLanguage;
+    bool fRTL;
+    std::vector<uint32_t> fFeatures;
+    SkString fText;
+};
+
+/** Process wide cache of shaped words, consulted by every HarfBuzz shaper when enabled.
+ *  Clusters are stored relative to the start of the word.
+ */
+class ShapedWordCache {
+public:
+    static ShapedWordCache& Get() {
+        static ShapedWordCache* gCache = new ShapedWordCache;
+        return *gCache;
+    }
+
+    bool enabled() const { return fEnabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) { fEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /** If the word is cached append its glyphs, with clusters starting at 'cluster'. */
+    bool find(const ShapedWordKey& key, uint32_t cluster, SkTArray<ShapedGlyph, true>* glyphs) {
+        SkAutoMutexExclusive lock(fMutex);
+        const Word* word = fWords.find(key);
+        if (!word) {
+            ++fMisses;
+            return false;
+        }
+        ++fHits;
+        ShapedGlyph* dst = glyphs->push_back_n(SkToInt(word->fNumGlyphs), word->fGlyphs.get());
+        for (size_t i = 0; i < word->fNumGlyphs; ++i) {
+            dst[i].fCluster += cluster;
+        }
+        return true;
+    }
+
+    void insert(const ShapedWordKey& key, uint32_t cluster,
+                const ShapedGlyph* glyphs, size_t numGlyphs) {
+        Word word{std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[numGlyphs]), numGlyphs};
+        for (size_t i = 0; i < numGlyphs; ++i) {
+            word.fGlyphs[i] = glyphs[i];
+            word.fGlyphs[i].fCluster -= cluster;
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        if (!fWords.find(key)) {
+            fWords.insert(key, std::move(word));
+        }
+    }
+
+    SkShaper::WordCacheStats stats() {
+        SkAutoMutexExclusive lock(fMutex);
+        return { fHits, fMisses, fWords.count() };
+    }
+
+    void purge() {
+        SkAutoMutexExclusive lock(fMutex);
+        fWords.reset();
+        fHits = 0;
+        fMisses = 0;
+    }
+
+private:
+    static constexpr int kMaxWords = 4096;
+
+    ShapedWordCache() : fWords(kMaxWords) {}
+
+    struct Word {
+        std::unique_ptr<ShapedGlyph[]> fGlyphs;
+        size_t fNumGlyphs;
+    };
+
+    std::atomic<bool> fEnabled{false};
+    SkMutex fMutex;
+    SkLRUCache<ShapedWordKey, Word, ShapedWordKey::Hash> fWords;
+    int fHits = 0;
+    int fMisses = 0;
+};
+
 class ShaperHarfBuzz : public SkShaper {
 public:
     ShaperHarfBuzz(HBBuffer, ICUBrk line, ICUBrk grapheme, sk_sp<SkFontMgr>);
@@ -650,6 +852,15 @@ protected:
                     const FontRunIterator&,
                     const Feature*, size_t featuresSize) const;
 private:
+    ShapedRun shapeUncached(const char* utf8, size_t utf8Bytes,
+                            const char* utf8Start,
+                            const char* utf8End,
+                            const BiDiRunIterator&,
+                            const LanguageRunIterator&,
+                            const ScriptRunIterator&,
+                            const FontRunIterator&,
+                            const Feature*, size_t featuresSize) const;
+
     const sk_sp<SkFontMgr> fFontMgr;
     HBBuffer               fBuffer;
 
@@ -1283,6 +1494,92 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   const ScriptRunIterator& script,
                                   const FontRunIterator& font,
                                   Feature const * const features, size_t const featuresSize) const
+{
+    ShapedWordCache& cache = ShapedWordCache::Get();
+    const SkFont& skFont = font.currentFont();
+    if (!cache.enabled() || !skFont.getTypeface()) {
+        return this->shapeUncached(utf8, utf8Bytes, utf8Start, utf8End,
+                                   bidi, language, script, font, features, featuresSize);
+    }
+
+    ShapedWordKey key(skFont,
+                      hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()),
+                      hb_language_from_string(language.currentLanguage(), -1),
+                      !is_LTR(bidi.currentLevel()));
+    for (const auto& feature : SkMakeSpan(features, featuresSize)) {
+        if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
+                          SkTo<size_t>(utf8End   - utf8)  <= feature.start)
+        {
+            continue;
+        }
+        if (SkTo<size_t>(utf8Start - utf8) < feature.start ||
+                                             feature.end < SkTo<size_t>(utf8End - utf8))
+        {
+            // A feature covering part of the run may start or end inside a word.
+            return this->shapeUncached(utf8, utf8Bytes, utf8Start, utf8End,
+                                       bidi, language, script, font, features, featuresSize);
+        }
+        key.fFeatures.push_back(feature.tag);
+        key.fFeatures.push_back(feature.value);
+    }
+
+    // Shape word by word, where a word is some text and the spaces after it. Words which do not
+    // border on a space are shaped with their real context and not cached, since they may be
+    // part of a longer word split across runs.
+    const char* utf8TextEnd = utf8 + utf8Bytes;
+    SkSTArray<64, ShapedGlyph, true> glyphs;
+    const char* wordStart = utf8Start;
+    while (wordStart < utf8End) {
+        const char* wordEnd = wordStart;
+        while (wordEnd < utf8End && *wordEnd != ' ') { ++wordEnd; }
+        while (wordEnd < utf8End && *wordEnd == ' ') { ++wordEnd; }
+
+        bool cacheable = (wordStart == utf8        || wordStart[-1] == ' ') &&
+                         (wordEnd   == utf8TextEnd || wordEnd[-1]   == ' ');
+        uint32_t cluster = SkToU32(wordStart - utf8);
+        if (cacheable) {
+            key.fText.set(wordStart, wordEnd - wordStart);
+            if (cache.find(key, cluster, &glyphs)) {
+                wordStart = wordEnd;
+                continue;
+            }
+        }
+
+        ShapedRun word = this->shapeUncached(utf8, utf8Bytes, wordStart, wordEnd,
+                                             bidi, language, script, font, features, featuresSize);
+        if (word.fNumGlyphs == 0) {
+            // Shaping failed, report the whole run as failed.
+            return word;
+        }
+        if (cacheable) {
+            cache.insert(key, cluster, word.fGlyphs.get(), word.fNumGlyphs);
+        }
+        glyphs.push_back_n(SkToInt(word.fNumGlyphs), word.fGlyphs.get());
+        wordStart = wordEnd;
+    }
+
+    ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8End - utf8Start),
+                  skFont, bidi.currentLevel(),
+                  std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[glyphs.count()]), glyphs.count());
+    SkVector runAdvance = { 0, 0 };
+    for (int i = 0; i < glyphs.count(); ++i) {
+        run.fGlyphs[i] = glyphs[i];
+        runAdvance += glyphs[i].fAdvance;
+    }
+    run.fAdvance = runAdvance;
+    return run;
+}
+
+ShapedRun ShaperHarfBuzz::shapeUncached(char const * const utf8,
+                                          size_t const utf8Bytes,
+                                          char const * const utf8Start,
+                                          char const * const utf8End,
+                                          const BiDiRunIterator& bidi,
+                                          const LanguageRunIterator& language,
+                                          const ScriptRunIterator& script,
+                                          const FontRunIterator& font,
+                                          Feature const * const features,
+                                          size_t const featuresSize) const
 {
     size_t utf8runLength = utf8End - utf8Start;
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
@@ -1318,8 +1615,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     hb_buffer_set_language(buffer, hb_language_from_string(language.currentLanguage(), -1));
     hb_buffer_guess_segment_properties(buffer);
 
-    // TODO: how to cache hbface (typeface) / hbfont (font)
-    HBFont hbFont(create_hb_font(font.currentFont()));
+    HBFont hbFont(HBFontCache::Get().find(font.currentFont()));
     if (!hbFont) {
         return run;
     }
@@ -1439,6 +1735,16 @@ SkShaper::MakeHbIcuScriptRunIterator(const char* utf8, size_t utf8Bytes) {
     return std::make_unique<HbIcuScriptRunIterator>(utf8, utf8Bytes);
 }
 
+void SkShaper::SetWordCacheEnabled(bool enabled) {
+    ShapedWordCache::Get().setEnabled(enabled);
+}
+SkShaper::WordCacheStats SkShaper::GetWordCacheStats() {
+    return ShapedWordCache::Get().stats();
+}
+void SkShaper::PurgeWordCache() {
+    ShapedWordCache::Get().purge();
+}
+
 std::unique_ptr<SkShaper> SkShaper::MakeShaperDrivenWrapper(sk_sp<SkFontMgr> fontmgr) {
     return MakeHarfBuzz(std::move(fontmgr), true);
 }
@@ -13,7 +13,7 @@
 #include "src/core/SkMathPriv.h"
 #include "src/utils/SkUTF.h"
 #if SK_SUPPORT_GPU
-#include "src/gpu/GrRectanizerSkyline.h"
+#include "src/core/SkRectanizerSkyline.h"
 
 // This slide visualizes the various GrRectanizer-derived classes behavior
 // for various input sets
@@ -125,7 +125,7 @@ private:
     SkTDArray<SkISize>            fRects[3];
     SkTDArray<SkISize>*           fCurRects;
     SkTDArray<SkIPoint16>         fRectLocations;
-    SkTArray<GrRectanizerSkyline> fRectanizers;
+    SkTArray<SkRectanizerSkyline> fRectanizers;
     int                           fCurRectanizer;
 
     const char* getRectanizerName() const {
@@ -866,28 +866,55 @@ class SkAAClip::Builder {
     struct Row {
         int fY;
         int fWidth;
-        SkTDArray<uint8_t>* fData;
+        int fOffset;    // where the row's runs start in fData
     };
+    // The runs of all the rows, one after the other. Only the last row is still growing.
+    SkTDArray<uint8_t> fData;
     SkTDArray<Row>  fRows;
     Row* fCurrRow;
     int fPrevY;
     int fWidth;
     int fMinY;
 
+    // Storage left by the last Builder on this thread, so that the next clip op starts with
+    // arrays that are already big enough instead of allocating them again.
+    struct Storage {
+        SkTDArray<uint8_t> fData;
+        SkTDArray<Row>     fRows;
+    };
+    static Storage* ThreadStorage() {
+    #if !defined(SK_BUILD_FOR_IOS)
+        static thread_local Storage storage;
+        return &storage;
+    #else
+        // iOS does not support thread_local until iOS 9.0.
+        return nullptr;
+    #endif
+    }
+    // Don't hold on to the storage of unusually large clips.
+    static constexpr size_t kMaxKeptBytes = 64 * 1024;
+
 public:
     Builder(const SkIRect& bounds) : fBounds(bounds) {
         fPrevY = -1;
         fWidth = bounds.width();
         fCurrRow = nullptr;
         fMinY = bounds.fTop;
+
+        // A Builder made while another is in use on this thread finds the storage taken.
+        if (Storage* storage = ThreadStorage()) {
+            fData.swap(storage->fData);
+            fRows.swap(storage->fRows);
+        }
     }
 
     ~Builder() {
-        Row* row = fRows.begin();
-        Row* stop = fRows.end();
-        while (row < stop) {
-            delete row->fData;
-            row += 1;
+        Storage* storage = ThreadStorage();
+        if (storage && fData.reserved() + fRows.reserved() * sizeof(Row) <= kMaxKeptBytes) {
+            fData.rewind();
+            fRows.rewind();
+            fData.swap(storage->fData);
+            fRows.swap(storage->fRows);
         }
     }
 
@@ -908,24 +935,22 @@ public:
             row = this->flushRow(true);
             row->fY = y;
             row->fWidth = 0;
-            SkASSERT(row->fData);
-            SkASSERT(0 == row->fData->count());
+            SkASSERT(row->fOffset == fData.count());
             fCurrRow = row;
         }
 
+        SkASSERT(row == fRows.end() - 1);
         SkASSERT(row->fWidth <= x);
         SkASSERT(row->fWidth < fBounds.width());
 
-        SkTDArray<uint8_t>& data = *row->fData;
-
         int gap = x - row->fWidth;
         if (gap) {
-            AppendRun(data, 0, gap);
+            AppendRun(fData, 0, gap);
             row->fWidth += gap;
             SkASSERT(row->fWidth < fBounds.width());
         }
 
-        AppendRun(data, alpha, count);
+        AppendRun(fData, alpha, count);
         row->fWidth += count;
         SkASSERT(row->fWidth <= fBounds.width());
     }
@@ -1000,12 +1025,7 @@ public:
         const Row* row = fRows.begin();
         const Row* stop = fRows.end();
 
-        size_t dataSize = 0;
-        while (row < stop) {
-            dataSize += row->fData->count();
-            row += 1;
-        }
-
+        size_t dataSize = fData.count();
         if (0 == dataSize) {
             return target->setEmpty();
         }
@@ -1018,26 +1038,21 @@ public:
         RunHead* head = RunHead::Alloc(fRows.count(), dataSize);
         YOffset* yoffset = head->yoffsets();
         uint8_t* data = head->data();
-        uint8_t* baseData = data;
+        memcpy(data, fData.begin(), dataSize);
 
-        row = fRows.begin();
         SkDEBUGCODE(int prevY = row->fY - 1;)
         while (row < stop) {
             SkASSERT(prevY < row->fY);  // must be monotonic
             SkDEBUGCODE(prevY = row->fY);
 
             yoffset->fY = row->fY - adjustY;
-            yoffset->fOffset = SkToU32(data - baseData);
+            yoffset->fOffset = SkToU32(row->fOffset);
             yoffset += 1;
 
-            size_t n = row->fData->count();
-            memcpy(data, row->fData->begin(), n);
 #ifdef SK_DEBUG
-            size_t bytesNeeded = compute_row_length(data, fBounds.width());
-            SkASSERT(bytesNeeded == n);
+            size_t bytesNeeded = compute_row_length(data + row->fOffset, fBounds.width());
+            SkASSERT(bytesNeeded == this->rowSize(row));
 #endif
-            data += n;
-
             row += 1;
         }
 
@@ -1053,10 +1068,9 @@ public:
         for (y = 0; y < fRows.count(); ++y) {
             const Row& row = fRows[y];
             SkDebugf("Y:%3d W:%3d", row.fY, row.fWidth);
-            const SkTDArray<uint8_t>& data = *row.fData;
-            int count = data.count();
+            int count = SkToInt(this->rowSize(&row));
             SkASSERT(!(count & 1));
-            const uint8_t* ptr = data.begin();
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             for (int x = 0; x < count; x += 2) {
                 SkDebugf(" [%3d:%02X]", ptr[0], ptr[1]);
                 ptr += 2;
@@ -1072,8 +1086,8 @@ public:
             const Row& row = fRows[i];
             SkASSERT(prevY < row.fY);
             SkASSERT(fWidth == row.fWidth);
-            int count = row.fData->count();
-            const uint8_t* ptr = row.fData->begin();
+            int count = SkToInt(this->rowSize(&row));
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             SkASSERT(!(count & 1));
             int w = 0;
             for (int x = 0; x < count; x += 2) {
@@ -1095,10 +1109,16 @@ public:
     }
 
 private:
+    size_t rowSize(const Row* row) const {
+        int end = row + 1 < fRows.end() ? row[1].fOffset : fData.count();
+        return SkToSizeT(end - row->fOffset);
+    }
+
     void flushRowH(Row* row) {
         // flush current row if needed
         if (row->fWidth < fWidth) {
-            AppendRun(*row->fData, 0, fWidth - row->fWidth);
+            SkASSERT(row == fRows.end() - 1);
+            AppendRun(fData, 0, fWidth - row->fWidth);
             row->fWidth = fWidth;
         }
     }
@@ -1115,26 +1135,22 @@ private:
             Row* curr = &fRows[count - 1];
             SkASSERT(prev->fWidth == fWidth);
             SkASSERT(curr->fWidth == fWidth);
-            if (*prev->fData == *curr->fData) {
+            size_t size = this->rowSize(curr);
+            if (this->rowSize(prev) == size &&
+                !memcmp(fData.begin() + prev->fOffset, fData.begin() + curr->fOffset, size)) {
                 prev->fY = curr->fY;
+                fData.setCount(curr->fOffset);
                 if (readyForAnother) {
-                    curr->fData->rewind();
                     next = curr;
                 } else {
-                    delete curr->fData;
-                    fRows.removeShuffle(count - 1);
-                }
-            } else {
-                if (readyForAnother) {
-                    next = fRows.append();
-                    next->fData = new SkTDArray<uint8_t>;
+                    fRows.pop();
                 }
+                return next;
             }
-        } else {
-            if (readyForAnother) {
-                next = fRows.append();
-                next->fData = new SkTDArray<uint8_t>;
-            }
+        }
+        if (readyForAnother) {
+            next = fRows.append();
+            next->fOffset = fData.count();
         }
         return next;
     }
@@ -56,11 +56,11 @@ public:
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
-
-private:
+// Used by SkRecordSerialize
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
 
+private:
     const SkRect                         fCullRect;
     const size_t                         fApproxBytesUsedBySubPictures;
     sk_sp<const SkRecord>                fRecord;
@@ -271,6 +271,12 @@ void SkBlitter::blitMask(const SkMask& mask, const SkIRect& clip) {
 
 /////////////////////// these guys are not virtual, just a helpers
 
+void SkBlitter::blitMasks(const SkMask masks[], const SkIRect clips[], int count) {
+    for (int i = 0; i < count; ++i) {
+        this->blitMask(masks[i], clips[i]);
+    }
+}
+
 void SkBlitter::blitMaskRegion(const SkMask& mask, const SkRegion& clip) {
     if (clip.quickReject(mask.fBounds)) {
         return;
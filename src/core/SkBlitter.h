@@ -70,6 +70,11 @@ public:
     /// typically used for text.
     virtual void blitMask(const SkMask&, const SkIRect& clip);
 
+    /// Blit count masks, each clipped to the rectangle at the same index in clips. Text uses this
+    /// to hand over all the glyphs of a run at once, so blitters can pick their kernels once per
+    /// run instead of once per glyph. The default calls blitMask() for each mask.
+    virtual void blitMasks(const SkMask masks[], const SkIRect clips[], int count);
+
     /** If the blitter just sets a single value for each pixel, return the
         bitmap it draws into, and assign value. If not, return nullptr and ignore
         the value parameter.
@@ -312,6 +317,9 @@ public:
         SHARD(blitAntiRect(x, y, width, height, leftAlpha, rightAlpha))
     }
     void blitMask(const SkMask& mask, const SkIRect& clip) override { SHARD(blitMask(mask, clip)) }
+    void blitMasks(const SkMask masks[], const SkIRect clips[], int count) override {
+        SHARD(blitMasks(masks, clips, count))
+    }
     const SkPixmap* justAnOpaqueColor(uint32_t* value) override { return nullptr; }
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override { SHARD(blitAntiH2(x, y, a0, a1)) }
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override { SHARD(blitAntiV2(x, y, a0, a1)) }
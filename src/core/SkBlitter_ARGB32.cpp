@@ -608,6 +608,26 @@ static inline SkPMColor blend_lcd16_opaque(int srcR, int srcG, int srcB,
 
 #endif
 
+using BlitLCD16RowProc = void (*)(SkPMColor*, const uint16_t*, SkColor, int, SkPMColor);
+
+static BlitLCD16RowProc choose_lcd16_row(SkColor color) {
+    return 0xff == SkColorGetA(color) ? blit_row_lcd16_opaque : blit_row_lcd16;
+}
+
+// opaqueDst is ignored unless blit_row is blit_row_lcd16_opaque.
+static void blit_lcd16(const SkPixmap& device, const SkMask& mask, const SkIRect& clip,
+                       SkColor color, BlitLCD16RowProc blit_row, SkPMColor opaqueDst) {
+    auto dstRow  = device.writable_addr32(clip.fLeft, clip.fTop);
+    auto maskRow = (const uint16_t*)mask.getAddr(clip.fLeft, clip.fTop);
+
+    for (int height = clip.height(); height --> 0; ) {
+        blit_row(dstRow, maskRow, color, clip.width(), opaqueDst);
+
+        dstRow  = (SkPMColor*)     ((      char*) dstRow + device.rowBytes());
+        maskRow = (const uint16_t*)((const char*)maskRow +  mask.fRowBytes);
+    }
+}
+
 static bool blit_color(const SkPixmap& device,
                        const SkMask& mask,
                        const SkIRect& clip,
@@ -623,23 +643,7 @@ static bool blit_color(const SkPixmap& device,
     }
 
     if (device.colorType() == kN32_SkColorType && mask.fFormat == SkMask::kLCD16_Format) {
-        auto dstRow  = device.writable_addr32(x,y);
-        auto maskRow = (const uint16_t*)mask.getAddr(x,y);
-
-        auto blit_row = blit_row_lcd16;
-        SkPMColor opaqueDst = 0;  // ignored unless opaque
-
-        if (0xff == SkColorGetA(color)) {
-            blit_row  = blit_row_lcd16_opaque;
-            opaqueDst = SkPreMultiplyColor(color);
-        }
-
-        for (int height = clip.height(); height --> 0; ) {
-            blit_row(dstRow, maskRow, color, clip.width(), opaqueDst);
-
-            dstRow  = (SkPMColor*)     ((      char*) dstRow + device.rowBytes());
-            maskRow = (const uint16_t*)((const char*)maskRow +  mask.fRowBytes);
-        }
+        blit_lcd16(device, mask, clip, color, choose_lcd16_row(color), SkPreMultiplyColor(color));
         return true;
     }
 
@@ -820,6 +824,41 @@ void SkARGB32_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
     }
 }
 
+void SkARGB32_Blitter::blitMasks(const SkMask masks[], const SkIRect clips[], int count) {
+    if (fSrcA == 0) {
+        return;
+    }
+
+    if (fDevice.colorType() != kN32_SkColorType) {
+        this->INHERITED::blitMasks(masks, clips, count);
+        return;
+    }
+
+    // The color is the same for every mask, so pick the kernels once for the whole batch.
+    BlitLCD16RowProc blitLCD16Row = choose_lcd16_row(fColor);
+    const size_t deviceRB = fDevice.rowBytes();
+
+    for (int i = 0; i < count; ++i) {
+        const SkMask& mask = masks[i];
+        const SkIRect& clip = clips[i];
+        SkASSERT(mask.fBounds.contains(clip));
+
+        switch (mask.fFormat) {
+            case SkMask::kA8_Format:
+                SkOpts::blit_mask_d32_a8(fDevice.writable_addr32(clip.fLeft, clip.fTop), deviceRB,
+                                         (const SkAlpha*)mask.getAddr(clip.fLeft, clip.fTop),
+                                         mask.fRowBytes, fColor, clip.width(), clip.height());
+                break;
+            case SkMask::kLCD16_Format:
+                blit_lcd16(fDevice, mask, clip, fColor, blitLCD16Row, fPMColor);
+                break;
+            default:
+                this->blitMask(mask, clip);
+                break;
+        }
+    }
+}
+
 void SkARGB32_Opaque_Blitter::blitMask(const SkMask& mask,
                                        const SkIRect& clip) {
     SkASSERT(mask.fBounds.contains(clip));
@@ -7,6 +7,7 @@
 
 #include "include/core/SkContourMeasure.h"
 #include "include/core/SkPath.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkTSearch.h"
@@ -532,7 +533,13 @@ const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar d
     int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
     // don't care if we hit an exact match or not, so we xor index if it is negative
     index ^= (index >> 31);
-    seg = &seg[index];
+
+    *t = this->distanceToT(index, distance);
+    return &seg[index];
+}
+
+SkScalar SkContourMeasure::distanceToT(int index, SkScalar distance) const {
+    const Segment* seg = &fSegments[index];
 
     // now interpolate t-values with the prev segment (if possible)
     SkScalar    startT = 0, startD = 0;
@@ -549,8 +556,7 @@ const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar d
     SkASSERT(distance >= startD);
     SkASSERT(seg->fDistance > startD);
 
-    *t = startT + (seg->getScalarT() - startT) * (distance - startD) / (seg->fDistance - startD);
-    return seg;
+    return startT + (seg->getScalarT() - startT) * (distance - startD) / (seg->fDistance - startD);
 }
 
 bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent) const {
@@ -579,6 +585,169 @@ bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tang
     return true;
 }
 
+namespace {
+// Up to four t values on one line or curve of the contour, and where their results go.
+struct PosTanBatch {
+    static constexpr int kMaxCount = 4;
+
+    const SkPoint* fPts = nullptr;
+    unsigned       fType = 0;
+    int            fCount = 0;
+    SkScalar       fT[kMaxCount];
+    int            fIndex[kMaxCount];
+};
+}  // namespace
+
+// Normalizes count tangents the way SkPoint::normalize() does: the length and its reciprocal
+// are computed in doubles, and the float vector is scaled by it.
+static void normalize_tangents(skvx::Vec<4, float> x, skvx::Vec<4, float> y,
+                               const int index[], int count, SkVector tangents[]) {
+    using D4 = skvx::Vec<4, double>;
+    D4 xx = skvx::cast<double>(x),
+       yy = skvx::cast<double>(y);
+    D4 scale = 1.0 / sqrt(xx * xx + yy * yy);
+    auto ux = skvx::cast<float>(xx * scale),
+         uy = skvx::cast<float>(yy * scale);
+    for (int i = 0; i < count; ++i) {
+        if (SkScalarsAreFinite(ux[i], uy[i]) && (ux[i] != 0 || uy[i] != 0)) {
+            tangents[index[i]].set(ux[i], uy[i]);
+        } else {
+            tangents[index[i]].set(0, 0);
+        }
+    }
+}
+
+// Computes the same results as compute_pos_tan() for each t in the batch, evaluating the
+// polynomial for all of them at once.
+static void compute_pos_tans(const PosTanBatch& batch, SkPoint positions[], SkVector tangents[]) {
+    using F4 = skvx::Vec<4, float>;
+
+    const SkPoint* pts = batch.fPts;
+    const int count = batch.fCount;
+    // Lanes past count repeat the last t value, and their results are dropped.
+    F4 t;
+    for (int i = 0; i < PosTanBatch::kMaxCount; ++i) {
+        t[i] = batch.fT[std::min(i, count - 1)];
+    }
+
+    F4 x, y, tx, ty;
+    switch (batch.fType) {
+        case kLine_SegType: {
+            x = pts[0].fX + (pts[1].fX - pts[0].fX) * t;
+            y = pts[0].fY + (pts[1].fY - pts[0].fY) * t;
+            tx = pts[1].fX - pts[0].fX;
+            ty = pts[1].fY - pts[0].fY;
+        } break;
+        case kQuad_SegType: {
+            SkQuadCoeff coeff(pts);
+            x = (coeff.fA[0] * t + coeff.fB[0]) * t + coeff.fC[0];
+            y = (coeff.fA[1] * t + coeff.fB[1]) * t + coeff.fC[1];
+            // Matches SkEvalQuadTangentAt().
+            SkVector b = pts[1] - pts[0],
+                     a = pts[2] - pts[1] - b;
+            tx = a.fX * t + b.fX;
+            ty = a.fY * t + b.fY;
+            tx = tx + tx;
+            ty = ty + ty;
+        } break;
+        case kCubic_SegType: {
+            SkCubicCoeff coeff(pts);
+            x = ((coeff.fA[0] * t + coeff.fB[0]) * t + coeff.fC[0]) * t + coeff.fD[0];
+            y = ((coeff.fA[1] * t + coeff.fB[1]) * t + coeff.fC[1]) * t + coeff.fD[1];
+            // Matches the derivative in SkEvalCubicAt().
+            Sk2s p0 = from_point(pts[0]), p1 = from_point(pts[1]),
+                 p2 = from_point(pts[2]), p3 = from_point(pts[3]);
+            Sk2s a = p3 + Sk2s(3) * (p1 - p2) - p0,
+                 b = times_2(p2 - times_2(p1) + p0),
+                 c = p1 - p0;
+            tx = (a[0] * t + b[0]) * t + c[0];
+            ty = (a[1] * t + b[1]) * t + c[1];
+        } break;
+        default:
+            // Conics divide by a varying weight; evaluate them one at a time.
+            for (int i = 0; i < count; ++i) {
+                compute_pos_tan(pts, batch.fType, batch.fT[i],
+                                positions ? &positions[batch.fIndex[i]] : nullptr,
+                                tangents ? &tangents[batch.fIndex[i]] : nullptr);
+            }
+            return;
+    }
+
+    if (positions) {
+        for (int i = 0; i < count; ++i) {
+            positions[batch.fIndex[i]].set(x[i], y[i]);
+        }
+    }
+    if (tangents) {
+        normalize_tangents(tx, ty, batch.fIndex, count, tangents);
+        // The derivative of a curve can vanish at its ends; let compute_pos_tan() handle them.
+        if (batch.fType != kLine_SegType) {
+            for (int i = 0; i < count; ++i) {
+                if (batch.fT[i] == 0 || batch.fT[i] == 1) {
+                    compute_pos_tan(pts, batch.fType, batch.fT[i], nullptr,
+                                    &tangents[batch.fIndex[i]]);
+                }
+            }
+        }
+    }
+}
+
+bool SkContourMeasure::getPosTans(const SkScalar distances[], int count,
+                                  SkPoint positions[], SkVector tangents[]) const {
+    const SkScalar length = this->length();
+    SkASSERT(length > 0 && fSegments.count() > 0);
+
+    const Segment* segs = fSegments.begin();
+    const int lastIndex = fSegments.count() - 1;
+    int index = 0;
+    SkScalar prevDistance = 0;
+    bool success = true;
+
+    PosTanBatch batch;
+    for (int i = 0; i < count; ++i) {
+        SkScalar distance = distances[i];
+        if (SkScalarIsNaN(distance)) {
+            success = false;
+            continue;
+        }
+        distance = SkTPin(distance, 0.0f, length);
+
+        // Walk forward to the first segment that reaches distance, which is the one
+        // distanceToSegment() would find. Search again if the distances go backwards.
+        if (distance < prevDistance) {
+            index = SkTKSearch<Segment, SkScalar>(segs, lastIndex + 1, distance);
+            index ^= (index >> 31);
+        } else {
+            while (index < lastIndex && segs[index].fDistance < distance) {
+                index++;
+            }
+        }
+        prevDistance = distance;
+
+        SkScalar t = this->distanceToT(index, distance);
+        if (SkScalarIsNaN(t)) {
+            success = false;
+            continue;
+        }
+
+        const SkPoint* pts = &fPts[segs[index].fPtIndex];
+        if (batch.fCount == PosTanBatch::kMaxCount ||
+                (batch.fCount > 0 && batch.fPts != pts)) {
+            compute_pos_tans(batch, positions, tangents);
+            batch.fCount = 0;
+        }
+        batch.fPts = pts;
+        batch.fType = segs[index].fType;
+        batch.fT[batch.fCount] = t;
+        batch.fIndex[batch.fCount] = i;
+        batch.fCount++;
+    }
+    if (batch.fCount > 0) {
+        compute_pos_tans(batch, positions, tangents);
+    }
+    return success;
+}
+
 bool SkContourMeasure::getMatrix(SkScalar distance, SkMatrix* matrix, MatrixFlags flags) const {
     SkPoint     position;
     SkVector    tangent;
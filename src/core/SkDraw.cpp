@@ -27,6 +27,7 @@
 #include "src/core/SkDrawProcs.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMatrixUtils.h"
+#include "src/core/SkPathMaskCache.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRectPriv.h"
@@ -880,6 +881,118 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
     proc(devPath, *fRC, blitter);
 }
 
+// Polylines with fewer points than this are stroked quickly enough as a path.
+static constexpr int kMinPolylineStrokePoints = 2048;
+
+bool SkDraw::drawPolylineStroke(const SkPath& path, const SkPaint& paint, const SkMatrix& matrix,
+                                bool drawCoverage, SkBlitter* customBlitter) const {
+    if (!gSkUseSparseAA && !gSkForceSparseAA) {
+        return false;
+    }
+    if (paint.getStyle() != SkPaint::kStroke_Style || paint.getStrokeWidth() <= 0 ||
+        !paint.isAntiAlias() || paint.getMaskFilter()) {
+        return false;
+    }
+    if (path.getSegmentMasks() != SkPath::kLine_SegmentMask || path.isInverseFillType() ||
+        !matrix.isSimilarity()) {
+        return false;
+    }
+    if (!gSkForceSparseAA && path.countPoints() < kMinPolylineStrokePoints) {
+        return false;
+    }
+
+    SkPathEffect::DashInfo dash;
+    SkAutoSTMalloc<8, SkScalar> intervals;
+    if (SkPathEffect* pathEffect = paint.getPathEffect()) {
+        if (pathEffect->asADash(&dash) != SkPathEffect::kDash_DashType) {
+            return false;
+        }
+        intervals.reset(dash.fCount);
+        dash.fIntervals = intervals.get();
+        pathEffect->asADash(&dash);
+    }
+
+    SkBlitter* blitter = customBlitter;
+    SkAutoBlitterChoose blitterStorage;
+    if (nullptr == blitter) {
+        blitter = blitterStorage.choose(*this, nullptr, paint, drawCoverage);
+    }
+    return SkScan::SparseAAStrokePath(path, matrix, SkStrokeRec(paint),
+                                      paint.getPathEffect() ? &dash : nullptr, *fRC, blitter);
+}
+
+bool SkDraw::drawPathFromMaskCache(const SkPath& path, const SkPaint& paint,
+                                   const SkMatrix& matrix) const {
+    SkPathMaskCache::Desc desc;
+    SkIPoint offset;
+    if (!SkPathMaskCache::MakeDesc(path, paint, matrix, &desc, &offset)) {
+        return false;
+    }
+
+    // Check the size before looking in the cache, so big paths don't pay for the lookup.
+    SkRect storage;
+    SkRect devBounds = matrix.mapRect(paint.computeFastBounds(path.getBounds(), &storage));
+    if (!(devBounds.width() * devBounds.height() < SkPathMaskCache::kMaxMaskArea)) {
+        return false;
+    }
+
+    SkMask mask;
+    SkCachedData* data = SkPathMaskCache::FindAndRef(desc, &mask);
+    if (!data) {
+        // Draw the mask with the fractional part of the translation; the mask is positioned at
+        // the whole pixel offset when it is blitted.
+        SkPath fillPath;
+        fillPath.setIsVolatile(true);
+        bool doFill = paint.getFillPath(path, &fillPath, nullptr,
+                                        ComputeResScaleForStroking(matrix));
+        fillPath.transform(SkPathMaskCache::MaskMatrix(desc));
+
+        // Antialiasing and hairlines can touch the pixels just outside the bounds.
+        SkIRect bounds = fillPath.getBounds().roundOut().makeOutset(1, 1);
+        if (fillPath.isEmpty() || bounds.isEmpty() ||
+            (int64_t)bounds.width() * bounds.height() > SkPathMaskCache::kMaxMaskArea) {
+            return false;
+        }
+
+        mask.fBounds   = bounds;
+        mask.fFormat   = SkMask::kA8_Format;
+        mask.fRowBytes = bounds.width();
+        const size_t size = mask.computeImageSize();
+        if (!SkPathMaskCache::CanKeep(size)) {
+            return false;
+        }
+        data = SkResourceCache::NewCachedData(size);
+        if (!data) {
+            return false;
+        }
+        mask.fImage = (uint8_t*)data->writable_data();
+        sk_bzero(mask.fImage, size);
+
+        SkDraw draw;
+        SkRasterClip clip;
+        SkMatrix translate = SkMatrix::MakeTrans(-SkIntToScalar(bounds.fLeft),
+                                                 -SkIntToScalar(bounds.fTop));
+        SkAssertResult(draw.fDst.reset(mask));
+        clip.setRect(SkIRect::MakeWH(bounds.width(), bounds.height()));
+        draw.fRC     = &clip;
+        draw.fMatrix = &translate;
+
+        SkPaint maskPaint;
+        maskPaint.setAntiAlias(paint.isAntiAlias());
+        if (!doFill) {
+            maskPaint.setStyle(SkPaint::kStroke_Style);
+        }
+        draw.drawPath(fillPath, maskPaint, nullptr, true);
+
+        SkPathMaskCache::Add(path, desc, mask, data);
+    }
+
+    mask.fBounds.offset(offset.fX, offset.fY);
+    this->drawDevMask(mask, paint);
+    data->unref();
+    return true;
+}
+
 void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
                       const SkMatrix* prePathMatrix, bool pathIsMutable,
                       bool drawCoverage, SkBlitter* customBlitter) const {
@@ -942,6 +1055,16 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         }
     }
 
+    // Paths the caller is willing to have changed are temporaries, and won't be drawn again.
+    if (!pathIsMutable && !drawCoverage && !customBlitter && pathPtr == &origSrcPath &&
+        this->drawPathFromMaskCache(origSrcPath, *paint, *matrix)) {
+        return;
+    }
+
+    if (this->drawPolylineStroke(*pathPtr, *paint, *matrix, drawCoverage, customBlitter)) {
+        return;
+    }
+
     if (paint->getPathEffect() || paint->getStyle() != SkPaint::kFill_Style) {
         SkRect cullRect;
         const SkRect* cullRectPtr = nullptr;
@@ -143,6 +143,16 @@ private:
                      bool drawCoverage,
                      SkBlitter* customBlitter,
                      bool doFill) const;
+
+    // Draw path by blitting its mask from SkPathMaskCache, adding the mask first if needed.
+    // Returns false if the path can't be drawn from the cache.
+    bool drawPathFromMaskCache(const SkPath& path, const SkPaint& paint,
+                               const SkMatrix& matrix) const;
+
+    // Draw the stroke of a long polyline with the sparse tile filler, without building the
+    // outline of the stroke. Returns false if the stroke can't be drawn this way.
+    bool drawPolylineStroke(const SkPath& path, const SkPaint& paint, const SkMatrix& matrix,
+                            bool drawCoverage, SkBlitter* customBlitter) const;
     /**
      *  Return the current clip bounds, in local coordinates, with slop to account
      *  for antialiasing or hairlines (i.e. device-bounds outset by 1, and then
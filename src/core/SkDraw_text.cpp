@@ -53,7 +53,7 @@ void SkDraw::paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint)
         for (auto [variant, pos] : drawables->drawable()) {
             SkGlyph* glyph = variant.glyph();
             if (check_glyph_position(pos)) {
-                SkMask mask = glyph->mask(pos);
+                SkMask mask = glyph->atlasMask(pos);
 
                 SkRegion::Cliperator clipper(fRC->bwRgn(), mask.fBounds);
 
@@ -77,10 +77,24 @@ void SkDraw::paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint)
     } else {
         SkIRect clipBounds = fRC->isBW() ? fRC->bwRgn().getBounds()
                                          : fRC->aaRgn().getBounds();
+
+        // Hand the masks to the blitter in batches, so it only sets up once for many glyphs.
+        // Color glyphs are drawn as sprites, so flush before each one to keep the glyphs in order.
+        static constexpr int kMaxBatch = 64;
+        SkMask masks[kMaxBatch];
+        SkIRect clips[kMaxBatch];
+        int batchCount = 0;
+        auto flush = [&]() {
+            if (batchCount > 0) {
+                blitter->blitMasks(masks, clips, batchCount);
+                batchCount = 0;
+            }
+        };
+
         for (auto [variant, pos] : drawables->drawable()) {
             SkGlyph* glyph = variant.glyph();
             if (check_glyph_position(pos)) {
-                SkMask mask = glyph->mask(pos);
+                SkMask mask = glyph->atlasMask(pos);
                 SkIRect storage;
                 const SkIRect* bounds = &mask.fBounds;
 
@@ -94,16 +108,22 @@ void SkDraw::paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint)
                 }
 
                 if (SkMask::kARGB32_Format == mask.fFormat) {
+                    flush();
                     SkBitmap bm;
                     bm.installPixels(SkImageInfo::MakeN32Premul(mask.fBounds.size()),
                                      mask.fImage,
                                      mask.fRowBytes);
                     this->drawSprite(bm, mask.fBounds.x(), mask.fBounds.y(), paint);
                 } else {
-                    blitter->blitMask(mask, *bounds);
+                    masks[batchCount] = mask;
+                    clips[batchCount] = *bounds;
+                    if (++batchCount == kMaxBatch) {
+                        flush();
+                    }
                 }
             }
         }
+        flush();
     }
 }
 
@@ -32,6 +32,15 @@ SkMask SkGlyph::mask(SkPoint position) const {
     return answer;
 }
 
+SkMask SkGlyph::atlasMask(SkPoint position) const {
+    SkMask answer = this->mask(position);
+    if (fAtlasImage != nullptr) {
+        answer.fImage = (uint8_t*)fAtlasImage;
+        answer.fRowBytes = SkToU32(fAtlasRowBytes);
+    }
+    return answer;
+}
+
 void SkGlyph::zeroMetrics() {
     fAdvanceX = 0;
     fAdvanceY = 0;
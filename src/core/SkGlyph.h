@@ -204,6 +204,10 @@ public:
 
     SkMask mask(SkPoint position) const;
 
+    // Like mask(position), but if a copy of the image was packed into the strike's SkGlyphAtlas,
+    // the mask points at the copy in the atlas page.
+    SkMask atlasMask(SkPoint position) const;
+
     // Image
     // If we haven't already tried to associate an image with this glyph
     // (i.e. setImageHasBeenCalled() returns false), then use the
@@ -284,6 +288,7 @@ private:
     // access to all the fields. Scalers are assumed to maintain all the SkGlyph invariants. The
     // consumer side has a tighter interface.
     friend class RandomScalerContext;
+    friend class SkGlyphAtlas;
     friend class SkScalerContext;
     friend class SkScalerContextProxy;
     friend class SkScalerContext_Empty;
@@ -293,6 +298,7 @@ private:
     friend class SkScalerContext_GDI;
     friend class SkScalerContext_Mac;
     friend class SkStrikeClient;
+    friend class SkStrikePersistentCache;
     friend class SkStrikeServer;
     friend class SkTestScalerContext;
     friend class SkTestSVGScalerContext;
@@ -339,6 +345,11 @@ private:
     // may still be null after the request meaning that there is no path for this glyph.
     PathData* fPathData = nullptr;
 
+    // The copy of fImage in an SkGlyphAtlas page, and the row bytes of that page. Null if the
+    // glyph was not packed into an atlas.
+    const void* fAtlasImage    = nullptr;
+    size_t      fAtlasRowBytes = 0;
+
     // The advance for this glyph.
     float     fAdvanceX = 0,
               fAdvanceY = 0;
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkGlyphAtlas.h"
+
+#include "include/core/SkTraceMemoryDump.h"
+#include "src/core/SkGlyph.h"
+
+#include <algorithm>
+#include <cstring>
+
+static size_t bytes_per_pixel(int formatIndex) {
+    static constexpr size_t kBytesPerPixel[] = {1, 2, 4};
+    return kBytesPerPixel[formatIndex];
+}
+
+SkGlyphAtlas::Page::Page(int size, size_t bytesPerPixel)
+        : fRectanizer{size, size}
+        , fRowBytes{size * bytesPerPixel}
+        , fPixels{new char[fRowBytes * size]} {}
+
+int SkGlyphAtlas::FormatIndex(SkMask::Format format) {
+    switch (format) {
+        case SkMask::kA8_Format:     return 0;
+        case SkMask::kLCD16_Format:  return 1;
+        case SkMask::kARGB32_Format: return 2;
+        // BW masks can only be placed on byte boundaries, and 3D masks are drawn by shaders.
+        default:                     return -1;
+    }
+}
+
+bool SkGlyphAtlas::Contains(const SkGlyph& glyph) {
+    return glyph.fAtlasImage != nullptr;
+}
+
+size_t SkGlyphAtlas::add(SkGlyph* glyph) {
+    SkASSERT(glyph->fAtlasImage == nullptr);
+    int formatIndex = FormatIndex(glyph->maskFormat());
+    const int width = glyph->width(),
+              height = glyph->height();
+    if (glyph->fImage == nullptr || formatIndex < 0
+        || width > kMaxGlyphDimension || height > kMaxGlyphDimension) {
+        return 0;
+    }
+
+    std::vector<std::unique_ptr<Page>>& pages = fPages[formatIndex];
+    const size_t bytesPerPixel = bytes_per_pixel(formatIndex);
+    size_t delta = 0;
+
+    // The older pages are most likely full, so try the newest page first.
+    SkIPoint16 loc;
+    Page* page = nullptr;
+    for (auto i = pages.rbegin(); i != pages.rend(); ++i) {
+        if ((*i)->fRectanizer.addRect(width, height, &loc)) {
+            page = i->get();
+            break;
+        }
+    }
+
+    if (page == nullptr) {
+        if (pages.size() == kMaxPagesPerFormat) {
+            return 0;
+        }
+        int size = std::min(kMinPageSize << pages.size(), kMaxPageSize);
+        pages.push_back(std::make_unique<Page>(size, bytesPerPixel));
+        page = pages.back().get();
+        delta = page->fRowBytes * size;
+        fMemoryUsed += delta;
+
+        // A glyph of at most kMaxGlyphDimension always fits in an empty page.
+        SkAssertResult(page->fRectanizer.addRect(width, height, &loc));
+    }
+
+    char* dst = page->fPixels.get() + loc.fY * page->fRowBytes + loc.fX * bytesPerPixel;
+    const char* src = static_cast<const char*>(glyph->fImage);
+    const size_t srcRowBytes = glyph->rowBytes();
+    for (int y = 0; y < height; y++) {
+        memcpy(dst, src, width * bytesPerPixel);
+        dst += page->fRowBytes;
+        src += srcRowBytes;
+    }
+
+    glyph->fAtlasImage = page->fPixels.get() + loc.fY * page->fRowBytes + loc.fX * bytesPerPixel;
+    glyph->fAtlasRowBytes = page->fRowBytes;
+    fGlyphCount++;
+    return delta;
+}
+
+void SkGlyphAtlas::dumpMemoryStatistics(SkTraceMemoryDump* dump, const char* dumpName) const {
+    size_t pageCount = 0;
+    for (const auto& pages : fPages) {
+        pageCount += pages.size();
+    }
+    dump->dumpNumericValue(dumpName, "size", "bytes", fMemoryUsed);
+    dump->dumpNumericValue(dumpName, "page_count", "objects", pageCount);
+    dump->dumpNumericValue(dumpName, "glyph_count", "objects", fGlyphCount);
+    dump->dumpNumericValue(dumpName, "hits", "objects", fHits.load(std::memory_order_relaxed));
+    dump->dumpNumericValue(dumpName, "misses", "objects", fMisses.load(std::memory_order_relaxed));
+    dump->setMemoryBacking(dumpName, "malloc", nullptr);
+}
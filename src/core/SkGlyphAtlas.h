@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphAtlas_DEFINED
+#define SkGlyphAtlas_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkRectanizerSkyline.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class SkGlyph;
+class SkTraceMemoryDump;
+
+// SkGlyphAtlas packs copies of a strike's glyph images into a few pages, with separate pages for
+// each mask format, so that the raster backend reads the masks of a run from a small amount of
+// memory instead of from images scattered through the strike's arena. This is the CPU
+// counterpart of GrDrawOpAtlas, but nothing is ever evicted: the pages live as long as the
+// strike, and the strike cache purges the whole strike when it needs memory.
+//
+// The owning SkScalerCache serializes calls to add() and dumpMemoryStatistics(). The hit and miss
+// counts may be updated from any thread.
+class SkGlyphAtlas {
+public:
+    // Glyphs bigger than this in either direction keep using their own image.
+    static constexpr int kMaxGlyphDimension = 128;
+
+    // Copy the image of glyph into a page, and point the glyph's atlas image at the copy. Returns
+    // the number of bytes allocated for new pages. Nothing is copied if the glyph has no image,
+    // it is too big, its format can't be packed, or all the pages for its format are full.
+    size_t add(SkGlyph* glyph);
+
+    // Return true if glyph was packed into an atlas.
+    static bool Contains(const SkGlyph& glyph);
+
+    // Count glyphs that were drawn from the atlas without taking the strike's lock, and glyphs
+    // that needed the lock or could not be drawn from the atlas.
+    void recordHits(int count) { fHits.fetch_add(count, std::memory_order_relaxed); }
+    void recordMisses(int count) { fMisses.fetch_add(count, std::memory_order_relaxed); }
+
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump, const char* dumpName) const;
+
+private:
+    static constexpr int kFormatCount = 3;
+    static constexpr int kMaxPagesPerFormat = 4;
+
+    // The first page of a format is kMinPageSize on a side; each new page doubles up to
+    // kMaxPageSize, so strikes that only use a few glyphs stay small.
+    static constexpr int kMinPageSize = 128;
+    static constexpr int kMaxPageSize = 512;
+
+    struct Page {
+        Page(int size, size_t bytesPerPixel);
+
+        SkRectanizerSkyline     fRectanizer;
+        const size_t            fRowBytes;
+        std::unique_ptr<char[]> fPixels;
+    };
+
+    // Return the index of the pages for format, or -1 if the format is not packed.
+    static int FormatIndex(SkMask::Format format);
+
+    std::vector<std::unique_ptr<Page>> fPages[kFormatCount];
+    size_t fMemoryUsed{0};
+    int fGlyphCount{0};
+    std::atomic<int> fHits{0};
+    std::atomic<int> fMisses{0};
+};
+
+#endif  // SkGlyphAtlas_DEFINED
@@ -155,6 +155,13 @@ public:
             SkPoint origin, const SkMatrix& viewMatrix,
             const SkGlyphPositionRoundingSpec& roundingSpec);
 
+    // The input of SkPackedGlyphIDs, without starting to process them.
+    SkZip<const SkGlyphVariant, const SkPoint> peekInput() const {
+        SkASSERT(fPhase == kInput);
+        return SkZip<const SkGlyphVariant, const SkPoint>{
+                fInputSize, fMultiBuffer.get(), fPositions.get()};
+    }
+
     // The input of SkPackedGlyphIDs
     SkZip<SkGlyphVariant, SkPoint> input() {
         SkASSERT(fPhase == kInput);
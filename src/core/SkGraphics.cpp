@@ -128,6 +128,14 @@ int SkGraphics::SetFontCachePointSizeLimit(int limit) {
     return SkStrikeCache::GlobalStrikeCache()->setCachePointSizeLimit(limit);
 }
 
+void SkGraphics::SetFontCacheDirectory(const char* directory) {
+    SkStrikeCache::GlobalStrikeCache()->setPersistentCacheDirectory(directory);
+}
+
+void SkGraphics::WriteFontCacheToDirectory() {
+    SkStrikeCache::GlobalStrikeCache()->writePersistentCache();
+}
+
 void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
     SkTypefaceCache::PurgeAll();
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkLazyPicture.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkTextBlob.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPicturePlayback.h"
+#include "src/core/SkReadBuffer.h"
+
+// Counts the commands by walking their headers. A command too big for the 24 bits of size in
+// its first word stores its size in a second word, plus one (see SkPictureRecord::addDraw()).
+// Playback reads the arguments of each command rather than trusting these sizes, so if they do
+// not add up, this only counts the commands before that.
+static int count_ops(const SkData& opData) {
+    SkReadBuffer reader(opData.data(), opData.size());
+    int count = 0;
+    while (!reader.eof()) {
+        uint32_t size = reader.readInt() & 0xffffff;
+        if (size == 0xffffff) {
+            size = reader.readInt() - 1;
+        }
+        // size counts the first word of the header.
+        if (!reader.isValid() || size < 4 || !reader.skip(size - 4)) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+sk_sp<SkPicture> SkLazyPicture::Make(const SkRect& cull,
+                                     std::unique_ptr<const SkPictureData> data) {
+    if (!data || !data->opData()) {
+        return nullptr;
+    }
+    int opCount = count_ops(*data->opData());
+    return sk_sp<SkPicture>(new SkLazyPicture(cull, std::move(data), opCount));
+}
+
+SkLazyPicture::SkLazyPicture(const SkRect& cull,
+                             std::unique_ptr<const SkPictureData> data,
+                             int opCount)
+    : fCullRect(cull)
+    , fData(std::move(data))
+    , fOpCount(opCount)
+{}
+
+SkLazyPicture::~SkLazyPicture() = default;
+
+void SkLazyPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+    SkPicturePlayback playback(fData.get());
+    playback.draw(canvas, callback, nullptr);
+}
+
+size_t SkLazyPicture::approximateBytesUsed() const {
+    return sizeof(*this) + fData->opData()->size();
+}
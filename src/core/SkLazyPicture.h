@@ -0,0 +1,41 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLazyPicture_DEFINED
+#define SkLazyPicture_DEFINED
+
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+
+#include <memory>
+
+class SkPictureData;
+
+// An SkPicture that plays back the serialized commands of an SkPictureData each time it is drawn,
+// instead of recording them again when it is loaded. See SkPicture::MakeLazyFromData().
+class SkLazyPicture final : public SkPicture {
+public:
+    // Returns nullptr if data is null.
+    static sk_sp<SkPicture> Make(const SkRect& cull, std::unique_ptr<const SkPictureData> data);
+
+    ~SkLazyPicture() override;
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    int approximateOpCount() const override { return fOpCount; }
+    size_t approximateBytesUsed() const override;
+
+private:
+    SkLazyPicture(const SkRect& cull, std::unique_ptr<const SkPictureData>, int opCount);
+
+    const SkRect                               fCullRect;
+    const std::unique_ptr<const SkPictureData> fData;
+    const int                                  fOpCount;
+};
+
+#endif//SkLazyPicture_DEFINED
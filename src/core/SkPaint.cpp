@@ -411,6 +411,8 @@ SkReadPaintResult SkPaintPriv::Unflatten(SkPaint* paint, SkReadBuffer& buffer, S
     {
         SkColor4f color;
         buffer.readColor4f(&color);
+        // Blitters assume alpha is in range, and SkTPin() maps NaN to 1.
+        color.fA = SkTPin(color.fA, 0.0f, 1.0f);
         paint->setColor(color, sk_srgb_singleton());
     }
 
@@ -3653,3 +3653,67 @@ bool SkPathPriv::PerspectiveClip(const SkPath& path, const SkMatrix& matrix, SkP
     clippedPath->reset();
     return true;
 }
+
+bool SkPathPriv::ResetToVerbs(SkPath* path, const uint8_t verbs[], int verbCount,
+                              int pointCount, int weightCount,
+                              SkPoint** points, SkScalar** weights) {
+    int ptCount = 0,
+        wtCount = 0,
+        lastMoveToIndex = INITIAL_LASTMOVETOINDEX_VALUE;
+    unsigned segmentMask = 0;
+    for (int i = 0; i < verbCount; ++i) {
+        const uint8_t verb = verbs[i];
+        if ((i == 0 || verbs[i - 1] == SkPath::kClose_Verb) && verb != SkPath::kMove_Verb) {
+            return false;
+        }
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                lastMoveToIndex = ptCount;
+                ptCount += 1;
+                break;
+            case SkPath::kLine_Verb:
+                segmentMask |= SkPath::kLine_SegmentMask;
+                ptCount += 1;
+                break;
+            case SkPath::kQuad_Verb:
+                segmentMask |= SkPath::kQuad_SegmentMask;
+                ptCount += 2;
+                break;
+            case SkPath::kConic_Verb:
+                segmentMask |= SkPath::kConic_SegmentMask;
+                ptCount += 2;
+                wtCount += 1;
+                break;
+            case SkPath::kCubic_Verb:
+                segmentMask |= SkPath::kCubic_SegmentMask;
+                ptCount += 3;
+                break;
+            case SkPath::kClose_Verb:
+                lastMoveToIndex ^= ~lastMoveToIndex >> (8 * sizeof(lastMoveToIndex) - 1);
+                break;
+            default:
+                return false;
+        }
+        if (ptCount > pointCount) {
+            return false;
+        }
+    }
+    if (ptCount != pointCount || wtCount != weightCount) {
+        return false;
+    }
+
+    path->reset();
+    *points = nullptr;
+    *weights = nullptr;
+    if (verbCount > 0) {
+        SkPathRef* ref = new SkPathRef;
+        memcpy(ref->fVerbs.append(verbCount), verbs, verbCount);
+        *points = ref->fPoints.append(pointCount);
+        *weights = ref->fConicWeights.append(weightCount);
+        ref->fSegmentMask = SkToU8(segmentMask);
+        ref->fGenerationID = 0;
+        path->fPathRef.reset(ref);
+        path->fLastMoveToIndex = lastMoveToIndex;
+    }
+    return true;
+}
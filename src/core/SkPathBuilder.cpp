@@ -0,0 +1,260 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPathBuilder.h"
+
+#include "include/private/SkPathRef.h"
+
+#include <algorithm>
+
+// Matches kValueNeverReturnedBySign in SkPath.cpp.
+static constexpr int kNoSign = 2;
+
+SkPathBuilder::SkPathBuilder() : SkPathBuilder(SkPathFillType::kWinding) {}
+
+SkPathBuilder::SkPathBuilder(SkPathFillType fillType) : fFillType(fillType) {
+    this->reset();
+}
+
+SkPathBuilder::~SkPathBuilder() = default;
+
+int SkPathBuilder::countPoints() const {
+    return fPathRef ? fPathRef->countPoints() : 0;
+}
+
+int SkPathBuilder::countVerbs() const {
+    return fPathRef ? fPathRef->countVerbs() : 0;
+}
+
+bool SkPathBuilder::getLastPt(SkPoint* lastPt) const {
+    int count = this->countPoints();
+    if (count == 0) {
+        return false;
+    }
+    if (lastPt) {
+        *lastPt = fPathRef->atPoint(count - 1);
+    }
+    return true;
+}
+
+SkPathBuilder& SkPathBuilder::reset() {
+    if (fPathRef) {
+        if (fShared && !fPathRef->unique()) {
+            fPathRef.reset();
+        } else {
+            fPathRef->resetToSize(0, 0, 0);
+        }
+    }
+    fShared = false;
+    fBounds.setEmpty();
+    fIsFinite = true;
+    fLastMoveToIndex = ~0;
+
+    fMoveCount = 0;
+    fLastVerbIsMove = false;
+    fFirstPt = fSignPt = {0, 0};
+    fLastSx = fLastSy = kNoSign;
+    fDxes = fDyes = 0;
+    return *this;
+}
+
+void SkPathBuilder::prepareForAppend(int verbCount, int pointCount) {
+    if (!fPathRef) {
+        fPathRef.reset(new SkPathRef);
+    } else if (fShared) {
+        if (fPathRef->unique()) {
+            // The snapshots are gone, but their generation ID may have been used as a key.
+            fPathRef->callGenIDChangeListeners();
+        } else {
+            SkPathRef* copy = new SkPathRef;
+            copy->copy(*fPathRef, verbCount, pointCount);
+            fPathRef.reset(copy);
+        }
+        fShared = false;
+    }
+    fPathRef->incReserve(verbCount, pointCount);
+    fPathRef->fGenerationID = 0;
+}
+
+SkPathBuilder& SkPathBuilder::incReserve(int extraPtCount) {
+    this->prepareForAppend(extraPtCount, extraPtCount);
+    return *this;
+}
+
+SkPoint* SkPathBuilder::growForVerb(SkPath::Verb verb, int pointCount, SkScalar weight) {
+    this->prepareForAppend(1, pointCount);
+    if (verb == SkPath::kMove_Verb) {
+        fMoveCount++;
+    }
+    fLastVerbIsMove = (verb == SkPath::kMove_Verb);
+    return fPathRef->growForVerb(verb, weight);
+}
+
+void SkPathBuilder::addPoints(const SkPoint pts[], int count) {
+    // pts are the last count points of fPathRef.
+    const bool first = fPathRef->countPoints() == count;
+    for (int i = 0; i < count; ++i) {
+        const SkPoint& pt = pts[i];
+        if (first && i == 0) {
+            fFirstPt = fSignPt = pt;
+            if (pt.isFinite()) {
+                fBounds.setLTRB(pt.fX, pt.fY, pt.fX, pt.fY);
+            } else {
+                fIsFinite = false;
+            }
+            continue;
+        }
+
+        if (fIsFinite) {
+            if (pt.isFinite()) {
+                fBounds.fLeft   = std::min(fBounds.fLeft,   pt.fX);
+                fBounds.fTop    = std::min(fBounds.fTop,    pt.fY);
+                fBounds.fRight  = std::max(fBounds.fRight,  pt.fX);
+                fBounds.fBottom = std::max(fBounds.fBottom, pt.fY);
+            } else {
+                fIsFinite = false;
+                fBounds.setEmpty();
+            }
+        }
+
+        SkVector vec = pt - fSignPt;
+        if (!vec.isZero()) {
+            int sx = vec.fX < 0,
+                sy = vec.fY < 0;
+            fDxes += (sx != fLastSx);
+            fDyes += (sy != fLastSy);
+            fLastSx = sx;
+            fLastSy = sy;
+        }
+        fSignPt = pt;
+    }
+}
+
+// SkPath finds a path concave without following its curves when it has more than one contour,
+// or when its points change direction in x or y more than three times going around the contour.
+bool SkPathBuilder::isKnownConcave() const {
+    if (!fIsFinite) {
+        return false;
+    }
+    // A trailing move does not start a contour.
+    if (fMoveCount - (fLastVerbIsMove ? 1 : 0) > 1) {
+        return true;
+    }
+    if (fMoveCount != 1 || this->countPoints() <= 3) {
+        return false;
+    }
+
+    int dxes = fDxes,
+        dyes = fDyes;
+    SkVector vec = fFirstPt - fSignPt;
+    if (!vec.isZero()) {
+        dxes += ((vec.fX < 0) != fLastSx);
+        dyes += ((vec.fY < 0) != fLastSy);
+    }
+    return dxes > 3 || dyes > 3;
+}
+
+void SkPathBuilder::injectMoveToIfNeeded() {
+    if (fLastMoveToIndex < 0) {
+        SkPoint pt = {0, 0};
+        if (this->countVerbs() != 0) {
+            pt = fPathRef->atPoint(~fLastMoveToIndex);
+        }
+        this->moveTo(pt);
+    }
+}
+
+SkPathBuilder& SkPathBuilder::moveTo(SkPoint pt) {
+    fLastMoveToIndex = this->countPoints();
+
+    SkPoint* pts = this->growForVerb(SkPath::kMove_Verb, 1);
+    pts[0] = pt;
+    this->addPoints(pts, 1);
+    return *this;
+}
+
+SkPathBuilder& SkPathBuilder::lineTo(SkPoint pt) {
+    this->injectMoveToIfNeeded();
+
+    SkPoint* pts = this->growForVerb(SkPath::kLine_Verb, 1);
+    pts[0] = pt;
+    this->addPoints(pts, 1);
+    return *this;
+}
+
+SkPathBuilder& SkPathBuilder::quadTo(SkPoint pt1, SkPoint pt2) {
+    this->injectMoveToIfNeeded();
+
+    SkPoint* pts = this->growForVerb(SkPath::kQuad_Verb, 2);
+    pts[0] = pt1;
+    pts[1] = pt2;
+    this->addPoints(pts, 2);
+    return *this;
+}
+
+SkPathBuilder& SkPathBuilder::conicTo(SkPoint pt1, SkPoint pt2, SkScalar w) {
+    // check for <= 0 or NaN with this test
+    if (!(w > 0)) {
+        this->lineTo(pt2);
+    } else if (!SkScalarIsFinite(w)) {
+        this->lineTo(pt1);
+        this->lineTo(pt2);
+    } else if (SK_Scalar1 == w) {
+        this->quadTo(pt1, pt2);
+    } else {
+        this->injectMoveToIfNeeded();
+
+        SkPoint* pts = this->growForVerb(SkPath::kConic_Verb, 2, w);
+        pts[0] = pt1;
+        pts[1] = pt2;
+        this->addPoints(pts, 2);
+    }
+    return *this;
+}
+
+SkPathBuilder& SkPathBuilder::cubicTo(SkPoint pt1, SkPoint pt2, SkPoint pt3) {
+    this->injectMoveToIfNeeded();
+
+    SkPoint* pts = this->growForVerb(SkPath::kCubic_Verb, 3);
+    pts[0] = pt1;
+    pts[1] = pt2;
+    pts[2] = pt3;
+    this->addPoints(pts, 3);
+    return *this;
+}
+
+SkPathBuilder& SkPathBuilder::close() {
+    int count = this->countVerbs();
+    // don't add a close if it's the first verb or a repeat
+    if (count > 0 && fPathRef->atVerb(count - 1) != SkPath::kClose_Verb) {
+        this->growForVerb(SkPath::kClose_Verb, 0);
+    }
+
+    // signal that we need a moveTo to follow us (unless we're done)
+    fLastMoveToIndex ^= ~fLastMoveToIndex >> (8 * sizeof(fLastMoveToIndex) - 1);
+    return *this;
+}
+
+SkPath SkPathBuilder::snapshot() {
+    SkPath path;
+    if (this->countVerbs() > 0) {
+        // Non-finite bounds are left dirty; SkPathRef computes them and remembers the path is
+        // not finite. Once shared, the bounds are already set and other threads may read them.
+        if (fIsFinite && !fShared) {
+            fPathRef->setBounds(fBounds);
+        }
+        path.fPathRef = fPathRef;
+        path.fLastMoveToIndex = fLastMoveToIndex;
+        if (this->isKnownConcave()) {
+            path.setConvexityType(SkPathConvexityType::kConcave);
+        }
+        fShared = true;
+    }
+    path.setFillType(fFillType);
+    path.setIsVolatile(fIsVolatile);
+    return path;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPathMaskCache.h"
+
+#include "include/core/SkGraphics.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/private/SkMutex.h"
+#include "src/core/SkPathPriv.h"
+
+#include <atomic>
+
+// The masks live in their own SkResourceCache, budgeted by the byte limit, so that adding a mask
+// evicts the least recently used ones instead of competing with the global resource cache.
+static std::atomic<size_t> gByteLimit{0};
+static SkResourceCache* gPathMaskCache = nullptr;
+
+static SkMutex& path_mask_cache_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+/** Must hold path_mask_cache_mutex() when calling. */
+static SkResourceCache* get_cache() {
+    path_mask_cache_mutex().assertHeld();
+    if (nullptr == gPathMaskCache) {
+        gPathMaskCache = new SkResourceCache(gByteLimit.load(std::memory_order_relaxed));
+    }
+    return gPathMaskCache;
+}
+
+struct PathMaskValue {
+    SkMask          fMask;
+    SkCachedData*   fData;
+};
+
+namespace {
+static unsigned gPathMaskKeyNamespaceLabel;
+
+struct PathMaskKey : public SkResourceCache::Key {
+public:
+    PathMaskKey(const SkPathMaskCache::Desc& desc) : fDesc(desc) {
+        // Every mask of a path shares its generation ID, so they can be purged together.
+        this->init(&gPathMaskKeyNamespaceLabel, desc.fGenID, sizeof(fDesc));
+    }
+
+    SkPathMaskCache::Desc fDesc;
+};
+
+struct PathMaskRec : public SkResourceCache::Rec {
+    PathMaskRec(const PathMaskKey& key, const SkMask& mask, SkCachedData* data)
+        : fKey(key)
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~PathMaskRec() override {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    PathMaskKey     fKey;
+    PathMaskValue   fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "path-mask"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PathMaskRec& rec = static_cast<const PathMaskRec&>(baseRec);
+        PathMaskValue* result = static_cast<PathMaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+
+// Purges the masks of a path once its generation ID can't be drawn again.
+class PathMaskInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathMaskInvalidator(uint32_t genID) : fGenID(genID) {}
+
+private:
+    void onChange() override {
+        SkAutoMutexExclusive lock(path_mask_cache_mutex());
+        get_cache()->purgeSharedID(fGenID);
+    }
+
+    const uint32_t fGenID;
+};
+} // namespace
+
+bool SkPathMaskCache::MakeDesc(const SkPath& path, const SkPaint& paint, const SkMatrix& matrix,
+                               Desc* desc, SkIPoint* offset) {
+    if (0 == GetByteLimit()) {
+        return false;
+    }
+    // Volatile paths are about to change, and inverse fills cover the whole clip.
+    if (path.isVolatile() || path.isInverseFillType() || matrix.hasPerspective() ||
+        paint.getPathEffect() || paint.getMaskFilter()) {
+        return false;
+    }
+
+    // Snap the translation to quarters of a pixel. This also rejects translations that are
+    // not finite, or too far away to be drawn.
+    const SkScalar tx = matrix.getTranslateX() * 4,
+                   ty = matrix.getTranslateY() * 4;
+    constexpr SkScalar kMaxTranslate = 1 << 24;
+    if (!(SkScalarAbs(tx) < kMaxTranslate && SkScalarAbs(ty) < kMaxTranslate)) {
+        return false;
+    }
+    const int qx = SkScalarRoundToInt(tx),
+              qy = SkScalarRoundToInt(ty);
+    offset->set(qx >> 2, qy >> 2);
+
+    desc->fGenID       = path.getGenerationID();
+    desc->fFillType    = (int32_t)path.getFillType();
+    desc->fAntiAlias   = paint.isAntiAlias();
+    desc->fScaleX      = matrix.getScaleX();
+    desc->fSkewX       = matrix.getSkewX();
+    desc->fSkewY       = matrix.getSkewY();
+    desc->fScaleY      = matrix.getScaleY();
+    desc->fSubpixelX   = qx & 3;
+    desc->fSubpixelY   = qy & 3;
+    desc->fStyle       = paint.getStyle();
+    desc->fCap         = paint.getStrokeCap();
+    desc->fJoin        = paint.getStrokeJoin();
+    desc->fStrokeWidth = paint.getStrokeWidth();
+    desc->fStrokeMiter = paint.getStrokeMiter();
+    return true;
+}
+
+SkMatrix SkPathMaskCache::MaskMatrix(const Desc& desc) {
+    return SkMatrix::MakeAll(desc.fScaleX, desc.fSkewX, desc.fSubpixelX * 0.25f,
+                             desc.fSkewY, desc.fScaleY, desc.fSubpixelY * 0.25f,
+                             0, 0, 1);
+}
+
+SkCachedData* SkPathMaskCache::FindAndRef(const Desc& desc, SkMask* mask) {
+    PathMaskValue result;
+    PathMaskKey key(desc);
+    {
+        SkAutoMutexExclusive lock(path_mask_cache_mutex());
+        if (!get_cache()->find(key, PathMaskRec::Visitor, &result)) {
+            return nullptr;
+        }
+    }
+
+    *mask = result.fMask;
+    mask->fImage = (uint8_t*)(result.fData->data());
+    return result.fData;
+}
+
+bool SkPathMaskCache::CanKeep(size_t maskBytes) {
+    // The cache evicts until it is under the limit, so a mask this big would evict itself.
+    return maskBytes + sizeof(PathMaskRec) < GetByteLimit();
+}
+
+void SkPathMaskCache::Add(const SkPath& path, const Desc& desc, const SkMask& mask,
+                          SkCachedData* data) {
+    SkASSERT(path.getGenerationID() == desc.fGenID);
+    PathMaskKey key(desc);
+    {
+        SkAutoMutexExclusive lock(path_mask_cache_mutex());
+        get_cache()->add(new PathMaskRec(key, mask, data));
+    }
+    SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<PathMaskInvalidator>(desc.fGenID));
+}
+
+size_t SkPathMaskCache::GetByteLimit() {
+    return gByteLimit.load(std::memory_order_relaxed);
+}
+
+size_t SkPathMaskCache::SetByteLimit(size_t newLimit) {
+    SkAutoMutexExclusive lock(path_mask_cache_mutex());
+    get_cache()->setTotalByteLimit(newLimit);
+    return gByteLimit.exchange(newLimit, std::memory_order_relaxed);
+}
+
+size_t SkPathMaskCache::GetBytesUsed() {
+    SkAutoMutexExclusive lock(path_mask_cache_mutex());
+    return get_cache()->getTotalBytesUsed();
+}
+
+void SkPathMaskCache::PurgeAll() {
+    SkAutoMutexExclusive lock(path_mask_cache_mutex());
+    get_cache()->purgeAll();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+size_t SkGraphics::GetPathMaskCacheByteLimit() {
+    return SkPathMaskCache::GetByteLimit();
+}
+
+size_t SkGraphics::SetPathMaskCacheByteLimit(size_t newLimit) {
+    return SkPathMaskCache::SetByteLimit(newLimit);
+}
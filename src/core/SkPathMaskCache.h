@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathMaskCache_DEFINED
+#define SkPathMaskCache_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkTypes.h"
+#include "src/core/SkCachedData.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkResourceCache.h"
+
+class SkPaint;
+class SkPath;
+
+// SkPathMaskCache keeps the A8 coverage masks of paths drawn by the raster backend in its own
+// SkResourceCache, so that drawing the same path again with the same paint geometry and matrix
+// only blits the mask. Paths drawn at different integer translations share a mask; the
+// fractional translation is snapped to a quarter of a pixel and is part of the key.
+//
+// The cache is off unless SkGraphics::SetPathMaskCacheByteLimit() is given a non-zero limit.
+// Adding a mask evicts the least recently used masks to stay within the limit, and the masks
+// of a path are purged when its generation ID changes or it is deleted.
+class SkPathMaskCache {
+public:
+    // Everything about a draw that changes its mask, except the integer part of the translation.
+    struct Desc {
+        uint32_t fGenID;
+        int32_t  fFillType;
+        int32_t  fAntiAlias;
+        SkScalar fScaleX, fSkewX, fSkewY, fScaleY;
+        int32_t  fSubpixelX, fSubpixelY;  // in quarters of a pixel
+        int32_t  fStyle;
+        int32_t  fCap;
+        int32_t  fJoin;
+        SkScalar fStrokeWidth;
+        SkScalar fStrokeMiter;
+    };
+
+    // Fill in desc and offset for drawing path with paint through matrix. The mask for desc is
+    // drawn with the integer translation offset. Returns false if the draw can't be cached.
+    static bool MakeDesc(const SkPath& path, const SkPaint& paint, const SkMatrix& matrix,
+                         Desc* desc, SkIPoint* offset);
+
+    // The matrix to draw the mask for desc with, not counting the offset.
+    static SkMatrix MaskMatrix(const Desc& desc);
+
+    /**
+     * On success, return a ref to the SkCachedData that holds the pixels, and have mask
+     * already point to that memory.
+     *
+     * On failure, return nullptr.
+     */
+    static SkCachedData* FindAndRef(const Desc& desc, SkMask* mask);
+
+    // Return true if a mask whose pixels take maskBytes would be kept by Add().
+    static bool CanKeep(size_t maskBytes);
+
+    /**
+     * Add a mask of path and its pixel-data to the cache, evicting older masks if needed.
+     */
+    static void Add(const SkPath& path, const Desc& desc, const SkMask& mask,
+                    SkCachedData* data);
+
+    // Masks with more pixels than this are not cached.
+    static constexpr int kMaxMaskArea = 256 * 256;
+
+    static size_t GetByteLimit();
+    static size_t SetByteLimit(size_t newLimit);
+    static size_t GetBytesUsed();
+    static void PurgeAll();
+};
+
+#endif
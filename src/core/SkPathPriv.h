@@ -174,6 +174,11 @@ public:
     */
     static bool IsConvex(const SkPoint pts[], int count);
 
+    /** Returns the number of bytes SkPath::readFromMemory() reads from storage, checking only
+        the header and the lengths that follow it, or 0 if they are not valid.
+    */
+    static size_t SerializedSize(const void* storage, size_t length);
+
     /** Returns true if the underlying SkPathRef has one single owner. */
     static bool TestingOnly_unique(const SkPath& path) {
         return path.fPathRef->unique();
@@ -328,6 +333,19 @@ public:
      *  If no clipping is needed, returns false and "result" is left unchanged.
      */
     static bool PerspectiveClip(const SkPath& src, const SkMatrix&, SkPath* result);
+
+    /**
+     *  Replaces the contents of path with the verbs, and returns in points and weights where the
+     *  caller must then write the pointCount points and weightCount conic weights they use. This
+     *  skips the work of adding each verb, for readers of serialized paths.
+     *
+     *  Returns false, leaving path unchanged, unless the verbs are ones SkPath's methods can add:
+     *  a move first and after each close, using exactly pointCount points and weightCount
+     *  weights. The caller must only write weights conicTo() keeps: finite, positive and not one.
+     */
+    static bool ResetToVerbs(SkPath* path, const uint8_t verbs[], int verbCount,
+                             int pointCount, int weightCount,
+                             SkPoint** points, SkScalar** weights);
 };
 
 // Lightweight variant of SkPath::Iter that only returns segments (e.g. lines/conics).
@@ -11,12 +11,14 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkLazyPicture.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkPictureCommon.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePlayback.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
+#include "src/core/SkRecordSerialize.h"
 #include <atomic>
 
 // When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
@@ -29,6 +31,7 @@ enum {
     kFailure_TrailingStreamByteAfterPictInfo     = 0,   // nothing follows
     kPictureData_TrailingStreamByteAfterPictInfo = 1,   // SkPictureData follows
     kCustom_TrailingStreamByteAfterPictInfo      = 2,   // -size32 follows
+    kRecord_TrailingStreamByteAfterPictInfo      = 3,   // SkRecordSerialize() data follows
 };
 
 /* SkPicture impl.  This handles generic responsibilities like unique IDs and serialization. */
@@ -153,8 +156,16 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeLazyFromData(sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStream(&stream, procs, nullptr, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces, SkData* lazySource) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -169,6 +180,11 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
     if (!stream->readU8(&trailingStreamByteAfterPictInfo)) { return nullptr; }
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
+            if (lazySource) {
+                std::unique_ptr<SkPictureData> data(SkPictureData::CreateLazyFromStream(
+                        stream, sk_ref_sp(lazySource), info, procs, typefaces));
+                return SkLazyPicture::Make(info.fCullRect, std::move(data));
+            }
             std::unique_ptr<SkPictureData> data(
                     SkPictureData::CreateFromStream(stream, info, procs, typefaces));
             return Forwardport(info, data.get(), nullptr);
@@ -185,6 +201,8 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
             }
             return procs.fPictureProc(data->data(), size, procs.fPictureCtx);
         }
+        case kRecord_TrailingStreamByteAfterPictInfo:
+            return SkRecordDeserialize(stream, info, procs, lazySource);
         default:    // fall through to error return
             break;
     }
@@ -258,6 +276,18 @@ static bool write_pad32(SkWStream* stream, const void* data, size_t size) {
     return true;
 }
 
+// Writes the trailing byte and data for custom, as returned by custom_serialize().
+static void write_custom(SkWStream* stream, const SkData* custom) {
+    int32_t size = SkToS32(custom->size());
+    if (size == 0) {
+        stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
+        return;
+    }
+    stream->write8(kCustom_TrailingStreamByteAfterPictInfo);
+    stream->write32(-size);    // negative for custom format
+    write_pad32(stream, custom->data(), size);
+}
+
 // Private serialize.
 // SkPictureData::serialize makes a first pass on all subpictures, indicatewd by textBlobsOnly=true,
 // to fill typefaceSet.
@@ -272,14 +302,7 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     stream->write(&info, sizeof(info));
 
     if (auto custom = custom_serialize(this, procs)) {
-        int32_t size = SkToS32(custom->size());
-        if (size == 0) {
-            stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
-            return;
-        }
-        stream->write8(kCustom_TrailingStreamByteAfterPictInfo);
-        stream->write32(-size);    // negative for custom format
-        write_pad32(stream, custom->data(), size);
+        write_custom(stream, custom.get());
         return;
     }
 
@@ -292,6 +315,26 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     }
 }
 
+sk_sp<SkData> SkPicturePriv::SerializeRecord(const SkPicture* picture,
+                                             const SkSerialProcs* procsPtr) {
+    SkSerialProcs procs;
+    if (procsPtr) {
+        procs = *procsPtr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    SkPictInfo info = picture->createHeader();
+    stream.write(&info, sizeof(info));
+
+    if (auto custom = custom_serialize(picture, procs)) {
+        write_custom(&stream, custom.get());
+    } else {
+        stream.write8(kRecord_TrailingStreamByteAfterPictInfo);
+        SkRecordSerialize(picture, &stream, procs);
+    }
+    return stream.detachAsData();
+}
+
 void SkPicturePriv::Flatten(const sk_sp<const SkPicture> picture, SkWriteBuffer& buffer) {
     SkPictInfo info = picture->createHeader();
     std::unique_ptr<SkPictureData> data(picture->backport());
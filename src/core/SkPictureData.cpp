@@ -10,7 +10,6 @@
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTo.h"
-#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
 #include "src/core/SkReadBuffer.h"
@@ -284,6 +283,21 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Returns size bytes of source starting at stream's position, and moves the stream past them.
+// SkReadBuffer needs 4-byte aligned memory, which the bytes after a picture's header are not,
+// so they are only shared with source when they happen to be aligned.
+static sk_sp<SkData> share_or_copy(SkStream* stream, SkData* source, size_t size) {
+    SkASSERT(stream->getMemoryBase() == source->data());
+    const size_t offset = stream->getPosition();
+    if (size > source->size() - offset) {
+        return nullptr;
+    }
+    sk_sp<SkData> data = SkIsAlign4(reinterpret_cast<uintptr_t>(source->bytes() + offset))
+                       ? SkData::MakeSubset(source, offset, size)
+                       : SkData::MakeWithCopy(source->bytes() + offset, size);
+    return stream->skip(size) == size ? data : nullptr;
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
@@ -292,7 +306,8 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = fLazy ? share_or_copy(stream, fLazy->fSource.get(), size)
+                            : SkData::MakeFromStream(stream, size);
             if (!fOpData) {
                 return false;
             }
@@ -328,7 +343,8 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback,
+                                                     fLazy ? fLazy->fSource.get() : nullptr);
                 if (!pic) {
                     return false;
                 }
@@ -336,12 +352,23 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            sk_sp<SkData> storage;
+            if (fLazy) {
+                storage = share_or_copy(stream, fLazy->fSource.get(), size);
+                if (!storage) {
+                    return false;
+                }
+                // Paths and images are decoded from the buffer later.
+                fLazy->fBuffer = storage;
+                fLazy->fProcs = procs;
+            } else {
+                storage = SkData::MakeUninitialized(size);
+                if (stream->read(storage->writable_data(), size) != size) {
+                    return false;
+                }
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), size);
             buffer.setVersion(fInfo.getVersion());
 
             if (!fFactoryPlayback) {
@@ -408,6 +435,50 @@ bool new_array_from_buffer(SkReadBuffer& buffer, uint32_t inCount,
     return true;
 }
 
+// Records where each of inCount objects starts in buffer, and makes room for them in array, to
+// be decoded the first time they are used.
+template <typename T>
+bool skip_array_in_buffer(SkReadBuffer& buffer, uint32_t inCount, SkTArray<T>& array,
+                          SkTDArray<uint32_t>* offsets, std::unique_ptr<SkOnce[]>* once,
+                          void (SkReadBuffer::*skip)()) {
+    // Each object takes at least 4 bytes, so this also checks that inCount is not absurd.
+    if (!buffer.validate(array.empty() && SkTFitsIn<int>(inCount)) ||
+        !buffer.validateCanReadN<uint32_t>(inCount)) {
+        return false;
+    }
+    const int count = SkToInt(inCount);
+
+    for (int i = 0; i < count; ++i) {
+        offsets->push_back(SkToU32(buffer.offset()));
+        (buffer.*skip)();
+        if (!buffer.isValid()) {
+            return false;
+        }
+    }
+    array.reset(count);
+    once->reset(new SkOnce[count]);
+    return true;
+}
+
+void SkPictureData::decodePath(int index) const {
+    const size_t offset = fLazy->fPathOffsets[index];
+    SkReadBuffer buffer(fLazy->fBuffer->bytes() + offset, fLazy->fBuffer->size() - offset);
+    buffer.setVersion(fInfo.getVersion());
+    // Only the size of the path was checked when it was loaded; if it is not valid after all,
+    // it is drawn as an empty path.
+    buffer.readPath(&fPaths[index]);
+    fPaths[index].updateBoundsCache();
+}
+
+void SkPictureData::decodeImage(int index) const {
+    const size_t offset = fLazy->fImageOffsets[index];
+    SkReadBuffer buffer(fLazy->fBuffer->bytes() + offset, fLazy->fBuffer->size() - offset);
+    buffer.setVersion(fInfo.getVersion());
+    buffer.setDeserialProcs(fLazy->fProcs);
+    buffer.setBackingData(fLazy->fBuffer);
+    fImages[index] = buffer.readImage();
+}
+
 void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t size) {
     switch (tag) {
         case SK_PICT_PAINT_BUFFER_TAG: {
@@ -429,6 +500,11 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
                 if (!buffer.validate(count >= 0)) {
                     return;
                 }
+                if (fLazy) {
+                    skip_array_in_buffer(buffer, count, fPaths, &fLazy->fPathOffsets,
+                                         &fLazy->fPathOnce, &SkReadBuffer::skipPath);
+                    return;
+                }
                 for (int i = 0; i < count; i++) {
                     buffer.readPath(&fPaths.push_back());
                     if (!buffer.isValid()) {
@@ -443,6 +519,11 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
             new_array_from_buffer(buffer, size, fVertices, create_vertices_from_buffer);
             break;
         case SK_PICT_IMAGE_BUFFER_TAG:
+            if (fLazy) {
+                skip_array_in_buffer(buffer, size, fImages, &fLazy->fImageOffsets,
+                                     &fLazy->fImageOnce, &SkReadBuffer::skipImage);
+                break;
+            }
             new_array_from_buffer(buffer, size, fImages, create_image_from_buffer);
             break;
         case SK_PICT_READER_TAG: {
@@ -486,6 +567,26 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
     return data.release();
 }
 
+SkPictureData* SkPictureData::CreateLazyFromStream(SkStream* stream,
+                                                   sk_sp<SkData> source,
+                                                   const SkPictInfo& info,
+                                                   const SkDeserialProcs& procs,
+                                                   SkTypefacePlayback* topLevelTFPlayback) {
+    std::unique_ptr<SkPictureData> data(new SkPictureData(info));
+    data->fLazy = std::make_unique<Lazy>();
+    data->fLazy->fSource = std::move(source);
+    if (!topLevelTFPlayback) {
+        topLevelTFPlayback = &data->fTFPlayback;
+    }
+
+    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+        return nullptr;
+    }
+    // The buffer holds what the paths and images are decoded from; the rest is no longer needed.
+    data->fLazy->fSource.reset();
+    return data.release();
+}
+
 SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
                                                const SkPictInfo& info) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
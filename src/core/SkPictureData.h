@@ -11,7 +11,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkDrawable.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTDArray.h"
 #include "src/core/SkPictureFlat.h"
 
 #include <memory>
@@ -83,6 +86,14 @@ public:
                                            const SkDeserialProcs&,
                                            SkTypefacePlayback*);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
+    // Like CreateFromStream(), but stream reads from source, which the SkPictureData keeps. Its
+    // paths and images are only checked to be the right size, and are decoded from source the
+    // first time playback asks for them.
+    static SkPictureData* CreateLazyFromStream(SkStream*,
+                                               sk_sp<SkData> source,
+                                               const SkPictInfo&,
+                                               const SkDeserialProcs&,
+                                               SkTypefacePlayback*);
 
     void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*, bool textBlobsOnly=false) const;
     void flatten(SkWriteBuffer&) const;
@@ -100,13 +111,24 @@ public:
     const SkImage* getImage(SkReadBuffer* reader) const {
         // images are written base-0, unlike paths, pictures, drawables, etc.
         const int index = reader->readInt();
-        return reader->validateIndex(index, fImages.count()) ? fImages[index].get() : nullptr;
+        if (!reader->validateIndex(index, fImages.count())) {
+            return nullptr;
+        }
+        if (fLazy) {
+            fLazy->fImageOnce[index]([this, index] { this->decodeImage(index); });
+        }
+        return fImages[index].get();
     }
 
     const SkPath& getPath(SkReadBuffer* reader) const {
         int index = reader->readInt();
-        return reader->validate(index > 0 && index <= fPaths.count()) ?
-                fPaths[index - 1] : fEmptyPath;
+        if (!reader->validate(index > 0 && index <= fPaths.count())) {
+            return fEmptyPath;
+        }
+        if (fLazy) {
+            fLazy->fPathOnce[index - 1]([this, index] { this->decodePath(index - 1); });
+        }
+        return fPaths[index - 1];
     }
 
     const SkPicture* getPicture(SkReadBuffer* reader) const {
@@ -141,9 +163,21 @@ private:
                         const SkDeserialProcs&, SkTypefacePlayback*);
     void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&, bool textBlobsOnly) const;
+    void decodePath(int index) const;
+    void decodeImage(int index) const;
+
+    // Set by CreateLazyFromStream().
+    struct Lazy {
+        sk_sp<SkData>             fSource;
+        sk_sp<SkData>             fBuffer;   // the paths, images, etc. of this picture
+        SkDeserialProcs           fProcs;
+        SkTDArray<uint32_t>       fPathOffsets, fImageOffsets;   // into fBuffer
+        std::unique_ptr<SkOnce[]> fPathOnce, fImageOnce;
+    };
+    std::unique_ptr<Lazy> fLazy;
 
     SkTArray<SkPaint>  fPaints;
-    SkTArray<SkPath>   fPaths;
+    mutable SkTArray<SkPath> fPaths;   // decoded by getPath() when fLazy is set
 
     sk_sp<SkData>   fOpData;    // opcodes and parameters
 
@@ -154,7 +188,7 @@ private:
     SkTArray<sk_sp<SkDrawable>>        fDrawables;
     SkTArray<sk_sp<const SkTextBlob>>  fTextBlobs;
     SkTArray<sk_sp<const SkVertices>>  fVertices;
-    SkTArray<sk_sp<const SkImage>>     fImages;
+    mutable SkTArray<sk_sp<const SkImage>> fImages;   // decoded by getImage() when fLazy is set
 
     SkTypefacePlayback                 fTFPlayback;
     std::unique_ptr<SkFactoryPlayback> fFactoryPlayback;
@@ -30,6 +30,13 @@ public:
      */
     static void Flatten(const sk_sp<const SkPicture> , SkWriteBuffer& buffer);
 
+    /**
+     *  Serialize in the compact format of SkRecordSerialize.h, which SkPicture::MakeFromData()
+     *  and MakeFromStream() read back without re-recording. Sub-pictures are written in the
+     *  same format unless procs has an fPictureProc.
+     */
+    static sk_sp<SkData> SerializeRecord(const SkPicture*, const SkSerialProcs* = nullptr);
+
     // Returns NULL if this is not an SkBigPicture.
     static const SkBigPicture* AsSkBigPicture(const sk_sp<const SkPicture> picture) {
         return picture->asSkBigPicture();
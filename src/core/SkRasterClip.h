@@ -64,6 +64,8 @@ public:
     SkRasterClip(const SkRasterClip&);
     ~SkRasterClip();
 
+    SkRasterClip& operator=(const SkRasterClip&);
+
     // Only compares the current state. Does not compare isForceConservativeRects(), so that field
     // could be different but this could still return true.
     bool operator==(const SkRasterClip&) const;
@@ -9,8 +9,12 @@
 #define SkRasterClipStack_DEFINED
 
 #include "include/core/SkClipOp.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
 #include "include/private/SkDeque.h"
 #include "src/core/SkRasterClip.h"
+#include <memory>
 #include <new>
 
 template <typename T> class SkTStack {
@@ -70,6 +74,7 @@ public:
         Rec& rec = fStack.push();
         rec.fRC.setRect(fRootBounds);
         rec.fDeferredCount = 0;
+        rec.fGenID = this->nextGenID();
         SkASSERT(fStack.count() == 1);
     }
 
@@ -80,10 +85,16 @@ public:
         Rec& rec = fStack.top();
         SkASSERT(rec.fDeferredCount == 0);
         rec.fRC.setRect(fRootBounds);
+        rec.fGenID = this->nextGenID();
+        this->purgeCache();
     }
 
     const SkRasterClip& rc() const { return fStack.top().fRC; }
 
+    // Clips with the same gen ID are known to be the same; repeated clips found in the cache get
+    // the gen ID they had the first time.
+    uint64_t genID() const { return fStack.top().fGenID; }
+
     void save() {
         fCounter += 1;
         SkASSERT(fStack.top().fDeferredCount >= 0);
@@ -100,31 +111,64 @@ public:
     }
 
     void clipRect(const SkMatrix& ctm, const SkRect& rect, SkClipOp op, bool aa) {
+        CacheKey key;
+        bool cacheable = this->initCacheKey(CacheKey::kRect_Shape, ctm, op, aa, &key);
+        if (cacheable) {
+            key.fRect = rect;
+            if (this->findCached(key)) {
+                return;
+            }
+        }
         this->writable_rc().op(rect, ctm, fRootBounds, (SkRegion::Op)op, aa);
         this->trimIfExpanding(op);
+        this->didChange(cacheable ? &key : nullptr);
         this->validate();
     }
 
     void clipRRect(const SkMatrix& ctm, const SkRRect& rrect, SkClipOp op, bool aa) {
+        CacheKey key;
+        bool cacheable = this->initCacheKey(CacheKey::kRRect_Shape, ctm, op, aa, &key);
+        if (cacheable) {
+            key.fRRect = rrect;
+            if (this->findCached(key)) {
+                return;
+            }
+        }
         this->writable_rc().op(rrect, ctm, fRootBounds, (SkRegion::Op)op, aa);
         this->trimIfExpanding(op);
+        this->didChange(cacheable ? &key : nullptr);
         this->validate();
     }
 
     void clipPath(const SkMatrix& ctm, const SkPath& path, SkClipOp op, bool aa) {
+        CacheKey key;
+        // Volatile paths are about to change, so their clips are not worth keeping.
+        bool cacheable = !path.isVolatile() &&
+                         this->initCacheKey(CacheKey::kPath_Shape, ctm, op, aa, &key);
+        if (cacheable) {
+            key.fPathGenID = path.getGenerationID();
+            key.fPathFillType = path.getFillType();
+            if (this->findCached(key)) {
+                return;
+            }
+        }
         this->writable_rc().op(path, ctm, fRootBounds, (SkRegion::Op)op, aa);
         this->trimIfExpanding(op);
+        this->didChange(cacheable ? &key : nullptr);
         this->validate();
     }
 
     void clipRegion(const SkRegion& rgn, SkClipOp op) {
         this->writable_rc().op(rgn, (SkRegion::Op)op);
         this->trimIfExpanding(op);
+        this->didChange(nullptr);
         this->validate();
     }
 
     void setDeviceClipRestriction(SkIRect* mutableClipRestriction) {
         this->writable_rc().setDeviceClipRestriction(mutableClipRestriction);
+        // The cached clips still point at the old restriction.
+        this->purgeCache();
     }
 
     void validate() const {
@@ -142,15 +186,131 @@ private:
     struct Rec {
         SkRasterClip    fRC;
         int             fDeferredCount; // 0 for a "normal" entry
+        uint64_t        fGenID;         // the same for recs whose fRC is known to be the same
+    };
+
+    /*
+     *  Drawing often sets up the same clip again and again: save, clip, draw, restore, and the
+     *  same clip for the next frame. Each rec has a gen ID for its clip, and the results of the
+     *  last few clip calls are kept, keyed by the gen ID of the clip they were applied to. Making
+     *  the same call on that clip again copies the kept result, which shares its runs, and its
+     *  gen ID, so the clips after it are found in the cache too.
+     *
+     *  Only intersect and difference are cached; the other ops depend on the clip restriction.
+     */
+    struct CacheKey {
+        enum Shape {
+            kRect_Shape,
+            kRRect_Shape,
+            kPath_Shape,
+        };
+
+        uint64_t    fParentGenID;
+        SkMatrix    fCTM;
+        Shape       fShape;
+        SkClipOp    fOp;
+        bool        fAA;
+        // Only the one for fShape is set.
+        SkRect      fRect;
+        SkRRect     fRRect;
+        uint32_t    fPathGenID;
+        // Except on Android, the gen ID doesn't change with the fill type.
+        SkPathFillType fPathFillType;
+
+        bool operator==(const CacheKey& that) const {
+            if (fParentGenID != that.fParentGenID || fShape != that.fShape ||
+                fOp != that.fOp || fAA != that.fAA || fCTM != that.fCTM) {
+                return false;
+            }
+            switch (fShape) {
+                case kRect_Shape:  return fRect == that.fRect;
+                case kRRect_Shape: return fRRect == that.fRRect;
+                case kPath_Shape:  return fPathGenID == that.fPathGenID &&
+                                          fPathFillType == that.fPathFillType;
+            }
+            SkUNREACHABLE;
+        }
+    };
+    struct CacheEntry {
+        CacheKey        fKey;
+        SkRasterClip    fRC;
+        uint64_t        fGenID;
     };
 
     enum {
         ELEM_COUNT = 16,
-        PTR_COUNT = ELEM_COUNT * sizeof(Rec) / sizeof(void*)
+        PTR_COUNT = ELEM_COUNT * sizeof(Rec) / sizeof(void*),
+        CACHE_COUNT = 16
     };
     void*           fStorage[PTR_COUNT];
     SkTStack<Rec>   fStack;
     SkIRect         fRootBounds;
+    uint64_t        fNextGenID = 1;
+
+    std::unique_ptr<CacheEntry[]> fCache;   // allocated when the first clip is cached
+    int             fCacheCount = 0;        // entries in use
+    int             fCacheNext = 0;         // the entry to replace next, once all are in use
+
+    uint64_t nextGenID() {
+        return fNextGenID++;
+    }
+
+    bool initCacheKey(CacheKey::Shape shape, const SkMatrix& ctm, SkClipOp op, bool aa,
+                      CacheKey* key) const {
+        if (op != SkClipOp::kIntersect && op != SkClipOp::kDifference) {
+            return false;
+        }
+        key->fParentGenID = fStack.top().fGenID;
+        key->fCTM = ctm;
+        key->fShape = shape;
+        key->fOp = op;
+        key->fAA = aa;
+        return true;
+    }
+
+    bool findCached(const CacheKey& key) {
+        for (int i = 0; i < fCacheCount; ++i) {
+            const CacheEntry& entry = fCache[i];
+            if (entry.fKey == key) {
+                this->writable_rc() = entry.fRC;
+                fStack.top().fGenID = entry.fGenID;
+                this->validate();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Called after the top clip has changed, with the key of the change if it can be cached.
+    void didChange(const CacheKey* key) {
+        Rec& rec = fStack.top();
+        rec.fGenID = this->nextGenID();
+        if (!key) {
+            return;
+        }
+
+        CacheEntry* entry;
+        if (fCacheCount < CACHE_COUNT) {
+            if (!fCache) {
+                fCache.reset(new CacheEntry[CACHE_COUNT]);
+            }
+            entry = &fCache[fCacheCount++];
+        } else {
+            entry = &fCache[fCacheNext];
+            fCacheNext = (fCacheNext + 1) % CACHE_COUNT;
+        }
+        entry->fKey = *key;
+        entry->fRC = rec.fRC;
+        entry->fGenID = rec.fGenID;
+    }
+
+    void purgeCache() {
+        for (int i = 0; i < fCacheCount; ++i) {
+            fCache[i].fRC.setEmpty();
+        }
+        fCacheCount = 0;
+        fCacheNext = 0;
+    }
 
     SkRasterClip& writable_rc() {
         SkASSERT(fStack.top().fDeferredCount >= 0);
@@ -14,6 +14,7 @@
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSafeMath.h"
 
@@ -231,6 +232,15 @@ void SkReadBuffer::readPath(SkPath* path) {
     (void)this->skip(size);
 }
 
+void SkReadBuffer::skipPath() {
+    size_t size = 0;
+    if (!fError) {
+        size = SkPathPriv::SerializedSize(fReader.peek(), fReader.available());
+        this->validate((SkAlign4(size) == size) && (0 != size));
+    }
+    (void)this->skip(size);
+}
+
 bool SkReadBuffer::readArray(void* value, size_t size, size_t elementSize) {
     const uint32_t count = this->readUInt();
     return this->validate(size == count) &&
@@ -286,52 +296,67 @@ uint32_t SkReadBuffer::getArrayCount() {
  *  size (31bits)
  *  data [ encoded, with raw width/height ]
  */
-sk_sp<SkImage> SkReadBuffer::readImage() {
-    SkIRect bounds;
+bool SkReadBuffer::readImageHeader(SkIRect* bounds, int32_t* size) {
     if (this->isVersionLT(SkPicturePriv::kStoreImageBounds_Version)) {
-        bounds.fLeft = bounds.fTop = 0;
-        bounds.fRight = this->read32();
-        bounds.fBottom = this->read32();
+        bounds->fLeft = bounds->fTop = 0;
+        bounds->fRight = this->read32();
+        bounds->fBottom = this->read32();
     } else {
-        this->readIRect(&bounds);
+        this->readIRect(bounds);
     }
-    const int width = bounds.width();
-    const int height = bounds.height();
-    if (width <= 0 || height <= 0) {    // SkImage never has a zero dimension
-        this->validate(false);
-        return nullptr;
+    if (bounds->width() <= 0 || bounds->height() <= 0) {    // SkImage never has a zero dimension
+        return this->validate(false);
     }
 
-    int32_t size = this->read32();
-    if (size == SK_NaN32) {
+    *size = this->read32();
+    if (*size == SK_NaN32) {
         // 0x80000000 is never valid, since it cannot be passed to abs().
-        this->validate(false);
-        return nullptr;
+        return this->validate(false);
     }
-    if (size == 0) {
-        // The image could not be encoded at serialization time - return an empty placeholder.
-        return MakeEmptyImage(width, height);
+    if (*size == 0) {
+        return this->isValid();
     }
 
     // we used to negate the size for "custom" encoded images -- ignore that signal (Dec-2017)
-    size = SkAbs32(size);
-    if (size == 1) {
+    *size = SkAbs32(*size);
+    if (*size == 1) {
         // legacy check (we stopped writing this for "raw" images Nov-2017)
-        this->validate(false);
-        return nullptr;
+        return this->validate(false);
     }
 
     // Preflight check to make sure there's enough stuff in the buffer before
     // we allocate the memory. This helps the fuzzer avoid OOM when it creates
     // bad/corrupt input.
-    if (!this->validateCanReadN<uint8_t>(size)) {
+    return this->validateCanReadN<uint8_t>(*size);
+}
+
+sk_sp<SkImage> SkReadBuffer::readImage() {
+    SkIRect bounds;
+    int32_t size;
+    if (!this->readImageHeader(&bounds, &size)) {
         return nullptr;
     }
+    const int width = bounds.width();
+    const int height = bounds.height();
+    if (size == 0) {
+        // The image could not be encoded at serialization time - return an empty placeholder.
+        return MakeEmptyImage(width, height);
+    }
 
-    sk_sp<SkData> data = SkData::MakeUninitialized(size);
-    if (!this->readPad32(data->writable_data(), size)) {
-        this->validate(false);
-        return nullptr;
+    sk_sp<SkData> data;
+    const char* base = fBackingData ? (const char*)fBackingData->data() : nullptr;
+    const char* src = (const char*)fReader.peek();
+    if (base && src >= base && src + size <= base + fBackingData->size()) {
+        if (!this->skip(size)) {
+            return nullptr;
+        }
+        data = SkData::MakeSubset(fBackingData.get(), src - base, size);
+    } else {
+        data = SkData::MakeUninitialized(size);
+        if (!this->readPad32(data->writable_data(), size)) {
+            this->validate(false);
+            return nullptr;
+        }
     }
     if (this->isVersionLT(SkPicturePriv::kDontNegateImageSize_Version)) {
         (void)this->read32();   // originX
@@ -355,6 +380,19 @@ sk_sp<SkImage> SkReadBuffer::readImage() {
     return image ? image : MakeEmptyImage(width, height);
 }
 
+void SkReadBuffer::skipImage() {
+    SkIRect bounds;
+    int32_t size;
+    if (!this->readImageHeader(&bounds, &size) || size == 0) {
+        return;
+    }
+    (void)this->skip(size);
+    if (this->isVersionLT(SkPicturePriv::kDontNegateImageSize_Version)) {
+        (void)this->read32();   // originX
+        (void)this->read32();   // originY
+    }
+}
+
 sk_sp<SkTypeface> SkReadBuffer::readTypeface() {
     // Read 32 bits (signed)
     //   0 -- return null (default font)
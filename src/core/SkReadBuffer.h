@@ -9,6 +9,7 @@
 #define SkReadBuffer_DEFINED
 
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkDrawLooper.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImageFilter.h"
@@ -24,7 +25,6 @@
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkShaderBase.h"
 
-class SkData;
 class SkImage;
 
 #ifndef SK_DISABLE_READBUFFER
@@ -97,6 +97,8 @@ public:
     void readRegion(SkRegion* region);
 
     void readPath(SkPath* path);
+    // Skips a path, checking only its header and length.
+    void skipPath();
 
     SkReadPaintResult readPaint(SkPaint* paint, SkFont* font) {
         return SkPaintPriv::Unflatten(paint, *this, font);
@@ -133,8 +135,14 @@ public:
     // be created (e.g. it was not originally encoded) then this returns an image that doesn't
     // draw.
     sk_sp<SkImage> readImage();
+    // Skips an image, checking only its bounds and length.
+    void skipImage();
     sk_sp<SkTypeface> readTypeface();
 
+    // If the buffer reads from memory inside data, readImage() shares the encoded bytes with
+    // data instead of copying them.
+    void setBackingData(sk_sp<SkData> data) { fBackingData = std::move(data); }
+
     void setTypefaceArray(sk_sp<SkTypeface> array[], int count) {
         fTFArray = array;
         fTFCount = count;
@@ -197,8 +205,10 @@ private:
     void setInvalid();
     bool readArray(void* value, size_t size, size_t elementSize);
     void setMemory(const void*, size_t);
+    bool readImageHeader(SkIRect* bounds, int32_t* size);
 
     SkReader32 fReader;
+    sk_sp<SkData> fBackingData;
 
     // Only used if we do not have an fFactoryArray.
     SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
@@ -262,6 +272,7 @@ public:
     void readRegion (SkRegion*  out) { *out = SkRegion();         }
     void readString (SkString*  out) { *out = SkString();         }
     void readPath   (SkPath*    out) { *out = SkPath();           }
+    void skipPath   ()               {}
     SkReadPaintResult readPaint  (SkPaint*   out, SkFont* font) {
         *out = SkPaint();
         if (font) {
@@ -294,6 +305,7 @@ public:
     uint32_t getArrayCount() { return 0; }
 
     sk_sp<SkImage>    readImage()    { return nullptr; }
+    void              skipImage()    {}
     sk_sp<SkTypeface> readTypeface() { return nullptr; }
 
     bool validate(bool)                                 { return false; }
@@ -309,6 +321,7 @@ public:
     void setTypefaceArray(sk_sp<SkTypeface>[], int)        {}
     void setFactoryPlayback(SkFlattenable::Factory[], int) {}
     void setDeserialProcs(const SkDeserialProcs&)          {}
+    void setBackingData(sk_sp<SkData>)                     {}
 
     const SkDeserialProcs& getDeserialProcs() const {
         static const SkDeserialProcs procs;
@@ -0,0 +1,1828 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRecordSerialize.h"
+
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/SkFloatBits.h"
+#include "include/private/SkFloatingPoint.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkMathPriv.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPictureFlat.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkPtrRecorder.h"
+#include "src/core/SkRTree.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkTextBlobPriv.h"
+#include "src/core/SkWriteBuffer.h"
+#include "src/utils/SkPatchUtils.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace SkRecords;
+
+// The data after the SkPictInfo and its trailing byte is padding, so that what follows is four
+// byte aligned when the picture is, then a size, then that many bytes read with SkReadBuffer:
+//   version
+//   typeface count, then for each typeface its size and bytes (negative for SkSerialProcs data)
+//   paints, flattened as in SkPictureData
+//   paths, as one byte array of the encoding in write_path()
+//   images, text blobs, vertices, regions and backdrop image filters, flattened
+//   pictures: each either a cull rect and its commands as one byte array, or, for sub-pictures
+//   written with SkSerialProcs::fPictureProc, flattened with SkPicturePriv::Flatten()
+// The last picture is the one serialized; the others are its sub-pictures, each written before
+// any picture that draws it. Commands start with their SkRecords::Type.
+static constexpr uint32_t kVersion = 2;
+
+static constexpr size_t kPaddingSize = SkAlign4(sizeof(SkPictInfo) + 1) - (sizeof(SkPictInfo) + 1);
+
+// The types are written as their values, so reordering or removing any needs a new kVersion.
+static_assert(DrawEdgeAAImageSet_Type == 38, "Update kVersion when changing SK_RECORD_TYPES.");
+
+enum PictureKind : uint32_t {
+    kRecord_PictureKind    = 0,
+    kFlattened_PictureKind = 1,
+};
+
+namespace {
+
+// Scalars are written as the difference from a predicted scalar, usually the previous coordinate
+// on the same axis. Scalars that are a whole number of sixteenths, below 2^20 in magnitude, are
+// written as the difference in sixteenths, shifted left one bit. Others are written as the
+// difference of their bits, shifted left with the low bit set; nearby floats with the same
+// exponent have nearby bits.
+static constexpr int kScalarFracBits = 4;
+static constexpr int32_t kMaxNumerator = 1 << 24;
+
+static bool to_numerator(SkScalar v, int32_t* numerator) {
+    const float scaled = v * (1 << kScalarFracBits);
+    if (!(std::abs(scaled) < kMaxNumerator)) {
+        return false;
+    }
+    const int32_t n = (int32_t)scaled;
+    if ((float)n != scaled || (n == 0 && std::signbit(v))) {
+        return false;
+    }
+    *numerator = n;
+    return true;
+}
+
+static int32_t nearest_numerator(SkScalar pred) {
+    const float scaled = pred * (1 << kScalarFracBits);
+    return std::abs(scaled) < kMaxNumerator ? sk_float_round2int(scaled) : 0;
+}
+
+static uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+static int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+class ByteWriter {
+public:
+    void writeVarint(uint64_t v) {
+        while (v >= 0x80) {
+            *fBytes.append() = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        *fBytes.append() = (uint8_t)v;
+    }
+
+    void writeSigned(int64_t v) { this->writeVarint(zigzag(v)); }
+
+    void writeBytes(const void* bytes, size_t size) {
+        memcpy(fBytes.append(SkToInt(size)), bytes, size);
+    }
+
+    void write32(uint32_t v) { this->writeBytes(&v, sizeof(v)); }
+
+    void writeScalar(SkScalar v, SkScalar* pred) {
+        int32_t n;
+        if (to_numerator(v, &n)) {
+            this->writeVarint(zigzag((int64_t)n - nearest_numerator(*pred)) << 1);
+        } else {
+            const uint32_t delta = (uint32_t)SkFloat2Bits(v) - (uint32_t)SkFloat2Bits(*pred);
+            this->writeVarint((zigzag((int32_t)delta) << 1) | 1);
+        }
+        *pred = v;
+    }
+
+    void writeScalar(SkScalar v) {
+        SkScalar pred = 0;
+        this->writeScalar(v, &pred);
+    }
+
+    void writePoint(const SkPoint& p) {
+        this->writeScalar(p.fX, &fX);
+        this->writeScalar(p.fY, &fY);
+    }
+
+    void writePoints(const SkPoint pts[], int count) {
+        for (int i = 0; i < count; ++i) {
+            this->writePoint(pts[i]);
+        }
+    }
+
+    // The right and bottom edges are predicted from the left and top.
+    void writeRect(const SkRect& r) {
+        this->writeScalar(r.fLeft, &fX);
+        this->writeScalar(r.fTop, &fY);
+        SkScalar x = fX,
+                 y = fY;
+        this->writeScalar(r.fRight, &x);
+        this->writeScalar(r.fBottom, &y);
+    }
+
+    void writeIRect(const SkIRect& r) {
+        this->writeSigned(r.fLeft);
+        this->writeSigned(r.fTop);
+        this->writeSigned((int64_t)r.fRight - r.fLeft);
+        this->writeSigned((int64_t)r.fBottom - r.fTop);
+    }
+
+    // Empty and rect types are written as their rect; the others with their four radii too.
+    void writeRRect(const SkRRect& rrect) {
+        this->writeRect(rrect.rect());
+        const bool hasRadii = rrect.getType() > SkRRect::kRect_Type;
+        this->writeVarint(hasRadii);
+        if (hasRadii) {
+            SkScalar x = 0,
+                     y = 0;
+            for (int i = 0; i < 4; ++i) {
+                const SkVector radii = rrect.radii((SkRRect::Corner)i);
+                this->writeScalar(radii.fX, &x);
+                this->writeScalar(radii.fY, &y);
+            }
+        }
+    }
+
+    // Only the entries a matrix's type says it may use are written.
+    void writeMatrix(const SkMatrix& m) {
+        const unsigned type = m.getType() & (SkMatrix::kTranslate_Mask | SkMatrix::kScale_Mask |
+                                             SkMatrix::kAffine_Mask | SkMatrix::kPerspective_Mask);
+        this->writeVarint(type);
+        if (type & SkMatrix::kPerspective_Mask) {
+            for (int i = 0; i < 9; ++i) {
+                this->writeScalar(m[i]);
+            }
+            return;
+        }
+        if (type & (SkMatrix::kScale_Mask | SkMatrix::kAffine_Mask)) {
+            this->writeScalar(m.getScaleX());
+            this->writeScalar(m.getScaleY());
+        }
+        if (type & SkMatrix::kAffine_Mask) {
+            this->writeScalar(m.getSkewX());
+            this->writeScalar(m.getSkewY());
+        }
+        if (type & SkMatrix::kTranslate_Mask) {
+            this->writeScalar(m.getTranslateX());
+            this->writeScalar(m.getTranslateY());
+        }
+    }
+
+    void writeString(const SkString& s) {
+        this->writeVarint(s.size());
+        this->writeBytes(s.c_str(), s.size());
+    }
+
+    const uint8_t* bytes() const { return fBytes.begin(); }
+    size_t size() const { return fBytes.count(); }
+
+private:
+    SkTDArray<uint8_t> fBytes;
+    SkScalar           fX = 0,  // The last x and y coordinates written.
+                       fY = 0;
+};
+
+// Reads what ByteWriter writes. After the first error, all reads return zeros.
+class ByteReader {
+public:
+    ByteReader(const void* data, size_t size)
+        : fCurr(static_cast<const uint8_t*>(data))
+        , fStop(fCurr + size) {}
+
+    bool isValid() const { return fValid; }
+    bool done() const { return fCurr == fStop; }
+    size_t remaining() const { return fStop - fCurr; }
+
+    bool validate(bool valid) {
+        if (!valid) {
+            fValid = false;
+            fCurr = fStop;
+        }
+        return fValid;
+    }
+
+    uint64_t readVarint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64 && fCurr < fStop; shift += 7) {
+            const uint8_t byte = *fCurr++;
+            v |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return v;
+            }
+        }
+        this->validate(false);
+        return 0;
+    }
+
+    int64_t readSigned() { return unzigzag(this->readVarint()); }
+
+    int32_t readInt() {
+        const int64_t v = this->readSigned();
+        return this->validate(SkTFitsIn<int32_t>(v)) ? (int32_t)v : 0;
+    }
+
+    uint32_t readUInt(uint32_t max = UINT32_MAX) {
+        const uint64_t v = this->readVarint();
+        return this->validate(v <= max) ? (uint32_t)v : 0;
+    }
+
+    bool readBool() { return this->readUInt(1) != 0; }
+
+    template <typename T>
+    T readEnum(T max) {
+        return (T)this->readUInt((uint32_t)max);
+    }
+
+    // Reads a count of things that each take at least minSize bytes, so that the count is
+    // bounded by the size of the data.
+    int readCount(size_t minSize) {
+        const uint64_t count = this->readVarint();
+        return this->validate(count <= this->remaining() / minSize) ? (int)count : 0;
+    }
+
+    // Returns an index less than count.
+    int readIndex(int count) {
+        const uint64_t index = this->readVarint();
+        return this->validate(index < (uint64_t)count) ? (int)index : 0;
+    }
+
+    const void* skip(size_t size) {
+        if (!this->validate(size <= this->remaining())) {
+            return nullptr;
+        }
+        const void* bytes = fCurr;
+        fCurr += size;
+        return bytes;
+    }
+
+    uint32_t read32() {
+        uint32_t v = 0;
+        if (const void* bytes = this->skip(sizeof(v))) {
+            memcpy(&v, bytes, sizeof(v));
+        }
+        return v;
+    }
+
+    SkScalar readScalar(SkScalar* pred) {
+        const uint64_t v = this->readVarint();
+        const int64_t delta = unzigzag(v >> 1);
+        if (v & 1) {
+            if (!this->validate(SkTFitsIn<int32_t>(delta))) {
+                return 0;
+            }
+            *pred = SkBits2Float((int32_t)((uint32_t)SkFloat2Bits(*pred) + (uint32_t)delta));
+        } else {
+            const int64_t n = nearest_numerator(*pred) + delta;
+            if (!this->validate(-kMaxNumerator < n && n < kMaxNumerator)) {
+                return 0;
+            }
+            *pred = (SkScalar)n / (1 << kScalarFracBits);
+        }
+        return *pred;
+    }
+
+    SkScalar readScalar() {
+        SkScalar pred = 0;
+        return this->readScalar(&pred);
+    }
+
+    SkPoint readPoint() {
+        const SkScalar x = this->readScalar(&fX);
+        return {x, this->readScalar(&fY)};
+    }
+
+    void readPoints(SkPoint pts[], int count) {
+        for (int i = 0; i < count; ++i) {
+            pts[i] = this->readPoint();
+        }
+    }
+
+    SkRect readRect() {
+        SkRect r;
+        r.fLeft = this->readScalar(&fX);
+        r.fTop  = this->readScalar(&fY);
+        SkScalar x = fX,
+                 y = fY;
+        r.fRight  = this->readScalar(&x);
+        r.fBottom = this->readScalar(&y);
+        return r;
+    }
+
+    // Reads an int written as its difference from base.
+    int32_t readOffset(int32_t base) {
+        const int64_t delta = this->readSigned();
+        // Any two int32_ts are less than 2^32 apart, so larger deltas are bad, and would
+        // overflow the sum.
+        if (!this->validate(-(int64_t)UINT32_MAX <= delta && delta <= (int64_t)UINT32_MAX &&
+                            SkTFitsIn<int32_t>(base + delta))) {
+            return 0;
+        }
+        return (int32_t)(base + delta);
+    }
+
+    SkIRect readIRect() {
+        const int32_t l = this->readInt(),
+                      t = this->readInt(),
+                      r = this->readOffset(l),
+                      b = this->readOffset(t);
+        if (!this->isValid()) {
+            return SkIRect::MakeEmpty();
+        }
+        return SkIRect::MakeLTRB(l, t, r, b);
+    }
+
+    SkRRect readRRect() {
+        const SkRect rect = this->readRect();
+        SkRRect rrect;
+        if (this->readBool()) {
+            SkVector radii[4];
+            SkScalar x = 0,
+                     y = 0;
+            for (SkVector& r : radii) {
+                r.fX = this->readScalar(&x);
+                r.fY = this->readScalar(&y);
+            }
+            rrect.setRectRadii(rect, radii);
+        } else {
+            rrect.setRect(rect);
+        }
+        return rrect;
+    }
+
+    SkMatrix readMatrix() {
+        const unsigned type = this->readUInt(SkMatrix::kTranslate_Mask | SkMatrix::kScale_Mask |
+                                             SkMatrix::kAffine_Mask | SkMatrix::kPerspective_Mask);
+        SkMatrix m;
+        if (type & SkMatrix::kPerspective_Mask) {
+            SkScalar v[9];
+            for (SkScalar& s : v) {
+                s = this->readScalar();
+            }
+            m.set9(v);
+            return m;
+        }
+        SkScalar sx = 1, sy = 1, kx = 0, ky = 0, tx = 0, ty = 0;
+        if (type & (SkMatrix::kScale_Mask | SkMatrix::kAffine_Mask)) {
+            sx = this->readScalar();
+            sy = this->readScalar();
+        }
+        if (type & SkMatrix::kAffine_Mask) {
+            kx = this->readScalar();
+            ky = this->readScalar();
+        }
+        if (type & SkMatrix::kTranslate_Mask) {
+            tx = this->readScalar();
+            ty = this->readScalar();
+        }
+        m.setAll(sx, kx, tx,
+                 ky, sy, ty,
+                  0,  0,  1);
+        return m;
+    }
+
+    SkString readString() {
+        const size_t size = this->readCount(1);
+        const void* bytes = this->skip(size);
+        return bytes ? SkString(static_cast<const char*>(bytes), size) : SkString();
+    }
+
+private:
+    const uint8_t* fCurr;
+    const uint8_t* fStop;
+    bool           fValid = true;
+    SkScalar       fX = 0,
+                   fY = 0;
+};
+
+// Paths start with their fill type in bits 0-1, whether they are volatile in bit 2, and
+// whether they follow as SkPath::writeToMemory() data in bit 3. That is used for ovals and round
+// rects, so they can still be drawn as such. Other paths follow as their verbs, then their conic
+// weights, then their points. If bit 4 is set, the weights and points are raw floats, which read
+// faster than the bit differences of scalars that are not whole sixteenths; paths use them
+// unless all their points are whole sixteenths.
+enum PathFlags {
+    kVolatile_PathFlag  = 1 << 2,
+    kMemory_PathFlag    = 1 << 3,
+    kRawPoints_PathFlag = 1 << 4,
+};
+
+static bool all_sixteenths(const SkPoint pts[], int count) {
+    int32_t n;
+    for (int i = 0; i < count; ++i) {
+        if (!to_numerator(pts[i].fX, &n) || !to_numerator(pts[i].fY, &n)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void write_path(const SkPath& path, ByteWriter* out) {
+    uint32_t flags = (uint32_t)path.getFillType();
+    if (path.isVolatile()) {
+        flags |= kVolatile_PathFlag;
+    }
+    if (path.isOval(nullptr) || path.isRRect(nullptr)) {
+        out->writeVarint(flags | kMemory_PathFlag);
+        const size_t size = path.writeToMemory(nullptr);
+        SkAutoSMalloc<128> storage(size);
+        path.writeToMemory(storage.get());
+        out->writeVarint(size);
+        out->writeBytes(storage.get(), size);
+        return;
+    }
+
+    const int pointCount = path.countPoints();
+    const SkPoint* pts = SkPathPriv::PointData(path);
+    const int weightCount = SkPathPriv::ConicWeightCnt(path);
+    const SkScalar* weights = SkPathPriv::ConicWeightData(path);
+    const bool raw = !all_sixteenths(pts, pointCount);
+    out->writeVarint(raw ? flags | kRawPoints_PathFlag : flags);
+
+    const int verbCount = path.countVerbs();
+    out->writeVarint(verbCount);
+    out->writeBytes(SkPathPriv::VerbData(path), verbCount);
+
+    if (raw) {
+        out->writeBytes(weights, weightCount * sizeof(SkScalar));
+        out->writeBytes(pts, pointCount * sizeof(SkPoint));
+    } else {
+        for (int i = 0; i < weightCount; ++i) {
+            out->writeScalar(weights[i]);
+        }
+        out->writePoints(pts, pointCount);
+    }
+}
+
+// Adds the verbs to path one by one, for verbs SkPathPriv::ResetToVerbs() does not take.
+static void add_verbs(const uint8_t verbs[], int verbCount,
+                      const SkPoint pts[], const SkScalar weights[], SkPath* path) {
+    path->incReserve(verbCount);
+    for (int i = 0; i < verbCount; ++i) {
+        switch (verbs[i]) {
+            case SkPath::kMove_Verb:  path->moveTo(pts[0]);                  pts += 1; break;
+            case SkPath::kLine_Verb:  path->lineTo(pts[0]);                  pts += 1; break;
+            case SkPath::kQuad_Verb:  path->quadTo(pts[0], pts[1]);          pts += 2; break;
+            case SkPath::kConic_Verb: path->conicTo(pts[0], pts[1], *weights++);
+                                                                             pts += 2; break;
+            case SkPath::kCubic_Verb: path->cubicTo(pts[0], pts[1], pts[2]); pts += 3; break;
+            case SkPath::kClose_Verb: path->close();                                   break;
+            default: SkASSERT(false);                                                  break;
+        }
+    }
+}
+
+static bool read_path(ByteReader* in, SkPath* path) {
+    const uint32_t flags =
+            in->readUInt(3 | kVolatile_PathFlag | kMemory_PathFlag | kRawPoints_PathFlag);
+    if (flags & kMemory_PathFlag) {
+        const size_t size = in->readCount(1);
+        const void* bytes = in->skip(size);
+        if (!bytes) {
+            return false;
+        }
+        // SkPath reads its points in place, so give it aligned memory.
+        SkAutoSMalloc<128> storage(size);
+        memcpy(storage.get(), bytes, size);
+        if (!path->readFromMemory(storage.get(), size)) {
+            return in->validate(false);
+        }
+    } else {
+        const int verbCount = in->readCount(1);
+        const uint8_t* verbs = static_cast<const uint8_t*>(in->skip(verbCount));
+        int pointCount = 0,
+            weightCount = 0;
+        for (int i = 0; i < verbCount; ++i) {
+            switch (verbs[i]) {
+                case SkPath::kMove_Verb:
+                case SkPath::kLine_Verb:  pointCount += 1;                   break;
+                case SkPath::kQuad_Verb:  pointCount += 2;                   break;
+                case SkPath::kConic_Verb: pointCount += 2; weightCount += 1; break;
+                case SkPath::kCubic_Verb: pointCount += 3;                   break;
+                case SkPath::kClose_Verb:                                    break;
+                default: return in->validate(false);
+            }
+        }
+        // Raw points take eight bytes each, and others at least two.
+        const bool raw = flags & kRawPoints_PathFlag;
+        if (!in->validate((size_t)pointCount <= in->remaining() / (raw ? sizeof(SkPoint) : 2))) {
+            return false;
+        }
+
+        SkAutoSTMalloc<8, SkScalar> weights(weightCount);
+        bool weightsKept = true;
+        if (raw) {
+            const void* bytes = in->skip(weightCount * sizeof(SkScalar));
+            if (!bytes) {
+                return false;
+            }
+            sk_careful_memcpy(weights.get(), bytes, weightCount * sizeof(SkScalar));
+        }
+        for (int i = 0; i < weightCount; ++i) {
+            const SkScalar w = raw ? weights[i] : (weights[i] = in->readScalar());
+            weightsKept &= SkScalarIsFinite(w) && w > 0 && w != 1;
+        }
+
+        // Paths written from SkPath's methods take their points in place. Anything else is added
+        // verb by verb, as SkPath would have.
+        SkPoint* pts;
+        SkScalar* pathWeights;
+        SkAutoTMalloc<SkPoint> verbPts;
+        const bool inPlace = in->isValid() && weightsKept &&
+                             SkPathPriv::ResetToVerbs(path, verbs, verbCount,
+                                                      pointCount, weightCount,
+                                                      &pts, &pathWeights);
+        if (!inPlace) {
+            pts = verbPts.reset(pointCount);
+        }
+        if (raw) {
+            const void* bytes = in->skip(pointCount * sizeof(SkPoint));
+            if (bytes) {
+                sk_careful_memcpy(pts, bytes, pointCount * sizeof(SkPoint));
+            }
+        } else {
+            for (int i = 0; i < pointCount; ++i) {
+                pts[i] = in->readPoint();
+            }
+        }
+        if (!in->isValid()) {
+            path->reset();
+            return false;
+        }
+        if (inPlace) {
+            sk_careful_memcpy(pathWeights, weights.get(), weightCount * sizeof(SkScalar));
+        } else {
+            add_verbs(verbs, verbCount, pts, weights.get(), path);
+        }
+    }
+    path->setFillType((SkPathFillType)(flags & 3));
+    path->setIsVolatile(flags & kVolatile_PathFlag);
+    return in->isValid();
+}
+
+struct PaintHash {
+    uint32_t operator()(const SkPaint& paint) const { return paint.getHash(); }
+};
+
+// Collects the objects used by a picture and its sub-pictures into shared tables, and writes
+// each picture's commands.
+class Writer {
+public:
+    explicit Writer(const SkSerialProcs& procs) : fProcs(procs) {}
+
+    // Returns the index of picture in fPictures, after writing it and its sub-pictures if needed.
+    int addPicture(const SkPicture*, bool isSubPicture);
+
+    void write(SkWStream*);
+
+private:
+    struct Picture {
+        SkRect                 fCull;
+        ByteWriter             fOps;
+        sk_sp<const SkPicture> fFlattened;  // Set instead of fOps for kFlattened_PictureKind.
+    };
+
+    class OpWriter;
+    void writeOps(const SkRecord&, SkPicture const* const drawablePicts[], ByteWriter*);
+
+    int addPaint(const SkPaint& paint) {
+        if (int* index = fPaintIndices.find(paint)) {
+            return *index;
+        }
+        fPaints.push_back(paint);
+        return *fPaintIndices.set(paint, fPaints.count() - 1);
+    }
+
+    int addPath(const SkPath& path) {
+        // Except on Android, the gen ID doesn't change with the fill type or volatility, and
+        // write_path() writes both.
+        const uint64_t key = (uint64_t)path.getGenerationID() << 3 |
+                             (uint64_t)path.getFillType() |
+                             (path.isVolatile() ? kVolatile_PathFlag : 0);
+        if (int* index = fPathIndices.find(key)) {
+            return *index;
+        }
+        write_path(path, &fPaths);
+        return *fPathIndices.set(key, fPathCount++);
+    }
+
+    template <typename T>
+    static int AddByID(const T* obj, SkTArray<sk_sp<const T>>* objs,
+                       SkTHashMap<uint32_t, int>* indices) {
+        if (int* index = indices->find(obj->uniqueID())) {
+            return *index;
+        }
+        objs->push_back(sk_ref_sp(obj));
+        return *indices->set(obj->uniqueID(), objs->count() - 1);
+    }
+
+    int addImage(const SkImage* image) { return AddByID(image, &fImages, &fImageIndices); }
+    int addTextBlob(const SkTextBlob* blob) { return AddByID(blob, &fBlobs, &fBlobIndices); }
+    int addVertices(const SkVertices* v) { return AddByID(v, &fVertices, &fVerticesIndices); }
+
+    int addRegion(const SkRegion& region) {
+        fRegions.push_back(region);
+        return fRegions.count() - 1;
+    }
+
+    int addImageFilter(const SkImageFilter* filter) {
+        fImageFilters.push_back(sk_ref_sp(filter));
+        return fImageFilters.count() - 1;
+    }
+
+    const SkSerialProcs fProcs;
+
+    SkTArray<SkPaint>                     fPaints;
+    SkTHashMap<SkPaint, int, PaintHash>   fPaintIndices;
+    ByteWriter                            fPaths;
+    int                                   fPathCount = 0;
+    SkTHashMap<uint64_t, int>             fPathIndices;
+    SkTArray<sk_sp<const SkImage>>        fImages;
+    SkTHashMap<uint32_t, int>             fImageIndices;
+    SkTArray<sk_sp<const SkTextBlob>>     fBlobs;
+    SkTHashMap<uint32_t, int>             fBlobIndices;
+    SkTArray<sk_sp<const SkVertices>>     fVertices;
+    SkTHashMap<uint32_t, int>             fVerticesIndices;
+    SkTArray<SkRegion>                    fRegions;
+    SkTArray<sk_sp<const SkImageFilter>>  fImageFilters;
+    std::vector<Picture>                  fPictures;
+    SkTHashMap<uint32_t, int>             fPictureIndices;
+};
+
+class Writer::OpWriter {
+public:
+    OpWriter(Writer* writer, SkPicture const* const drawablePicts[], ByteWriter* out)
+        : fWriter(writer), fDrawablePicts(drawablePicts), fOut(out) {}
+
+    template <typename T>
+    void operator()(const T& op) {
+        fOut->writeVarint(T::kType);
+        this->write(op);
+    }
+
+    void operator()(const NoOp&) {}
+
+    // Drawables are drawn as the pictures they were snapshotted to, as SkRecordDraw() does.
+    void operator()(const DrawDrawable& op) {
+        fOut->writeVarint(DrawPicture_Type);
+        fOut->writeVarint(0);
+        fOut->writeVarint(fWriter->addPicture(fDrawablePicts[op.index], true));
+        fOut->writeMatrix(op.matrix ? *op.matrix : SkMatrix::I());
+    }
+
+private:
+    void writePaint(const SkPaint& paint) { fOut->writeVarint(fWriter->addPaint(paint)); }
+
+    // Optional paints are written as their index plus one, or zero.
+    void writePaint(const SkPaint* paint) {
+        fOut->writeVarint(paint ? fWriter->addPaint(*paint) + 1 : 0);
+    }
+
+    void writeImage(const SkImage* image) { fOut->writeVarint(fWriter->addImage(image)); }
+    void writePath(const SkPath& path) { fOut->writeVarint(fWriter->addPath(path)); }
+
+    void writeClipOp(ClipOpAndAA opAA) {
+        fOut->writeVarint(((unsigned)opAA.op() << 1) | opAA.aa());
+    }
+
+    void writeColors(const SkColor colors[], int count) {
+        fOut->writeVarint(colors != nullptr);
+        for (int i = 0; colors && i < count; ++i) {
+            fOut->write32(colors[i]);
+        }
+    }
+
+    void write(const Flush&) {}
+    void write(const Save&) {}
+    void write(const Restore& op) { fOut->writeMatrix(op.matrix); }
+
+    void write(const SaveLayer& op) {
+        fOut->writeVarint((op.bounds     ? 1 : 0) |
+                          (op.backdrop   ? 2 : 0) |
+                          (op.clipMask   ? 4 : 0) |
+                          (op.clipMatrix ? 8 : 0));
+        fOut->writeVarint(op.saveLayerFlags);
+        if (op.bounds) {
+            fOut->writeRect(*op.bounds);
+        }
+        this->writePaint(op.paint);
+        if (op.backdrop) {
+            fOut->writeVarint(fWriter->addImageFilter(op.backdrop.get()));
+        }
+        if (op.clipMask) {
+            this->writeImage(op.clipMask.get());
+        }
+        if (op.clipMatrix) {
+            fOut->writeMatrix(*op.clipMatrix);
+        }
+    }
+
+    void write(const SaveBehind& op) {
+        fOut->writeVarint(op.subset != nullptr);
+        if (op.subset) {
+            fOut->writeRect(*op.subset);
+        }
+    }
+
+    void write(const SetMatrix& op) { fOut->writeMatrix(op.matrix); }
+    void write(const Concat& op) { fOut->writeMatrix(op.matrix); }
+
+    void write(const Concat44& op) {
+        SkScalar m[16];
+        op.matrix.getColMajor(m);
+        for (SkScalar v : m) {
+            fOut->writeScalar(v);
+        }
+    }
+
+    void write(const Translate& op) {
+        fOut->writeScalar(op.dx);
+        fOut->writeScalar(op.dy);
+    }
+
+    void write(const Scale& op) {
+        fOut->writeScalar(op.sx);
+        fOut->writeScalar(op.sy);
+    }
+
+    void write(const ClipPath& op) {
+        this->writePath(op.path);
+        this->writeClipOp(op.opAA);
+    }
+
+    void write(const ClipRRect& op) {
+        fOut->writeRRect(op.rrect);
+        this->writeClipOp(op.opAA);
+    }
+
+    void write(const ClipRect& op) {
+        fOut->writeRect(op.rect);
+        this->writeClipOp(op.opAA);
+    }
+
+    void write(const ClipRegion& op) {
+        fOut->writeVarint(fWriter->addRegion(op.region));
+        fOut->writeVarint((unsigned)op.op);
+    }
+
+    void write(const DrawArc& op) {
+        this->writePaint(op.paint);
+        fOut->writeRect(op.oval);
+        fOut->writeScalar(op.startAngle);
+        fOut->writeScalar(op.sweepAngle);
+        fOut->writeVarint(op.useCenter != 0);
+    }
+
+    void write(const DrawDRRect& op) {
+        this->writePaint(op.paint);
+        fOut->writeRRect(op.outer);
+        fOut->writeRRect(op.inner);
+    }
+
+    void write(const DrawImage& op) {
+        this->writePaint(op.paint);
+        this->writeImage(op.image.get());
+        fOut->writePoint({op.left, op.top});
+    }
+
+    void write(const DrawImageLattice& op) {
+        this->writePaint(op.paint);
+        this->writeImage(op.image.get());
+        fOut->writeVarint(op.xCount);
+        for (int i = 0; i < op.xCount; ++i) {
+            fOut->writeSigned((int64_t)op.xDivs[i] - (i ? op.xDivs[i - 1] : 0));
+        }
+        fOut->writeVarint(op.yCount);
+        for (int i = 0; i < op.yCount; ++i) {
+            fOut->writeSigned((int64_t)op.yDivs[i] - (i ? op.yDivs[i - 1] : 0));
+        }
+        fOut->writeVarint(op.flagCount);
+        if (op.flagCount) {
+            fOut->writeBytes(op.flags, op.flagCount);
+            this->writeColors(op.colors, op.flagCount);
+        }
+        fOut->writeIRect(op.src);
+        fOut->writeRect(op.dst);
+    }
+
+    void write(const DrawImageRect& op) {
+        this->writePaint(op.paint);
+        this->writeImage(op.image.get());
+        fOut->writeVarint(op.src != nullptr);
+        if (op.src) {
+            fOut->writeRect(*op.src);
+        }
+        fOut->writeRect(op.dst);
+        fOut->writeVarint(op.constraint);
+    }
+
+    void write(const DrawImageNine& op) {
+        this->writePaint(op.paint);
+        this->writeImage(op.image.get());
+        fOut->writeIRect(op.center);
+        fOut->writeRect(op.dst);
+    }
+
+    void write(const DrawOval& op) {
+        this->writePaint(op.paint);
+        fOut->writeRect(op.oval);
+    }
+
+    void write(const DrawPaint& op) { this->writePaint(op.paint); }
+    void write(const DrawBehind& op) { this->writePaint(op.paint); }
+
+    void write(const DrawPath& op) {
+        this->writePaint(op.paint);
+        this->writePath(op.path);
+    }
+
+    void write(const DrawPatch& op) {
+        this->writePaint(op.paint);
+        fOut->writePoints(op.cubics, SkPatchUtils::kNumCtrlPts);
+        this->writeColors(op.colors, SkPatchUtils::kNumCorners);
+        fOut->writeVarint(op.texCoords != nullptr);
+        if (op.texCoords) {
+            fOut->writePoints(op.texCoords, SkPatchUtils::kNumCorners);
+        }
+        fOut->writeVarint((unsigned)op.bmode);
+    }
+
+    void write(const DrawPicture& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(fWriter->addPicture(op.picture.get(), true));
+        fOut->writeMatrix(op.matrix);
+    }
+
+    void write(const DrawPoints& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(op.mode);
+        fOut->writeVarint(op.count);
+        fOut->writePoints(op.pts, op.count);
+    }
+
+    void write(const DrawRRect& op) {
+        this->writePaint(op.paint);
+        fOut->writeRRect(op.rrect);
+    }
+
+    void write(const DrawRect& op) {
+        this->writePaint(op.paint);
+        fOut->writeRect(op.rect);
+    }
+
+    void write(const DrawRegion& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(fWriter->addRegion(op.region));
+    }
+
+    void write(const DrawTextBlob& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(fWriter->addTextBlob(op.blob.get()));
+        fOut->writePoint({op.x, op.y});
+    }
+
+    void write(const DrawAtlas& op) {
+        this->writePaint(op.paint);
+        this->writeImage(op.atlas.get());
+        fOut->writeVarint(op.count);
+        for (int i = 0; i < op.count; ++i) {
+            fOut->writeScalar(op.xforms[i].fSCos);
+            fOut->writeScalar(op.xforms[i].fSSin);
+            fOut->writePoint({op.xforms[i].fTx, op.xforms[i].fTy});
+            fOut->writeRect(op.texs[i]);
+        }
+        this->writeColors(op.colors, op.count);
+        fOut->writeVarint((unsigned)op.mode);
+        fOut->writeVarint(op.cull != nullptr);
+        if (op.cull) {
+            fOut->writeRect(*op.cull);
+        }
+    }
+
+    void write(const DrawVertices& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(fWriter->addVertices(op.vertices.get()));
+        fOut->writeVarint(op.boneCount);
+        for (int i = 0; i < op.boneCount; ++i) {
+            for (SkScalar v : op.bones[i].values) {
+                fOut->writeScalar(v);
+            }
+        }
+        fOut->writeVarint((unsigned)op.bmode);
+    }
+
+    void write(const DrawShadowRec& op) {
+        this->writePath(op.path);
+        const SkDrawShadowRec& rec = op.rec;
+        for (SkScalar v : {rec.fZPlaneParams.fX, rec.fZPlaneParams.fY, rec.fZPlaneParams.fZ,
+                           rec.fLightPos.fX, rec.fLightPos.fY, rec.fLightPos.fZ,
+                           rec.fLightRadius}) {
+            fOut->writeScalar(v);
+        }
+        fOut->write32(rec.fAmbientColor);
+        fOut->write32(rec.fSpotColor);
+        fOut->writeVarint(rec.fFlags);
+    }
+
+    // Values are written as their size plus one, or zero.
+    void write(const DrawAnnotation& op) {
+        fOut->writeRect(op.rect);
+        fOut->writeString(op.key);
+        fOut->writeVarint(op.value ? op.value->size() + 1 : 0);
+        if (op.value) {
+            fOut->writeBytes(op.value->data(), op.value->size());
+        }
+    }
+
+    void write(const DrawEdgeAAQuad& op) {
+        fOut->writeRect(op.rect);
+        fOut->writeVarint(op.clip != nullptr);
+        if (op.clip) {
+            fOut->writePoints(op.clip, 4);
+        }
+        fOut->writeVarint(op.aa);
+        for (int i = 0; i < 4; ++i) {
+            fOut->writeScalar(op.color[i]);
+        }
+        fOut->writeVarint((unsigned)op.mode);
+    }
+
+    // The numbers of clip points and matrices follow from the entries.
+    void write(const DrawEdgeAAImageSet& op) {
+        this->writePaint(op.paint);
+        fOut->writeVarint(op.count);
+        for (int i = 0; i < op.count; ++i) {
+            const SkCanvas::ImageSetEntry& entry = op.set[i];
+            this->writeImage(entry.fImage.get());
+            fOut->writeRect(entry.fSrcRect);
+            fOut->writeRect(entry.fDstRect);
+            fOut->writeSigned(entry.fMatrixIndex);
+            fOut->writeScalar(entry.fAlpha);
+            fOut->writeVarint((entry.fAAFlags << 1) | entry.fHasClip);
+        }
+        int clipCount, matrixCount;
+        SkCanvasPriv::GetDstClipAndMatrixCounts(op.set.get(), op.count, &clipCount, &matrixCount);
+        fOut->writePoints(op.dstClips, clipCount);
+        for (int i = 0; i < matrixCount; ++i) {
+            fOut->writeMatrix(op.preViewMatrices[i]);
+        }
+        fOut->writeVarint(op.constraint);
+    }
+
+    Writer*                 fWriter;
+    SkPicture const* const* fDrawablePicts;
+    ByteWriter*             fOut;
+};
+
+void Writer::writeOps(const SkRecord& record, SkPicture const* const drawablePicts[],
+                      ByteWriter* out) {
+    OpWriter writer(this, drawablePicts, out);
+    for (int i = 0; i < record.count(); ++i) {
+        record.visit(i, writer);
+    }
+}
+
+int Writer::addPicture(const SkPicture* picture, bool isSubPicture) {
+    if (int* index = fPictureIndices.find(picture->uniqueID())) {
+        return *index;
+    }
+
+    Picture entry;
+    entry.fCull = picture->cullRect();
+    if (isSubPicture && fProcs.fPictureProc) {
+        // Let fPictureProc see each sub-picture, as SkPictureData::serialize() does.
+        entry.fFlattened = sk_ref_sp(picture);
+    } else if (auto big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture))) {
+        this->writeOps(*big->record(), big->drawablePicts(), &entry.fOps);
+    } else {
+        SkRecord record;
+        SkRecorder recorder(&record, entry.fCull);
+        picture->playback(&recorder);
+        recorder.restoreToCount(1);
+        SkDrawableList* drawables = recorder.getDrawableList();
+        std::unique_ptr<SkBigPicture::SnapshotArray> pics(
+                drawables ? drawables->newDrawableSnapshot() : nullptr);
+        this->writeOps(record, pics ? pics->begin() : nullptr, &entry.fOps);
+    }
+
+    fPictures.push_back(std::move(entry));
+    return *fPictureIndices.set(picture->uniqueID(), SkToInt(fPictures.size()) - 1);
+}
+
+void Writer::write(SkWStream* stream) {
+    // Paints and text blobs write typeface indices, and the typefaces are written first.
+    SkSerialProcs procs = fProcs;
+    procs.fTypefaceProc = nullptr;
+    procs.fTypefaceCtx = nullptr;
+    auto typefaceSet = sk_make_sp<SkRefCntSet>();
+
+    SkBinaryWriteBuffer objects;
+    objects.setSerialProcs(procs);
+    objects.setTypefaceRecorder(typefaceSet);
+
+    objects.writeUInt(fPaints.count());
+    for (const SkPaint& paint : fPaints) {
+        objects.writePaint(paint);
+    }
+    objects.writeUInt(fPathCount);
+    objects.writeByteArray(fPaths.bytes(), fPaths.size());
+    objects.writeUInt(fImages.count());
+    for (const auto& image : fImages) {
+        objects.writeImage(image.get());
+    }
+    objects.writeUInt(fBlobs.count());
+    for (const auto& blob : fBlobs) {
+        SkTextBlobPriv::Flatten(*blob, objects);
+    }
+    objects.writeUInt(fVertices.count());
+    for (const auto& vertices : fVertices) {
+        objects.writeDataAsByteArray(vertices->encode().get());
+    }
+    objects.writeUInt(fRegions.count());
+    for (const SkRegion& region : fRegions) {
+        objects.writeRegion(region);
+    }
+    objects.writeUInt(fImageFilters.count());
+    for (const auto& filter : fImageFilters) {
+        objects.writeFlattenable(filter.get());
+    }
+    objects.writeUInt(SkToU32(fPictures.size()));
+    for (const Picture& picture : fPictures) {
+        if (picture.fFlattened) {
+            objects.writeUInt(kFlattened_PictureKind);
+            SkPicturePriv::Flatten(picture.fFlattened, objects);
+        } else {
+            objects.writeUInt(kRecord_PictureKind);
+            objects.writeRect(picture.fCull);
+            objects.writeByteArray(picture.fOps.bytes(), picture.fOps.size());
+        }
+    }
+
+    SkBinaryWriteBuffer header;
+    header.writeUInt(kVersion);
+    const int typefaceCount = typefaceSet->count();
+    SkAutoSTMalloc<16, SkTypeface*> typefaces(typefaceCount);
+    typefaceSet->copyToArray((SkRefCnt**)typefaces.get());
+    header.writeUInt(typefaceCount);
+    for (int i = 0; i < typefaceCount; ++i) {
+        sk_sp<SkData> data;
+        bool custom = false;
+        if (fProcs.fTypefaceProc) {
+            data = fProcs.fTypefaceProc(typefaces[i], fProcs.fTypefaceCtx);
+            custom = data != nullptr;
+        }
+        if (!data) {
+            data = typefaces[i]->serialize();
+        }
+        const int32_t size = SkTFitsIn<int32_t>(data->size()) ? SkToS32(data->size()) : 0;
+        header.writeInt(custom ? -size : size);
+        header.writePad32(data->data(), size);
+    }
+
+    static constexpr char kPadding[4] = {};
+    stream->write(kPadding, kPaddingSize);
+    stream->write32(SkToU32(header.bytesWritten() + objects.bytesWritten()));
+    header.writeToStream(stream);
+    objects.writeToStream(stream);
+}
+
+// Reads the tables written by Writer, then the pictures, appending each picture's commands to an
+// SkRecord. Every command is read and checked before it is appended.
+class Reader {
+public:
+    explicit Reader(SkReadBuffer* buffer) : fBuffer(buffer) {}
+
+    sk_sp<SkPicture> read();
+
+private:
+    bool readTypefaces();
+    sk_sp<SkPicture> readRecordPicture();
+    bool readOp(ByteReader*, SkRecord*, size_t* subPictureBytes, int* saveCount);
+
+    // Reads a count of table entries, each at least four bytes.
+    int readCount() {
+        const uint32_t count = fBuffer->readUInt();
+        return fBuffer->validate(count <= fBuffer->available() / 4) ? (int)count : 0;
+    }
+
+    // The table accessors return null, and leave in invalid, if the index is out of range.
+    template <typename T>
+    static const T* Lookup(ByteReader* in, const SkTArray<T>& table) {
+        const int index = in->readIndex(table.count());
+        return in->isValid() ? &table[index] : nullptr;
+    }
+
+    const SkPaint* readPaint(ByteReader* in) { return Lookup(in, fPaints); }
+
+    // Returns null if there is no paint, as well as if the index is out of range.
+    const SkPaint* readOptionalPaint(ByteReader* in) {
+        const int index = in->readIndex(fPaints.count() + 1);
+        return index ? &fPaints[index - 1] : nullptr;
+    }
+
+    sk_sp<const SkImage> readImage(ByteReader* in) {
+        const auto* image = Lookup(in, fImages);
+        return image ? *image : nullptr;
+    }
+
+    const SkPath* readPath(ByteReader* in) { return Lookup(in, fPaths); }
+
+    template <typename T>
+    static T* Copy(SkRecord* record, const T* src) {
+        return src ? new (record->alloc<T>()) T(*src) : nullptr;
+    }
+
+    template <typename T, typename... Args>
+    static void Append(SkRecord* record, Args&&... args) {
+        new (record->append<T>()) T{std::forward<Args>(args)...};
+    }
+
+    SkReadBuffer*                      fBuffer;
+    SkTypefacePlayback                 fTypefaces;
+    SkTArray<SkPaint>                  fPaints;
+    SkTArray<SkPath>                   fPaths;
+    SkTArray<sk_sp<const SkImage>>     fImages;
+    SkTArray<sk_sp<const SkTextBlob>>  fBlobs;
+    SkTArray<sk_sp<SkVertices>>        fVertices;
+    SkTArray<SkRegion>                 fRegions;
+    SkTArray<sk_sp<SkImageFilter>>     fImageFilters;
+    SkTArray<sk_sp<SkPicture>>         fPictures;
+};
+
+bool Reader::readTypefaces() {
+    const SkDeserialProcs& procs = fBuffer->getDeserialProcs();
+    const int count = this->readCount();
+    fTypefaces.setCount(count);
+    for (int i = 0; i < count; ++i) {
+        const int32_t ssize = fBuffer->readInt();
+        const size_t size = ssize < 0 ? sk_negate_to_size_t(ssize) : (size_t)ssize;
+        const void* data = fBuffer->skip(size);
+        if (!fBuffer->isValid()) {
+            return false;
+        }
+        sk_sp<SkTypeface> tf;
+        if (ssize < 0) {
+            if (procs.fTypefaceProc) {
+                tf = procs.fTypefaceProc(data, size, procs.fTypefaceCtx);
+            }
+        } else {
+            SkMemoryStream stream(data, size, false);
+            tf = SkTypeface::MakeDeserialize(&stream);
+        }
+        // As in SkPictureData, typefaces that can't be read are drawn with the default.
+        fTypefaces[i] = tf ? std::move(tf) : SkTypeface::MakeDefault();
+    }
+    fTypefaces.setupBuffer(*fBuffer);
+    return true;
+}
+
+sk_sp<SkPicture> Reader::read() {
+    if (!fBuffer->validate(fBuffer->readUInt() == kVersion) || !this->readTypefaces()) {
+        return nullptr;
+    }
+
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        if (!fBuffer->readPaint(&fPaints.push_back(), nullptr)) {
+            return nullptr;
+        }
+    }
+
+    {
+        // Paths take at least two bytes each.
+        const uint32_t count = fBuffer->readUInt();
+        const size_t size = fBuffer->readUInt();
+        const void* bytes = fBuffer->skip(size);
+        if (!fBuffer->validate(bytes && count <= size / 2)) {
+            return nullptr;
+        }
+        ByteReader paths(bytes, size);
+        fPaths.reset(count);
+        for (SkPath& path : fPaths) {
+            if (!read_path(&paths, &path)) {
+                return nullptr;
+            }
+            path.updateBoundsCache();
+        }
+    }
+
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        sk_sp<SkImage> image = fBuffer->readImage();
+        if (!fBuffer->validate(image != nullptr)) {
+            return nullptr;
+        }
+        fImages.push_back(std::move(image));
+    }
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        sk_sp<SkTextBlob> blob = SkTextBlobPriv::MakeFromBuffer(*fBuffer);
+        if (!fBuffer->validate(blob != nullptr)) {
+            return nullptr;
+        }
+        fBlobs.push_back(std::move(blob));
+    }
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        const size_t size = fBuffer->readUInt();
+        const void* bytes = fBuffer->skip(size);
+        sk_sp<SkVertices> vertices = bytes ? SkVertices::Decode(bytes, size) : nullptr;
+        if (!fBuffer->validate(vertices != nullptr)) {
+            return nullptr;
+        }
+        fVertices.push_back(std::move(vertices));
+    }
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        fBuffer->readRegion(&fRegions.push_back());
+    }
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        sk_sp<SkImageFilter> filter = fBuffer->readImageFilter();
+        if (!fBuffer->validate(filter != nullptr)) {
+            return nullptr;
+        }
+        fImageFilters.push_back(std::move(filter));
+    }
+
+    for (int i = 0, count = this->readCount(); i < count; ++i) {
+        sk_sp<SkPicture> picture;
+        switch (fBuffer->readUInt()) {
+            case kRecord_PictureKind:    picture = this->readRecordPicture();             break;
+            case kFlattened_PictureKind: picture = SkPicturePriv::MakeFromBuffer(*fBuffer); break;
+            default: break;
+        }
+        if (!fBuffer->validate(picture != nullptr)) {
+            return nullptr;
+        }
+        fPictures.push_back(std::move(picture));
+    }
+    if (!fBuffer->validate(!fPictures.empty())) {
+        return nullptr;
+    }
+    return fPictures.back();
+}
+
+sk_sp<SkPicture> Reader::readRecordPicture() {
+    SkRect cull;
+    fBuffer->readRect(&cull);
+    const size_t size = fBuffer->readUInt();
+    const void* bytes = fBuffer->skip(size);
+    if (!fBuffer->isValid()) {
+        return nullptr;
+    }
+
+    ByteReader ops(bytes, size);
+    auto record = sk_make_sp<SkRecord>();
+    size_t subPictureBytes = 0;
+    int saveCount = 0;
+    while (!ops.done()) {
+        if (!this->readOp(&ops, record.get(), &subPictureBytes, &saveCount)) {
+            return nullptr;
+        }
+    }
+
+    sk_sp<SkBBoxHierarchy> bbh;
+    if (record->count() > 0) {
+        bbh = sk_make_sp<SkRTree>();
+        SkAutoTMalloc<SkRect> bounds(record->count());
+        SkRecordFillBounds(cull, *record, bounds);
+        bbh->insert(bounds, record->count());
+    }
+    return sk_make_sp<SkBigPicture>(cull, std::move(record), nullptr, std::move(bbh),
+                                    subPictureBytes);
+}
+
+bool Reader::readOp(ByteReader* in, SkRecord* record, size_t* subPictureBytes, int* saveCount) {
+    const auto readClipOp = [in] {
+        const unsigned opAA = in->readUInt(((unsigned)SkClipOp::kMax_EnumValue << 1) | 1);
+        return ClipOpAndAA((SkClipOp)(opAA >> 1), opAA & 1);
+    };
+    const auto readBlendMode = [in] { return in->readEnum(SkBlendMode::kLastMode); };
+    const auto readConstraint = [in] { return in->readEnum(SkCanvas::kFast_SrcRectConstraint); };
+    const auto readColors = [in, record](int count) -> SkColor* {
+        if (!in->readBool()) {
+            return nullptr;
+        }
+        SkColor* colors = record->alloc<SkColor>(count);
+        for (int i = 0; i < count; ++i) {
+            colors[i] = in->read32();
+        }
+        return colors;
+    };
+
+    switch (in->readUInt(DrawEdgeAAImageSet_Type)) {
+        case Flush_Type:
+            Append<Flush>(record);
+            break;
+        case Save_Type:
+            *saveCount += 1;
+            Append<Save>(record);
+            break;
+        case Restore_Type: {
+            // SkRecordFillBounds() needs every Restore to have a save.
+            const SkMatrix matrix = in->readMatrix();
+            if (!in->validate(*saveCount > 0)) {
+                return false;
+            }
+            *saveCount -= 1;
+            Append<Restore>(record, matrix);
+        } break;
+        case SaveLayer_Type: {
+            const uint32_t has = in->readUInt(15);
+            const SkCanvas::SaveLayerFlags flags = in->readUInt();
+            SkRect bounds;
+            if (has & 1) {
+                bounds = in->readRect();
+            }
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImageFilter> backdrop;
+            if (has & 2) {
+                const auto* filter = Lookup(in, fImageFilters);
+                backdrop = filter ? *filter : nullptr;
+            }
+            sk_sp<const SkImage> clipMask;
+            if (has & 4) {
+                clipMask = this->readImage(in);
+            }
+            SkMatrix clipMatrix;
+            if (has & 8) {
+                clipMatrix = in->readMatrix();
+            }
+            if (!in->isValid()) {
+                return false;
+            }
+            *saveCount += 1;
+            Append<SaveLayer>(record, Copy(record, (has & 1) ? &bounds : nullptr),
+                              Copy(record, paint), std::move(backdrop), std::move(clipMask),
+                              Copy(record, (has & 8) ? &clipMatrix : nullptr), flags);
+        } break;
+        case SaveBehind_Type: {
+            const bool hasSubset = in->readBool();
+            const SkRect subset = hasSubset ? in->readRect() : SkRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            *saveCount += 1;
+            Append<SaveBehind>(record, Copy(record, hasSubset ? &subset : nullptr));
+        } break;
+        case SetMatrix_Type: {
+            const SkMatrix matrix = in->readMatrix();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<SetMatrix>(record, matrix);
+        } break;
+        case Translate_Type: {
+            const SkScalar dx = in->readScalar(),
+                           dy = in->readScalar();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<Translate>(record, dx, dy);
+        } break;
+        case Scale_Type: {
+            const SkScalar sx = in->readScalar(),
+                           sy = in->readScalar();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<Scale>(record, sx, sy);
+        } break;
+        case Concat_Type: {
+            const SkMatrix matrix = in->readMatrix();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<Concat>(record, matrix);
+        } break;
+        case Concat44_Type: {
+            SkScalar m[16];
+            for (SkScalar& v : m) {
+                v = in->readScalar();
+            }
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<Concat44>(record, m);
+        } break;
+        case ClipPath_Type: {
+            const SkPath* path = this->readPath(in);
+            const ClipOpAndAA opAA = readClipOp();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<ClipPath>(record, *path, opAA);
+        } break;
+        case ClipRRect_Type: {
+            const SkRRect rrect = in->readRRect();
+            const ClipOpAndAA opAA = readClipOp();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<ClipRRect>(record, rrect, opAA);
+        } break;
+        case ClipRect_Type: {
+            const SkRect rect = in->readRect();
+            const ClipOpAndAA opAA = readClipOp();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<ClipRect>(record, rect, opAA);
+        } break;
+        case ClipRegion_Type: {
+            const SkRegion* region = Lookup(in, fRegions);
+            const SkClipOp op = in->readEnum(SkClipOp::kMax_EnumValue);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<ClipRegion>(record, *region, op);
+        } break;
+        case DrawArc_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            // SkCanvas sorts rects and ovals before recording them, and bounds rely on that.
+            const SkRect oval = in->readRect().makeSorted();
+            const SkScalar startAngle = in->readScalar(),
+                           sweepAngle = in->readScalar();
+            const bool useCenter = in->readBool();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawArc>(record, *paint, oval, startAngle, sweepAngle, useCenter);
+        } break;
+        case DrawImage_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImage> image = this->readImage(in);
+            const SkPoint pt = in->readPoint();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawImage>(record, Copy(record, paint), std::move(image), pt.fX, pt.fY);
+        } break;
+        case DrawImageLattice_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImage> image = this->readImage(in);
+            int counts[2];
+            int* divs[2];
+            for (int axis = 0; axis < 2; ++axis) {
+                counts[axis] = in->readCount(1);
+                divs[axis] = record->alloc<int>(counts[axis]);
+                for (int i = 0; i < counts[axis]; ++i) {
+                    divs[axis][i] = in->readOffset(i ? divs[axis][i - 1] : 0);
+                }
+            }
+            // Lattices have a flag, and maybe a color, for each of their rectangles, or none.
+            const int flagCount = in->readCount(1);
+            if (!in->validate(flagCount == 0 ||
+                              flagCount == (int64_t)(counts[0] + 1) * (counts[1] + 1))) {
+                return false;
+            }
+            auto flags = record->alloc<SkCanvas::Lattice::RectType>(flagCount);
+            SkColor* colors = nullptr;
+            if (flagCount) {
+                for (int i = 0; i < flagCount; ++i) {
+                    flags[i] = in->readEnum(SkCanvas::Lattice::kFixedColor);
+                }
+                colors = readColors(flagCount);
+            }
+            const SkIRect src = in->readIRect();
+            const SkRect dst = in->readRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawImageLattice>(record, Copy(record, paint), std::move(image),
+                                     counts[0], divs[0], counts[1], divs[1],
+                                     flagCount, flags, colors, src, dst);
+        } break;
+        case DrawImageRect_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImage> image = this->readImage(in);
+            const bool hasSrc = in->readBool();
+            const SkRect src = hasSrc ? in->readRect() : SkRect();
+            const SkRect dst = in->readRect();
+            const auto constraint = readConstraint();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawImageRect>(record, Copy(record, paint), std::move(image),
+                                  Copy(record, hasSrc ? &src : nullptr), dst, constraint);
+        } break;
+        case DrawImageNine_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImage> image = this->readImage(in);
+            const SkIRect center = in->readIRect();
+            const SkRect dst = in->readRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawImageNine>(record, Copy(record, paint), std::move(image), center, dst);
+        } break;
+        case DrawDRRect_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkRRect outer = in->readRRect(),
+                          inner = in->readRRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawDRRect>(record, *paint, outer, inner);
+        } break;
+        case DrawOval_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkRect oval = in->readRect().makeSorted();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawOval>(record, *paint, oval);
+        } break;
+        case DrawBehind_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawBehind>(record, *paint);
+        } break;
+        case DrawPaint_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawPaint>(record, *paint);
+        } break;
+        case DrawPath_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkPath* path = this->readPath(in);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawPath>(record, *paint, *path);
+        } break;
+        case DrawPatch_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            SkPoint* cubics = record->alloc<SkPoint>(SkPatchUtils::kNumCtrlPts);
+            in->readPoints(cubics, SkPatchUtils::kNumCtrlPts);
+            SkColor* colors = readColors(SkPatchUtils::kNumCorners);
+            SkPoint* texCoords = nullptr;
+            if (in->readBool()) {
+                texCoords = record->alloc<SkPoint>(SkPatchUtils::kNumCorners);
+                in->readPoints(texCoords, SkPatchUtils::kNumCorners);
+            }
+            const SkBlendMode bmode = readBlendMode();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawPatch>(record, *paint, cubics, colors, texCoords, bmode);
+        } break;
+        case DrawPicture_Type: {
+            // Sub-pictures are written before the pictures that draw them.
+            const SkPaint* paint = this->readOptionalPaint(in);
+            const sk_sp<SkPicture>* picture = Lookup(in, fPictures);
+            const SkMatrix matrix = in->readMatrix();
+            if (!in->isValid()) {
+                return false;
+            }
+            *subPictureBytes += (*picture)->approximateBytesUsed();
+            Append<DrawPicture>(record, Copy(record, paint), *picture, matrix);
+        } break;
+        case DrawPoints_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const auto mode = in->readEnum(SkCanvas::kPolygon_PointMode);
+            const int count = in->readCount(2);
+            SkPoint* pts = record->alloc<SkPoint>(count);
+            in->readPoints(pts, count);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawPoints>(record, *paint, mode, SkToUInt(count), pts);
+        } break;
+        case DrawRRect_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkRRect rrect = in->readRRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawRRect>(record, *paint, rrect);
+        } break;
+        case DrawRect_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkRect rect = in->readRect().makeSorted();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawRect>(record, *paint, rect);
+        } break;
+        case DrawRegion_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const SkRegion* region = Lookup(in, fRegions);
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawRegion>(record, *paint, *region);
+        } break;
+        case DrawTextBlob_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const auto* blob = Lookup(in, fBlobs);
+            const SkPoint pt = in->readPoint();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawTextBlob>(record, *paint, *blob, pt.fX, pt.fY);
+        } break;
+        case DrawAtlas_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            sk_sp<const SkImage> atlas = this->readImage(in);
+            const int count = in->readCount(8);
+            SkRSXform* xforms = record->alloc<SkRSXform>(count);
+            SkRect* texs = record->alloc<SkRect>(count);
+            for (int i = 0; i < count; ++i) {
+                const SkScalar scos = in->readScalar(),
+                               ssin = in->readScalar();
+                const SkPoint t = in->readPoint();
+                xforms[i] = SkRSXform::Make(scos, ssin, t.fX, t.fY);
+                texs[i] = in->readRect();
+            }
+            SkColor* colors = readColors(count);
+            const SkBlendMode mode = readBlendMode();
+            const bool hasCull = in->readBool();
+            const SkRect cull = hasCull ? in->readRect() : SkRect();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawAtlas>(record, Copy(record, paint), std::move(atlas), xforms, texs,
+                              colors, count, mode, Copy(record, hasCull ? &cull : nullptr));
+        } break;
+        case DrawVertices_Type: {
+            const SkPaint* paint = this->readPaint(in);
+            const auto* vertices = Lookup(in, fVertices);
+            const int boneCount = in->readCount(6);
+            SkVertices::Bone* bones = record->alloc<SkVertices::Bone>(boneCount);
+            for (int i = 0; i < boneCount; ++i) {
+                for (SkScalar& v : bones[i].values) {
+                    v = in->readScalar();
+                }
+            }
+            const SkBlendMode bmode = readBlendMode();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawVertices>(record, *paint, *vertices, bones, boneCount, bmode);
+        } break;
+        case DrawShadowRec_Type: {
+            const SkPath* path = this->readPath(in);
+            SkDrawShadowRec rec;
+            for (SkScalar* v : {&rec.fZPlaneParams.fX, &rec.fZPlaneParams.fY,
+                                &rec.fZPlaneParams.fZ, &rec.fLightPos.fX, &rec.fLightPos.fY,
+                                &rec.fLightPos.fZ, &rec.fLightRadius}) {
+                *v = in->readScalar();
+            }
+            rec.fAmbientColor = in->read32();
+            rec.fSpotColor = in->read32();
+            rec.fFlags = in->readUInt();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawShadowRec>(record, *path, rec);
+        } break;
+        case DrawAnnotation_Type: {
+            const SkRect rect = in->readRect();
+            SkString key = in->readString();
+            sk_sp<SkData> value;
+            if (const size_t size = in->readCount(1)) {
+                if (const void* bytes = in->skip(size - 1)) {
+                    value = SkData::MakeWithCopy(bytes, size - 1);
+                }
+            }
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawAnnotation>(record, rect, std::move(key), std::move(value));
+        } break;
+        case DrawEdgeAAQuad_Type: {
+            const SkRect rect = in->readRect();
+            SkPoint* clip = nullptr;
+            if (in->readBool()) {
+                clip = record->alloc<SkPoint>(4);
+                in->readPoints(clip, 4);
+            }
+            const auto aa = in->readEnum(SkCanvas::kAll_QuadAAFlags);
+            SkColor4f color;
+            for (int i = 0; i < 4; ++i) {
+                color[i] = in->readScalar();
+            }
+            const SkBlendMode mode = readBlendMode();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawEdgeAAQuad>(record, rect, clip, aa, color, mode);
+        } break;
+        case DrawEdgeAAImageSet_Type: {
+            const SkPaint* paint = this->readOptionalPaint(in);
+            const int count = in->readCount(6);
+            SkAutoTArray<SkCanvas::ImageSetEntry> set(count);
+            for (int i = 0; i < count; ++i) {
+                SkCanvas::ImageSetEntry& entry = set[i];
+                entry.fImage = this->readImage(in);
+                entry.fSrcRect = in->readRect();
+                entry.fDstRect = in->readRect();
+                // -1 means no matrix. Each matrix takes at least a byte, so bounding the index
+                // by what's left also keeps GetDstClipAndMatrixCounts() from overflowing, and us
+                // from allocating too many.
+                const int32_t matrixIndex = in->readInt();
+                entry.fMatrixIndex = in->validate(-1 <= matrixIndex &&
+                                                  matrixIndex < (int64_t)in->remaining())
+                                             ? matrixIndex : -1;
+                entry.fAlpha = in->readScalar();
+                const unsigned flags = in->readUInt((SkCanvas::kAll_QuadAAFlags << 1) | 1);
+                entry.fAAFlags = flags >> 1;
+                entry.fHasClip = flags & 1;
+            }
+            int clipCount, matrixCount;
+            SkCanvasPriv::GetDstClipAndMatrixCounts(set.get(), count, &clipCount, &matrixCount);
+            if (!in->validate(matrixCount <= (int64_t)in->remaining())) {
+                return false;
+            }
+            SkPoint* dstClips = record->alloc<SkPoint>(clipCount);
+            in->readPoints(dstClips, clipCount);
+            SkMatrix* matrices = record->alloc<SkMatrix>(matrixCount);
+            for (int i = 0; i < matrixCount && in->isValid(); ++i) {
+                new (matrices + i) SkMatrix(in->readMatrix());
+            }
+            const auto constraint = readConstraint();
+            if (!in->isValid()) {
+                return false;
+            }
+            Append<DrawEdgeAAImageSet>(record, Copy(record, paint), std::move(set), count,
+                                       dstClips, matrices, constraint);
+        } break;
+        default:
+            // NoOps and DrawDrawables are not written.
+            return in->validate(false);
+    }
+    return in->isValid();
+}
+
+}  // namespace
+
+void SkRecordSerialize(const SkPicture* picture, SkWStream* stream, const SkSerialProcs& procs) {
+    Writer writer(procs);
+    writer.addPicture(picture, false);
+    writer.write(stream);
+}
+
+sk_sp<SkPicture> SkRecordDeserialize(SkStream* stream, const SkPictInfo& info,
+                                     const SkDeserialProcs& procs, SkData* source) {
+    uint32_t size;
+    if (stream->skip(kPaddingSize) != kPaddingSize || !stream->readU32(&size)) {
+        return nullptr;
+    }
+
+    // Memory streams are read in place, rather than copied, when they are aligned. Images share
+    // their encoded bytes with source if the stream reads from it, and otherwise copy them.
+    sk_sp<SkData> data;
+    const char* bytes = nullptr;
+    const char* base = static_cast<const char*>(stream->getMemoryBase());
+    if (base && stream->hasPosition() && stream->hasLength()) {
+        const size_t offset = stream->getPosition();
+        if (size <= stream->getLength() - offset && SkIsAlign4((uintptr_t)(base + offset))) {
+            bytes = base + offset;
+            stream->skip(size);
+            if (source && source->data() == base && source->size() == stream->getLength()) {
+                data = SkData::MakeSubset(source, offset, size);
+            }
+        }
+    }
+    if (!bytes) {
+        data = SkData::MakeFromStream(stream, size);
+        if (!data) {
+            return nullptr;
+        }
+        bytes = static_cast<const char*>(data->data());
+    }
+
+    SkReadBuffer buffer(bytes, size);
+    buffer.setVersion(info.getVersion());
+    buffer.setDeserialProcs(procs);
+    if (data) {
+        buffer.setBackingData(std::move(data));
+    }
+    return Reader(&buffer).read();
+}
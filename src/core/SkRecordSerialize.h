@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRecordSerialize_DEFINED
+#define SkRecordSerialize_DEFINED
+
+#include "include/core/SkPicture.h"
+
+class SkStream;
+class SkWStream;
+struct SkDeserialProcs;
+struct SkPictInfo;
+struct SkSerialProcs;
+
+// The compact picture format writes a picture's SkRecords directly, rather than playing them into
+// SkPictureRecord's op stream. Paints, paths, images, text blobs, vertices and sub-pictures are
+// written once each into tables shared by the picture and all of its sub-pictures, and commands
+// refer to them by index. Commands are written as varints, with coordinates written as their
+// difference from the previous coordinate: in sixteenths when they are a whole number of
+// sixteenths, and otherwise as the difference of their bits. Paths whose points are all whole
+// sixteenths are written the same way, and other paths as raw floats, which load straight into
+// the path. Loading appends the commands straight to an SkRecord and builds an SkRTree, without
+// going through SkRecorder.
+//
+// Everything after the SkPictInfo and its trailing byte is written by SkRecordSerialize().
+// The layout of that data is versioned by SkRecordSerialize.cpp's kVersion, separately from
+// SkPicturePriv::Version, which still versions the flattened paints, images and effects.
+
+// Writes picture's commands and the objects they use. Drawables are written as the pictures they
+// were snapshotted to, and pictures that are not SkBigPictures are recorded first.
+void SkRecordSerialize(const SkPicture*, SkWStream*, const SkSerialProcs&);
+
+// Reads the data written by SkRecordSerialize(). Returns nullptr if it is not valid. If source is
+// not null and the stream reads from it, images share their encoded bytes with it.
+sk_sp<SkPicture> SkRecordDeserialize(SkStream*, const SkPictInfo&, const SkDeserialProcs&,
+                                     SkData* source = nullptr);
+
+#endif//SkRecordSerialize_DEFINED
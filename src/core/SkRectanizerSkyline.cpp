@@ -6,11 +6,11 @@
  */
 
 #include "src/core/SkIPoint16.h"
-#include "src/gpu/GrRectanizerSkyline.h"
+#include "src/core/SkRectanizerSkyline.h"
 
 #include <algorithm>
 
-bool GrRectanizerSkyline::addRect(int width, int height, SkIPoint16* loc) {
+bool SkRectanizerSkyline::addRect(int width, int height, SkIPoint16* loc) {
     if ((unsigned)width > (unsigned)this->width() ||
         (unsigned)height > (unsigned)this->height()) {
         return false;
@@ -49,7 +49,7 @@ bool GrRectanizerSkyline::addRect(int width, int height, SkIPoint16* loc) {
     return false;
 }
 
-bool GrRectanizerSkyline::rectangleFits(int skylineIndex, int width, int height, int* ypos) const {
+bool SkRectanizerSkyline::rectangleFits(int skylineIndex, int width, int height, int* ypos) const {
     int x = fSkyline[skylineIndex].fX;
     if (x + width > this->width()) {
         return false;
@@ -72,7 +72,7 @@ bool GrRectanizerSkyline::rectangleFits(int skylineIndex, int width, int height,
     return true;
 }
 
-void GrRectanizerSkyline::addSkylineLevel(int skylineIndex, int x, int y, int width, int height) {
+void SkRectanizerSkyline::addSkylineLevel(int skylineIndex, int x, int y, int width, int height) {
     SkylineSegment newSegment;
     newSegment.fX = x;
     newSegment.fY = y + height;
@@ -5,17 +5,17 @@
  * found in the LICENSE file.
  */
 
-#ifndef GrRectanizerSkyline_DEFINED
-#define GrRectanizerSkyline_DEFINED
+#ifndef SkRectanizerSkyline_DEFINED
+#define SkRectanizerSkyline_DEFINED
 
 #include "include/private/SkTDArray.h"
 #include "src/core/SkIPoint16.h"
 
 // Pack rectangles and track the current silhouette
 // Based, in part, on Jukka Jylanki's work at http://clb.demon.fi
-class GrRectanizerSkyline {
+class SkRectanizerSkyline {
 public:
-    GrRectanizerSkyline(int w, int h) : fWidth{w}, fHeight{h} {
+    SkRectanizerSkyline(int w, int h) : fWidth{w}, fHeight{h} {
         this->reset();
     }
 
@@ -55,4 +55,4 @@ private:
     int32_t fAreaSoFar;
 };
 
-#endif  // GrRectanizerSkyline_DEFINED
+#endif  // SkRectanizerSkyline_DEFINED
@@ -691,13 +691,6 @@ struct spanRec {
         fB_runs = b_runs;
     }
 
-    bool done() const {
-        SkASSERT(fA_left <= SkRegion_kRunTypeSentinel);
-        SkASSERT(fB_left <= SkRegion_kRunTypeSentinel);
-        return fA_left == SkRegion_kRunTypeSentinel &&
-               fB_left == SkRegion_kRunTypeSentinel;
-    }
-
     void next() {
         assert_valid_pair(fA_left, fA_rite);
         assert_valid_pair(fB_left, fB_rite);
@@ -771,21 +764,82 @@ static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
     return ptr - runs;
 }
 
+/*  The intervals that one operand has on a span before the other operand's first interval, or
+ *  after its last one, are either all kept by the op or all dropped. The intervals of a region
+ *  never touch each other, so these are copied as a block instead of being merged one at a time.
+ */
+static const SkRegionPriv::RunType* skip_intervals_ending_by(const SkRegionPriv::RunType runs[],
+                                                             int stop) {
+    while (runs[0] != SkRegion_kRunTypeSentinel && runs[1] <= stop) {
+        runs += 2;
+    }
+    return runs;
+}
+
+// Appends the intervals left after the other operand's last one. Only the first, [left, rite),
+// which the merge may already have trimmed, can join the last interval in dst.
+static SkRegionPriv::RunType* append_remaining_intervals(SkRegionPriv::RunType* dst,
+                                                         bool firstInterval,
+                                                         int left, int rite,
+                                                         const SkRegionPriv::RunType runs[],
+                                                         const SkRegionPriv::RunType* sentinel) {
+    if (left == SkRegion_kRunTypeSentinel) {
+        return dst;
+    }
+    SkASSERT(left < rite);
+    if (firstInterval || *(dst - 1) < left) {
+        *dst++ = (SkRegionPriv::RunType)(left);
+        *dst++ = (SkRegionPriv::RunType)(rite);
+    } else {
+        *(dst - 1) = (SkRegionPriv::RunType)(rite);
+    }
+
+    SkASSERT(*sentinel == SkRegion_kRunTypeSentinel && runs <= sentinel);
+    size_t n = sentinel - runs;
+    SkASSERT(n == 0 || runs[0] > rite);
+    memcpy(dst, runs, n * sizeof(SkRegionPriv::RunType));
+    return dst + n;
+}
+
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
                            int min, int max) {
+    const SkRegionPriv::RunType* a_sentinel = a_runs + distance_to_sentinel(a_runs);
+    const SkRegionPriv::RunType* b_sentinel = b_runs + distance_to_sentinel(b_runs);
+
     // This is a worst-case for this span plus two for TWO terminating sentinels.
-    array->resizeToAtLeast(
-            dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
+    array->resizeToAtLeast(dstOffset + (a_sentinel - a_runs) + (b_sentinel - b_runs) + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
     spanRec rec;
     bool    firstInterval = true;
 
+    const bool keepA = (unsigned)(1 - min) <= (unsigned)(max - min);
+    const bool keepB = (unsigned)(2 - min) <= (unsigned)(max - min);
+
+    if (a_runs[0] < b_runs[0]) {
+        const SkRegionPriv::RunType* stop = skip_intervals_ending_by(a_runs, b_runs[0]);
+        if (keepA && stop > a_runs) {
+            memcpy(dst, a_runs, (stop - a_runs) * sizeof(SkRegionPriv::RunType));
+            dst += stop - a_runs;
+            firstInterval = false;
+        }
+        a_runs = stop;
+    } else if (b_runs[0] < a_runs[0]) {
+        const SkRegionPriv::RunType* stop = skip_intervals_ending_by(b_runs, a_runs[0]);
+        if (keepB && stop > b_runs) {
+            memcpy(dst, b_runs, (stop - b_runs) * sizeof(SkRegionPriv::RunType));
+            dst += stop - b_runs;
+            firstInterval = false;
+        }
+        b_runs = stop;
+    }
+
     rec.init(a_runs, b_runs);
 
-    while (!rec.done()) {
+    while (rec.fA_left != SkRegion_kRunTypeSentinel &&
+           rec.fB_left != SkRegion_kRunTypeSentinel) {
         rec.next();
 
         int left = rec.fLeft;
@@ -804,6 +858,16 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
             }
         }
     }
+
+    // At most one of these has intervals left.
+    if (keepA) {
+        dst = append_remaining_intervals(dst, firstInterval, rec.fA_left, rec.fA_rite,
+                                         rec.fA_runs, a_sentinel);
+    }
+    if (keepB) {
+        dst = append_remaining_intervals(dst, firstInterval, rec.fB_left, rec.fB_rite,
+                                         rec.fB_runs, b_sentinel);
+    }
     SkASSERT(dst < &(*array)[array->count() - 1]);
     *dst++ = SkRegion_kRunTypeSentinel;
     return dst - &(*array)[0];
@@ -8,6 +8,7 @@
 #include "src/core/SkRemoteGlyphCache.h"
 
 #include <bitset>
+#include <cmath>
 #include <iterator>
 #include <memory>
 #include <new>
@@ -19,6 +20,7 @@
 #include "src/core/SkDraw.h"
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkGlyphRun.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkScalerCache.h"
 #include "src/core/SkSpan.h"
 #include "src/core/SkStrikeCache.h"
@@ -26,6 +28,7 @@
 #include "src/core/SkTraceEvent.h"
 #include "src/core/SkTypeface_remote.h"
 #include "src/core/SkZip.h"
+#include "src/effects/SkPackBits.h"
 
 #if SK_SUPPORT_GPU
 #include "src/gpu/GrDrawOpAtlas.h"
@@ -101,6 +104,25 @@ public:
         return result;
     }
 
+    // Write data without padding it to its natural alignment. Used by the compact wire format.
+    template <typename T>
+    void writeUnaligned(const T& data) {
+        memcpy(allocate(sizeof(T), 1), &data, sizeof(T));
+    }
+
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            this->writeUnaligned<uint8_t>(SkTo<uint8_t>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        this->writeUnaligned<uint8_t>(SkTo<uint8_t>(value));
+    }
+
+    void writeSignedVarint(int32_t value) {
+        // Zig-zag encode so small negative values are small.
+        this->writeVarint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
     void writeDescriptor(const SkDescriptor& desc) {
         write(desc.getLength());
         auto result = allocate(desc.getLength(), alignof(SkDescriptor));
@@ -133,6 +155,37 @@ public:
         return true;
     }
 
+    template <typename T>
+    bool readUnaligned(T* val) {
+        auto* result = this->ensureAtLeast(sizeof(T), 1);
+        if (!result) return false;
+
+        memcpy(val, const_cast<const char*>(result), sizeof(T));
+        return true;
+    }
+
+    bool readVarint(uint64_t* value) {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!this->readUnaligned<uint8_t>(&byte)) return false;
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readSignedVarint(int32_t* value) {
+        uint64_t zigzag;
+        if (!this->readVarint(&zigzag) || zigzag > UINT32_MAX) return false;
+        uint32_t bits = static_cast<uint32_t>(zigzag);
+        *value = static_cast<int32_t>((bits >> 1) ^ (0u - (bits & 1)));
+        return true;
+    }
+
     bool readDescriptor(SkAutoDescriptor* ad) {
         uint32_t descLength = 0u;
         if (!read<uint32_t>(&descLength)) return false;
@@ -154,6 +207,7 @@ public:
     }
 
     size_t bytesRead() const { return fBytesRead; }
+    size_t bytesRemaining() const { return fMemorySize - fBytesRead; }
 
 private:
     const volatile char* ensureAtLeast(size_t size, size_t alignment) {
@@ -182,6 +236,184 @@ bool SkFuzzDeserializeSkDescriptor(sk_sp<SkData> bytes, SkAutoDescriptor* ad) {
 // Paths use a SkWriter32 which requires 4 byte alignment.
 static const size_t kPathAlignment  = 4u;
 
+// -- Compact wire format --------------------------------------------------------------------------
+// The top bit of the typeface count marks strike data that uses the compact format. In the compact
+// format:
+//  * glyph metrics are varints, and the advances are only written when they are not zero,
+//  * glyph images are run length encoded using SkPackBits when that makes them smaller,
+//  * paths whose points are all on the 1/64 pixel grid used by font outlines are written as
+//    packed verbs and varint deltas between points. Other paths use SkPath::writeToMemory.
+static constexpr uint64_t kCompactWireFormatBit = uint64_t{1} << 63;
+
+static constexpr uint8_t kCompactMaskFormatMask = 0x07;
+static constexpr uint8_t kCompactHasAdvanceX    = 0x08;
+static constexpr uint8_t kCompactHasAdvanceY    = 0x10;
+static_assert(SkMask::kCountMaskFormats <= kCompactMaskFormatMask + 1, "");
+
+static constexpr uint8_t kCompactRawPath       = 0;
+static constexpr uint8_t kCompactQuantizedPath = 1;
+static constexpr float   kPathGridScale        = 64;
+static constexpr float   kPathGridLimit        = 1 << 24;
+
+static void write_glyph_compact(const SkGlyph& glyph, Serializer* serializer) {
+    serializer->writeVarint(glyph.getPackedID().value());
+    uint8_t flags = glyph.maskFormat();
+    flags |= glyph.advanceX() != 0 ? kCompactHasAdvanceX : 0;
+    flags |= glyph.advanceY() != 0 ? kCompactHasAdvanceY : 0;
+    serializer->writeUnaligned<uint8_t>(flags);
+    if (flags & kCompactHasAdvanceX) { serializer->writeUnaligned<float>(glyph.advanceX()); }
+    if (flags & kCompactHasAdvanceY) { serializer->writeUnaligned<float>(glyph.advanceY()); }
+    serializer->writeVarint(glyph.width());
+    serializer->writeVarint(glyph.height());
+    serializer->writeSignedVarint(glyph.top());
+    serializer->writeSignedVarint(glyph.left());
+}
+
+// A packed size of zero means the image follows unpacked.
+static void write_image_compact(const void* image, size_t imageSize, Serializer* serializer) {
+    SkAutoTMalloc<uint8_t> packed(SkPackBits::ComputeMaxSize8(imageSize));
+    size_t packedSize = SkPackBits::Pack8(static_cast<const uint8_t*>(image), imageSize,
+                                          packed.get(), SkPackBits::ComputeMaxSize8(imageSize));
+    if (packedSize < imageSize) {
+        serializer->writeVarint(packedSize);
+        memcpy(serializer->allocate(packedSize, 1), packed.get(), packedSize);
+    } else {
+        serializer->writeVarint(0);
+        memcpy(serializer->allocate(imageSize, 1), image, imageSize);
+    }
+}
+
+static bool on_path_grid(const SkPath& path) {
+    const SkPoint* points = SkPathPriv::PointData(path);
+    for (int i = 0; i < path.countPoints(); i++) {
+        for (float v : {points[i].fX * kPathGridScale, points[i].fY * kPathGridScale}) {
+            if (!(std::abs(v) < kPathGridLimit) || v != std::floor(v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void write_path_compact(const SkPath& path, Serializer* serializer) {
+    if (!on_path_grid(path)) {
+        serializer->writeUnaligned<uint8_t>(kCompactRawPath);
+        size_t pathSize = path.writeToMemory(nullptr);
+        serializer->writeVarint(pathSize);
+        path.writeToMemory(serializer->allocate(pathSize, kPathAlignment));
+        return;
+    }
+
+    serializer->writeUnaligned<uint8_t>(
+            kCompactQuantizedPath | SkTo<uint8_t>(static_cast<int>(path.getFillType()) << 1));
+
+    // Verbs are less than 8, so two fit in a byte.
+    int verbCount = path.countVerbs();
+    SkAutoSTMalloc<32, uint8_t> verbs(verbCount);
+    path.getVerbs(verbs.get(), verbCount);
+    serializer->writeVarint(verbCount);
+    for (int i = 0; i < verbCount; i += 2) {
+        uint8_t high = i + 1 < verbCount ? verbs[i + 1] : 0;
+        serializer->writeUnaligned<uint8_t>(SkTo<uint8_t>(verbs[i] | (high << 4)));
+    }
+
+    const SkPoint* points = SkPathPriv::PointData(path);
+    int32_t lastX = 0, lastY = 0;
+    for (int i = 0; i < path.countPoints(); i++) {
+        int32_t x = static_cast<int32_t>(points[i].fX * kPathGridScale),
+                y = static_cast<int32_t>(points[i].fY * kPathGridScale);
+        serializer->writeSignedVarint(x - lastX);
+        serializer->writeSignedVarint(y - lastY);
+        lastX = x;
+        lastY = y;
+    }
+
+    const SkScalar* weights = SkPathPriv::ConicWeightData(path);
+    for (int i = 0; i < SkPathPriv::ConicWeightCnt(path); i++) {
+        serializer->writeUnaligned<float>(weights[i]);
+    }
+}
+
+static bool read_path_compact(Deserializer* deserializer, SkPath* path) {
+    uint8_t header;
+    if (!deserializer->readUnaligned<uint8_t>(&header)) return false;
+
+    if ((header & 1) == kCompactRawPath) {
+        uint64_t pathSize;
+        if (!deserializer->readVarint(&pathSize)) return false;
+        auto* pathData = deserializer->read(pathSize, kPathAlignment);
+        if (!pathData) return false;
+        return path->readFromMemory(const_cast<const void*>(pathData), pathSize) != 0;
+    }
+
+    int fillType = header >> 1;
+    if (fillType > static_cast<int>(SkPathFillType::kInverseEvenOdd)) return false;
+    path->setFillType(static_cast<SkPathFillType>(fillType));
+
+    uint64_t verbCount;
+    if (!deserializer->readVarint(&verbCount)) return false;
+    // Each pair of verbs takes a byte. Check against what is left before rounding up, so a huge
+    // verbCount can't wrap around.
+    if (verbCount > deserializer->bytesRemaining() * 2) return false;
+    auto* packedVerbs = deserializer->read((verbCount + 1) / 2, 1);
+    if (!packedVerbs) return false;
+
+    int64_t x = 0, y = 0;
+    auto nextPoint = [&](SkPoint* pt) {
+        int32_t dx, dy;
+        if (!deserializer->readSignedVarint(&dx) || !deserializer->readSignedVarint(&dy)) {
+            return false;
+        }
+        x += dx;
+        y += dy;
+        if (!SkTFitsIn<int32_t>(x) || !SkTFitsIn<int32_t>(y)) return false;
+        *pt = {x / kPathGridScale, y / kPathGridScale};
+        return true;
+    };
+
+    // Points follow all the verbs, and conic weights follow all the points, so collect the
+    // verbs and points first.
+    std::vector<uint8_t> verbs(verbCount);
+    int pointCount = 0;
+    for (size_t i = 0; i < verbCount; i++) {
+        uint8_t pair = static_cast<const volatile uint8_t*>(packedVerbs)[i / 2];
+        verbs[i] = (i & 1) ? pair >> 4 : pair & 0x0f;
+        switch (verbs[i]) {
+            case SkPath::kMove_Verb:
+            case SkPath::kLine_Verb:  pointCount += 1; break;
+            case SkPath::kQuad_Verb:  pointCount += 2; break;
+            case SkPath::kConic_Verb: pointCount += 2; break;
+            case SkPath::kCubic_Verb: pointCount += 3; break;
+            case SkPath::kClose_Verb: break;
+            default: return false;
+        }
+    }
+
+    std::vector<SkPoint> points(pointCount);
+    for (SkPoint& pt : points) {
+        if (!nextPoint(&pt)) return false;
+    }
+
+    const SkPoint* pts = points.data();
+    for (uint8_t verb : verbs) {
+        switch (verb) {
+            case SkPath::kMove_Verb:  path->moveTo(pts[0]); pts += 1; break;
+            case SkPath::kLine_Verb:  path->lineTo(pts[0]); pts += 1; break;
+            case SkPath::kQuad_Verb:  path->quadTo(pts[0], pts[1]); pts += 2; break;
+            case SkPath::kConic_Verb: {
+                float weight;
+                if (!deserializer->readUnaligned<float>(&weight)) return false;
+                path->conicTo(pts[0], pts[1], weight);
+                pts += 2;
+                break;
+            }
+            case SkPath::kCubic_Verb: path->cubicTo(pts[0], pts[1], pts[2]); pts += 3; break;
+            case SkPath::kClose_Verb: path->close(); break;
+        }
+    }
+    return true;
+}
+
 // -- StrikeSpec -----------------------------------------------------------------------------------
 struct StrikeSpec {
     StrikeSpec() = default;
@@ -232,7 +464,7 @@ public:
                  SkDiscardableHandleId discardableHandleId);
     ~RemoteStrike() override;
 
-    void writePendingGlyphs(Serializer* serializer);
+    void writePendingGlyphs(Serializer* serializer, bool compact);
     SkDiscardableHandleId discardableHandleId() const { return fDiscardableHandleId; }
 
     const SkDescriptor& getDescriptor() const override {
@@ -308,7 +540,7 @@ private:
         }
     };
 
-    void writeGlyphPath(const SkGlyph& glyph, Serializer* serializer) const;
+    void writeGlyphPath(const SkGlyph& glyph, Serializer* serializer, bool compact) const;
     void ensureScalerContext();
 
     const int fNumberOfGlyphs;
@@ -519,7 +751,9 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
     }
 
     Serializer serializer(memory);
-    serializer.emplace<uint64_t>(fTypefacesToSend.size());
+    uint64_t typefaceCount = fTypefacesToSend.size();
+    serializer.emplace<uint64_t>(
+            fCompactWireFormat ? typefaceCount | kCompactWireFormatBit : typefaceCount);
     for (const auto& tf : fTypefacesToSend) {
         serializer.write<WireTypeface>(tf);
     }
@@ -530,7 +764,7 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
 #ifdef SK_DEBUG
             [&](RemoteStrike* strike) {
                 if (strike->hasPendingGlyphs()) {
-                    strike->writePendingGlyphs(&serializer);
+                    strike->writePendingGlyphs(&serializer, fCompactWireFormat);
                     strike->resetScalerContext();
                 }
                 auto it = fDescToRemoteStrike.find(&strike->getDescriptor());
@@ -539,9 +773,9 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
             }
 
 #else
-            [&serializer](RemoteStrike* strike) {
+            [&serializer, compact = fCompactWireFormat](RemoteStrike* strike) {
                 if (strike->hasPendingGlyphs()) {
-                    strike->writePendingGlyphs(&serializer);
+                    strike->writePendingGlyphs(&serializer, compact);
                     strike->resetScalerContext();
                 }
             }
@@ -665,7 +899,7 @@ static void writeGlyph(const SkGlyph& glyph, Serializer* serializer) {
     serializer->write<uint8_t>(glyph.maskFormat());
 }
 
-void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
+void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer, bool compact) {
     SkASSERT(this->hasPendingGlyphs());
 
     // Write the desc.
@@ -683,14 +917,26 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
 
     // Write mask glyphs
     serializer->emplace<uint64_t>(fMasksToSend.size());
+    SkAutoTMalloc<uint8_t> image;
     for (SkGlyph& glyph : fMasksToSend) {
         SkASSERT(SkMask::IsValidFormat(glyph.fMaskFormat));
 
-        writeGlyph(glyph, serializer);
+        if (compact) {
+            write_glyph_compact(glyph, serializer);
+        } else {
+            writeGlyph(glyph, serializer);
+        }
         auto imageSize = glyph.imageSize();
         if (imageSize > 0 && FitsInAtlas(glyph)) {
-            glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
-            fContext->getImage(glyph);
+            if (compact) {
+                image.realloc(imageSize);
+                glyph.fImage = image.get();
+                fContext->getImage(glyph);
+                write_image_compact(glyph.fImage, imageSize, serializer);
+            } else {
+                glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
+                fContext->getImage(glyph);
+            }
         }
     }
     fMasksToSend.clear();
@@ -700,8 +946,12 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
     for (SkGlyph& glyph : fPathsToSend) {
         SkASSERT(SkMask::IsValidFormat(glyph.fMaskFormat));
 
-        writeGlyph(glyph, serializer);
-        writeGlyphPath(glyph, serializer);
+        if (compact) {
+            write_glyph_compact(glyph, serializer);
+        } else {
+            writeGlyph(glyph, serializer);
+        }
+        writeGlyphPath(glyph, serializer, compact);
     }
     fPathsToSend.clear();
     fPathAlloc.reset();
@@ -725,14 +975,19 @@ void SkStrikeServer::RemoteStrike::setTypefaceAndEffects(
 }
 
 void SkStrikeServer::RemoteStrike::writeGlyphPath(
-        const SkGlyph& glyph, Serializer* serializer) const {
-    if (glyph.isColor() || glyph.isEmpty()) {
-        serializer->write<uint64_t>(0u);
+        const SkGlyph& glyph, Serializer* serializer, bool compact) const {
+    const SkPath* path =
+            glyph.isColor() || glyph.isEmpty() ? nullptr : glyph.path();
+
+    if (compact) {
+        // The compact format marks a missing path with a single byte.
+        serializer->writeUnaligned<uint8_t>(path != nullptr);
+        if (path != nullptr) {
+            write_path_compact(*path, serializer);
+        }
         return;
     }
 
-    const SkPath* path = glyph.path();
-
     if (path == nullptr) {
         serializer->write<uint64_t>(0u);
         return;
@@ -894,6 +1149,34 @@ bool SkStrikeClient::ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializ
     return true;
 }
 
+bool SkStrikeClient::ReadGlyphCompact(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer) {
+    uint64_t packedID, width, height;
+    int32_t top, left;
+    uint8_t flags;
+    if (!deserializer->readVarint(&packedID) || packedID > SkPackedGlyphID::kMaskAll) return false;
+    glyph.init(SkPackedGlyphID{static_cast<uint32_t>(packedID)});
+    if (!deserializer->readUnaligned<uint8_t>(&flags)) return false;
+    glyph->fAdvanceX = glyph->fAdvanceY = 0;
+    if ((flags & kCompactHasAdvanceX) && !deserializer->readUnaligned(&glyph->fAdvanceX)) {
+        return false;
+    }
+    if ((flags & kCompactHasAdvanceY) && !deserializer->readUnaligned(&glyph->fAdvanceY)) {
+        return false;
+    }
+    if (!deserializer->readVarint(&width) || width > UINT16_MAX) return false;
+    if (!deserializer->readVarint(&height) || height > UINT16_MAX) return false;
+    if (!deserializer->readSignedVarint(&top) || !SkTFitsIn<int16_t>(top)) return false;
+    if (!deserializer->readSignedVarint(&left) || !SkTFitsIn<int16_t>(left)) return false;
+    glyph->fWidth = SkTo<uint16_t>(width);
+    glyph->fHeight = SkTo<uint16_t>(height);
+    glyph->fTop = SkTo<int16_t>(top);
+    glyph->fLeft = SkTo<int16_t>(left);
+    glyph->fMaskFormat = flags & kCompactMaskFormatMask;
+    if (!SkMask::IsValidFormat(glyph->fMaskFormat)) return false;
+
+    return true;
+}
+
 bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySize) {
     SkASSERT(memorySize != 0u);
     Deserializer deserializer(static_cast<const volatile char*>(memory), memorySize);
@@ -904,6 +1187,13 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
     uint64_t glyphPathsCount = 0;
 
     if (!deserializer.read<uint64_t>(&typefaceSize)) READ_FAILURE
+    const bool compact = (typefaceSize & kCompactWireFormatBit) != 0;
+    typefaceSize &= ~kCompactWireFormatBit;
+    auto readGlyph = [&](SkTLazy<SkGlyph>& glyph) {
+        return compact ? ReadGlyphCompact(glyph, &deserializer) : ReadGlyph(glyph, &deserializer);
+    };
+    std::vector<uint8_t> unpacked;
+
     for (size_t i = 0; i < typefaceSize; ++i) {
         WireTypeface wire;
         if (!deserializer.read<WireTypeface>(&wire)) READ_FAILURE
@@ -962,13 +1252,30 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
         if (!deserializer.read<uint64_t>(&glyphImagesCount)) READ_FAILURE
         for (size_t j = 0; j < glyphImagesCount; j++) {
             SkTLazy<SkGlyph> glyph;
-            if (!ReadGlyph(glyph, &deserializer)) READ_FAILURE
+            if (!readGlyph(glyph)) READ_FAILURE
 
             if (!glyph->isEmpty() && SkStrikeForGPU::FitsInAtlas(*glyph)) {
-                const volatile void* image =
-                        deserializer.read(glyph->imageSize(), glyph->formatAlignment());
-                if (!image) READ_FAILURE
-                glyph->fImage = (void*)image;
+                size_t imageSize = glyph->imageSize();
+                if (compact) {
+                    uint64_t packedSize;
+                    if (!deserializer.readVarint(&packedSize)) READ_FAILURE
+                    const volatile void* data =
+                            deserializer.read(packedSize ? packedSize : imageSize, 1);
+                    if (!data) READ_FAILURE
+                    if (packedSize != 0) {
+                        unpacked.resize(imageSize);
+                        auto packed = static_cast<const uint8_t*>(const_cast<const void*>(data));
+                        if (SkPackBits::Unpack8(packed, packedSize, unpacked.data(), imageSize)
+                                != SkToInt(imageSize)) READ_FAILURE
+                        data = unpacked.data();
+                    }
+                    glyph->fImage = (void*)data;
+                } else {
+                    const volatile void* image =
+                            deserializer.read(imageSize, glyph->formatAlignment());
+                    if (!image) READ_FAILURE
+                    glyph->fImage = (void*)image;
+                }
             }
 
             strike->mergeGlyphAndImage(glyph->getPackedID(), *glyph);
@@ -977,14 +1284,21 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
         if (!deserializer.read<uint64_t>(&glyphPathsCount)) READ_FAILURE
         for (size_t j = 0; j < glyphPathsCount; j++) {
             SkTLazy<SkGlyph> glyph;
-            if (!ReadGlyph(glyph, &deserializer)) READ_FAILURE
+            if (!readGlyph(glyph)) READ_FAILURE
 
             SkGlyph* allocatedGlyph = strike->mergeGlyphAndImage(glyph->getPackedID(), *glyph);
 
             SkPath* pathPtr = nullptr;
             SkPath path;
             uint64_t pathSize = 0u;
-            if (!deserializer.read<uint64_t>(&pathSize)) READ_FAILURE
+            if (compact) {
+                uint8_t hasPath;
+                if (!deserializer.readUnaligned<uint8_t>(&hasPath)) READ_FAILURE
+                if (hasPath) {
+                    if (!read_path_compact(&deserializer, &path)) READ_FAILURE
+                    pathPtr = &path;
+                }
+            } else if (!deserializer.read<uint64_t>(&pathSize)) READ_FAILURE
 
             if (pathSize > 0) {
                 auto* pathData = deserializer.read(pathSize, kPathAlignment);
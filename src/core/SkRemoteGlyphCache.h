@@ -125,6 +125,10 @@ public:
     static void AddGlyphForTesting(
             RemoteStrike* strike, SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects);
 
+    // Write the strike data in a smaller form: varint glyph metrics, run length encoded glyph
+    // images, and quantized glyph paths when that is exact. SkStrikeClient reads either form.
+    void setCompactWireFormat(bool compact) { fCompactWireFormat = compact; }
+
     void setMaxEntriesInDescriptorMapForTesting(size_t count) {
         fMaxEntriesInDescriptorMap = count;
     }
@@ -155,6 +159,7 @@ private:
     DiscardableHandleManager* const fDiscardableHandleManager;
     SkTHashSet<SkFontID> fCachedTypefaces;
     size_t fMaxEntriesInDescriptorMap = kMaxEntriesInDescriptorMap;
+    bool fCompactWireFormat = false;
 
     // Cached serialized typefaces.
     SkTHashMap<SkFontID, sk_sp<SkData>> fSerializedTypefaces;
@@ -223,6 +228,7 @@ private:
     class DiscardableStrikePinner;
 
     static bool ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer);
+    static bool ReadGlyphCompact(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer);
     sk_sp<SkTypeface> addTypeface(const WireTypeface& wire);
 
     SkTHashMap<SkFontID, sk_sp<SkTypeface>> fRemoteFontIdToTypeface;
@@ -14,6 +14,7 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkMipMap.h"
+#include "src/core/SkPathMaskCache.h"
 #include "src/core/SkOpts.h"
 
 #include <stddef.h>
@@ -568,6 +569,7 @@ size_t SkGraphics::SetResourceCacheSingleAllocationByteLimit(size_t newLimit) {
 
 void SkGraphics::PurgeResourceCache() {
     SkImageFilter_Base::PurgeCache();
+    SkPathMaskCache::PurgeAll();
     return SkResourceCache::PurgeAll();
 }
 
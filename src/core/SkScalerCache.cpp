@@ -36,6 +36,73 @@ SkScalerCache::SkScalerCache(
     SkASSERT(fScalerContext != nullptr);
 }
 
+// -- GlyphDirectory ------------------------------------------------------------------------------
+SkScalerCache::GlyphDirectory::Table::Table(int capacity)
+        : fCapacity{capacity}
+        , fSlots{new Slot[capacity]} {
+    SkASSERT(SkIsPow2(capacity));
+}
+
+SkScalerCache::GlyphDirectory::GlyphDirectory() {
+    fTables.push_back(std::make_unique<Table>(2 * kMinGlyphCount));
+    fTable.store(fTables.back().get(), std::memory_order_relaxed);
+}
+
+SkScalerCache::GlyphDirectory::~GlyphDirectory() = default;
+
+auto SkScalerCache::GlyphDirectory::FindSlot(Table* table, SkPackedGlyphID packedID) -> Slot* {
+    // The table is never more than 3/4 full, so there is always an empty slot to end the probe.
+    const int mask = table->fCapacity - 1;
+    for (int index = packedID.hash() & mask; ; index = (index + 1) & mask) {
+        Slot* slot = &table->fSlots[index];
+        SkGlyph* glyph = slot->fGlyph.load(std::memory_order_acquire);
+        if (glyph == nullptr || glyph->getPackedID() == packedID) {
+            return slot;
+        }
+    }
+}
+
+SkGlyph* SkScalerCache::GlyphDirectory::find(SkPackedGlyphID packedID, uint32_t needs) const {
+    Slot* slot = FindSlot(fTable.load(std::memory_order_acquire), packedID);
+    SkGlyph* glyph = slot->fGlyph.load(std::memory_order_acquire);
+    if (glyph == nullptr || (slot->fReady.load(std::memory_order_acquire) & needs) != needs) {
+        return nullptr;
+    }
+    return glyph;
+}
+
+void SkScalerCache::GlyphDirectory::publish(SkGlyph* glyph, uint32_t ready) {
+    Table* table = fTable.load(std::memory_order_relaxed);
+    Slot* slot = FindSlot(table, glyph->getPackedID());
+    if (slot->fGlyph.load(std::memory_order_relaxed) != nullptr) {
+        slot->fReady.fetch_or(ready, std::memory_order_release);
+        return;
+    }
+
+    if (4 * (table->fCount + 1) > 3 * table->fCapacity) {
+        // Readers may still be using the old table, so build a new one and swap it in.
+        fTables.push_back(std::make_unique<Table>(2 * table->fCapacity));
+        Table* grown = fTables.back().get();
+        for (int i = 0; i < table->fCapacity; i++) {
+            const Slot& from = table->fSlots[i];
+            if (SkGlyph* g = from.fGlyph.load(std::memory_order_relaxed)) {
+                Slot* to = FindSlot(grown, g->getPackedID());
+                to->fReady.store(from.fReady.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+                to->fGlyph.store(g, std::memory_order_relaxed);
+                grown->fCount++;
+            }
+        }
+        fTable.store(grown, std::memory_order_release);
+        table = grown;
+        slot = FindSlot(table, glyph->getPackedID());
+    }
+
+    slot->fReady.store(ready, std::memory_order_relaxed);
+    slot->fGlyph.store(glyph, std::memory_order_release);
+    table->fCount++;
+}
+
 // -- glyph creation -------------------------------------------------------------------------------
 std::tuple<SkGlyph*, size_t> SkScalerCache::makeGlyph(SkPackedGlyphID packedGlyphID) {
     SkGlyph* glyph = fAlloc.make<SkGlyph>(packedGlyphID);
@@ -49,6 +116,7 @@ std::tuple<SkGlyph*, size_t> SkScalerCache::glyph(SkPackedGlyphID packedGlyphID)
     if (glyph == nullptr) {
         std::tie(glyph, bytes) = this->makeGlyph(packedGlyphID);
         fScalerContext->getMetrics(glyph);
+        fDirectory.publish(glyph, kMetricsReady);
     }
     return {glyph, bytes};
 }
@@ -58,6 +126,7 @@ std::tuple<const SkPath*, size_t> SkScalerCache::preparePath(SkGlyph* glyph) {
     if (glyph->setPath(&fAlloc, fScalerContext.get())) {
         delta = glyph->path()->approximateBytesUsed();
     }
+    fDirectory.publish(glyph, kPathReady);
     return {glyph->path(), delta};
 }
 
@@ -67,6 +136,7 @@ std::tuple<const SkPath*, size_t> SkScalerCache::mergePath(SkGlyph* glyph, const
     if (glyph->setPath(&fAlloc, path)) {
         pathDelta = glyph->path()->approximateBytesUsed();
     }
+    fDirectory.publish(glyph, kPathReady);
     return {glyph->path(), pathDelta};
 }
 
@@ -101,6 +171,7 @@ std::tuple<const void*, size_t> SkScalerCache::prepareImage(SkGlyph* glyph) {
     if (glyph->setImage(&fAlloc, fScalerContext.get())) {
         delta = glyph->imageSize();
     }
+    fDirectory.publish(glyph, kImageReady);
     return {glyph->image(), delta};
 }
 
@@ -116,11 +187,22 @@ std::tuple<SkGlyph*, size_t> SkScalerCache::mergeGlyphAndImage(
     if (glyph->setMetricsAndImage(&fAlloc, from)) {
         imageDelta= glyph->imageSize();
     }
+    fDirectory.publish(
+            glyph, glyph->setImageHasBeenCalled() ? kMetricsReady | kImageReady : kMetricsReady);
     return {glyph, delta + imageDelta};
 }
 
 std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::metrics(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    size_t i = 0;
+    for (; i < glyphIDs.size(); i++) {
+        results[i] = fDirectory.find(SkPackedGlyphID{glyphIDs[i]}, kMetricsReady);
+        if (results[i] == nullptr) { break; }
+    }
+    if (i == glyphIDs.size()) {
+        return {{results, glyphIDs.size()}, 0};
+    }
+
     SkAutoMutexExclusive lock{fMu};
     auto [glyphs, delta] = this->internalPrepare(glyphIDs, kMetricsOnly, results);
     return {glyphs, delta};
@@ -128,6 +210,15 @@ std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::metrics(
 
 std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::preparePaths(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    size_t i = 0;
+    for (; i < glyphIDs.size(); i++) {
+        results[i] = fDirectory.find(SkPackedGlyphID{glyphIDs[i]}, kMetricsReady | kPathReady);
+        if (results[i] == nullptr) { break; }
+    }
+    if (i == glyphIDs.size()) {
+        return {{results, glyphIDs.size()}, 0};
+    }
+
     SkAutoMutexExclusive lock{fMu};
     auto [glyphs, delta] = this->internalPrepare(glyphIDs, kMetricsAndPath, results);
     return {glyphs, delta};
@@ -135,6 +226,15 @@ std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::preparePaths(
 
 std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
+    size_t i = 0;
+    for (; i < glyphIDs.size(); i++) {
+        results[i] = fDirectory.find(glyphIDs[i], kMetricsReady | kImageReady);
+        if (results[i] == nullptr) { break; }
+    }
+    if (i == glyphIDs.size()) {
+        return {{results, glyphIDs.size()}, 0};
+    }
+
     const SkGlyph** cursor = results;
     SkAutoMutexExclusive lock{fMu};
     size_t delta = 0;
@@ -163,18 +263,72 @@ size_t SkScalerCache::commonFilterLoop(SkDrawableGlyphBuffer* drawables, Fn&& fn
     return total;
 }
 
+template <typename Fn>
+bool SkScalerCache::directoryFilterLoop(
+        SkDrawableGlyphBuffer* drawables, uint32_t needs, Fn&& fn) const {
+    // Empty glyphs, like spaces, are never passed to fn, so they only need their metrics.
+    auto find = [&](SkPackedGlyphID packedID) -> SkGlyph* {
+        SkGlyph* glyph = fDirectory.find(packedID, kMetricsReady);
+        return glyph == nullptr || glyph->isEmpty() ? glyph : fDirectory.find(packedID, needs);
+    };
+
+    // Check every glyph before calling fn, because fn compacts drawables as it goes and can't be
+    // restarted under the lock.
+    for (auto [packedID, pos] : drawables->peekInput()) {
+        if (SkScalarsAreFinite(pos.x(), pos.y()) && find(packedID) == nullptr) {
+            return false;
+        }
+    }
+    for (auto [i, packedID, pos] : SkMakeEnumerate(drawables->input())) {
+        if (SkScalarsAreFinite(pos.x(), pos.y())) {
+            SkGlyph* glyph = find(packedID);
+            if (!glyph->isEmpty()) {
+                fn(i, glyph, pos);
+            }
+        }
+    }
+    return true;
+}
+
 size_t SkScalerCache::prepareForDrawingMasksCPU(SkDrawableGlyphBuffer* drawables) {
+    int hits = 0,
+        misses = 0;
+    if (this->directoryFilterLoop(drawables, kMetricsReady | kImageReady | kAtlasReady,
+            [&](size_t i, SkGlyph* glyph, SkPoint pos) {
+                if (glyph->image() != nullptr) {
+                    drawables->push_back(glyph, i);
+                    if (SkGlyphAtlas::Contains(*glyph)) {
+                        hits++;
+                    } else {
+                        misses++;
+                    }
+                }
+            })) {
+        fAtlas.recordHits(hits);
+        fAtlas.recordMisses(misses);
+        return 0;
+    }
+
     SkAutoMutexExclusive lock{fMu};
     size_t imageDelta = 0;
     size_t delta = this->commonFilterLoop(drawables,
         [&](size_t i, SkGlyph* glyph, SkPoint pos) SK_REQUIRES(fMu) {
-            // If the glyph is too large, then no image is created.
+            // If the glyph is too large, then no image is created. It is still marked as offered
+            // to the atlas so later draws of the run don't need the lock.
             auto [image, imageSize] = this->prepareImage(glyph);
+            if (fDirectory.find(glyph->getPackedID(), kAtlasReady) == nullptr) {
+                if (image != nullptr) {
+                    imageDelta += fAtlas.add(glyph);
+                }
+                fDirectory.publish(glyph, kAtlasReady);
+            }
             if (image != nullptr) {
                 drawables->push_back(glyph, i);
                 imageDelta += imageSize;
+                misses++;
             }
         });
+    fAtlas.recordMisses(misses);
 
     return delta + imageDelta;
 }
@@ -182,36 +336,55 @@ size_t SkScalerCache::prepareForDrawingMasksCPU(SkDrawableGlyphBuffer* drawables
 // Note: this does not actually fill out the image. That happens at atlas building time.
 size_t SkScalerCache::prepareForMaskDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    auto maskOrReject = [&](size_t i, SkGlyph* glyph, SkPoint pos) {
+        if (SkStrikeForGPU::CanDrawAsMask(*glyph)) {
+            drawables->push_back(glyph, i);
+        } else {
+            rejects->reject(i);
+        }
+    };
+    if (this->directoryFilterLoop(drawables, kMetricsReady, maskOrReject)) {
+        return 0;
+    }
+
     SkAutoMutexExclusive lock{fMu};
-    size_t delta = this->commonFilterLoop(drawables,
-        [&](size_t i, SkGlyph* glyph, SkPoint pos) {
-            if (SkStrikeForGPU::CanDrawAsMask(*glyph)) {
-                drawables->push_back(glyph, i);
-            } else {
-                rejects->reject(i);
-            }
-        });
+    size_t delta = this->commonFilterLoop(drawables, maskOrReject);
 
     return delta;
 }
 
 size_t SkScalerCache::prepareForSDFTDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    auto sdftOrReject = [&](size_t i, SkGlyph* glyph, SkPoint pos) {
+        if (SkStrikeForGPU::CanDrawAsSDFT(*glyph)) {
+            drawables->push_back(glyph, i);
+        } else {
+            rejects->reject(i);
+        }
+    };
+    if (this->directoryFilterLoop(drawables, kMetricsReady, sdftOrReject)) {
+        return 0;
+    }
+
     SkAutoMutexExclusive lock{fMu};
-    size_t delta = this->commonFilterLoop(drawables,
-        [&](size_t i, SkGlyph* glyph, SkPoint pos) {
-            if (SkStrikeForGPU::CanDrawAsSDFT(*glyph)) {
-                drawables->push_back(glyph, i);
-            } else {
-                rejects->reject(i);
-            }
-        });
+    size_t delta = this->commonFilterLoop(drawables, sdftOrReject);
 
     return delta;
 }
 
 size_t SkScalerCache::prepareForPathDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    if (this->directoryFilterLoop(drawables, kMetricsReady | kPathReady,
+            [&](size_t i, SkGlyph* glyph, SkPoint pos) {
+                if (!glyph->isColor() && glyph->path() != nullptr) {
+                    drawables->push_back(glyph->path(), i);
+                } else {
+                    rejects->reject(i, glyph->maxDimension());
+                }
+            })) {
+        return 0;
+    }
+
     SkAutoMutexExclusive lock{fMu};
     size_t pathDelta = 0;
     size_t delta = this->commonFilterLoop(drawables,
@@ -241,6 +414,17 @@ void SkScalerCache::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkS
     glyph->ensureIntercepts(bounds, scale, xPos, array, count, &fAlloc);
 }
 
+void SkScalerCache::dumpAtlasMemoryStatistics(
+        SkTraceMemoryDump* dump, const char* dumpName) const {
+    SkAutoMutexExclusive lock{fMu};
+    fAtlas.dumpMemoryStatistics(dump, dumpName);
+}
+
+void SkScalerCache::forEachGlyph(const std::function<void(const SkGlyph&)>& visitor) const {
+    SkAutoMutexExclusive lock{fMu};
+    fGlyphMap.foreach([&](const SkGlyph* glyph) { visitor(*glyph); });
+}
+
 void SkScalerCache::dump() const {
     SkAutoMutexExclusive lock{fMu};
     const SkTypeface* face = fScalerContext->getTypeface();
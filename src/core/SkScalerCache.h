@@ -15,11 +15,16 @@
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkDescriptor.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphAtlas.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkStrikeForGPU.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <vector>
 
 class SkScalerContext;
+class SkTraceMemoryDump;
 
 // This class represents a strike: a specific combination of typeface, size, matrix, etc., and
 // holds the glyphs for that strike.
@@ -34,6 +39,9 @@ public:
     // an image, then use the information in from to initialize the width, height top, left,
     // format and image of the toGlyph. This is mainly used preserving the glyph if it was
     // created by a search of desperation.
+    // Because this may rewrite the metrics of an existing glyph, it must only be called while no
+    // other thread is drawing from this cache; SkStrikeClient does this before the draws that
+    // use the strike are played back.
     std::tuple<SkGlyph*, size_t> mergeGlyphAndImage(
             SkPackedGlyphID toID, const SkGlyph& from) SK_EXCLUDES(fMu);
 
@@ -63,6 +71,8 @@ public:
     std::tuple<SkSpan<const SkGlyph*>, size_t> prepareImages(
             SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fMu);
 
+    // Fill drawables with the glyphs that have images, packing the images into fAtlas the first
+    // time they are drawn. Draw them using SkGlyph::atlasMask().
     size_t prepareForDrawingMasksCPU(SkDrawableGlyphBuffer* drawables) SK_EXCLUDES(fMu);
 
     // SkStrikeForGPU APIs
@@ -83,6 +93,12 @@ public:
 
     void dump() const SK_EXCLUDES(fMu);
 
+    void dumpAtlasMemoryStatistics(SkTraceMemoryDump* dump, const char* dumpName) const
+            SK_EXCLUDES(fMu);
+
+    // Call visitor with each cached glyph while holding the cache's lock.
+    void forEachGlyph(const std::function<void(const SkGlyph&)>& visitor) const SK_EXCLUDES(fMu);
+
     SkScalerContext* getScalerContext() const { return fScalerContext.get(); }
 
 private:
@@ -96,6 +112,55 @@ private:
         }
     };
 
+    // What part of a glyph is known to be complete, and may be read without holding fMu.
+    enum GlyphReady : uint32_t {
+        kMetricsReady = 1 << 0,
+        kImageReady   = 1 << 1,
+        kPathReady    = 1 << 2,
+        // fAtlas has been offered the glyph's image, whether or not it was packed or there was
+        // an image to pack.
+        kAtlasReady   = 1 << 3,
+    };
+
+    // An append-only open addressing table of the glyphs in fGlyphMap, which can be searched
+    // without taking fMu. Glyphs are only published after the parts marked ready have been
+    // written, and are never removed, so a lookup either finds a usable glyph or misses and the
+    // caller falls back to the locked path. Superseded tables are kept alive until the cache is
+    // destroyed because a reader may still be probing them.
+    class GlyphDirectory {
+    public:
+        GlyphDirectory();
+        ~GlyphDirectory();
+
+        // Return the glyph if it has been published with all of the ready bits in needs.
+        SkGlyph* find(SkPackedGlyphID packedID, uint32_t needs) const;
+
+        // Must be called with the owning cache's lock held.
+        void publish(SkGlyph* glyph, uint32_t ready);
+
+    private:
+        struct Slot {
+            std::atomic<SkGlyph*> fGlyph{nullptr};
+            std::atomic<uint32_t> fReady{0};
+        };
+        struct Table {
+            explicit Table(int capacity);
+            const int fCapacity;
+            int fCount{0};
+            std::unique_ptr<Slot[]> fSlots;
+        };
+
+        static Slot* FindSlot(Table* table, SkPackedGlyphID packedID);
+
+        std::atomic<Table*> fTable;
+        std::vector<std::unique_ptr<Table>> fTables;
+    };
+
+    // Lock free versions of the drawing loops. They return false without changing drawables or
+    // rejects if any glyph is not already in fDirectory with the needed parts.
+    template <typename Fn>
+    bool directoryFilterLoop(SkDrawableGlyphBuffer* drawables, uint32_t needs, Fn&& fn) const;
+
     std::tuple<SkGlyph*, size_t> makeGlyph(SkPackedGlyphID) SK_REQUIRES(fMu);
 
     template <typename Fn>
@@ -133,6 +198,14 @@ private:
     // unchanging pointer as long as the strike is alive.
     SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap SK_GUARDED_BY(fMu);
 
+    // Glyphs from fGlyphMap that are ready to be used without fMu. Readers do not lock; all
+    // writes happen with fMu held.
+    GlyphDirectory fDirectory;
+
+    // Copies of the glyph images used by the raster backend. Glyphs are only added with fMu
+    // held; the hit and miss counts are updated without it.
+    SkGlyphAtlas fAtlas;
+
     // so we don't grow our arrays a lot
     static constexpr size_t kMinGlyphCount = 8;
     static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
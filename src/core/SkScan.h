@@ -9,6 +9,7 @@
 #ifndef SkScan_DEFINED
 #define SkScan_DEFINED
 
+#include "include/core/SkPathEffect.h"
 #include "include/core/SkRect.h"
 #include "include/private/SkFixed.h"
 #include <atomic>
@@ -16,7 +17,9 @@
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
+class SkMatrix;
 class SkPath;
+class SkStrokeRec;
 
 /** Defines a fixed-point rectangle, identical to the integer SkIRect, but its
     coordinates are treated as SkFixed rather than int32_t.
@@ -25,6 +28,8 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
+extern std::atomic<bool> gSkUseSparseAA;
+extern std::atomic<bool> gSkForceSparseAA;
 
 class AdditiveBlitter;
 
@@ -67,6 +72,16 @@ public:
     static void HairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiHairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
 
+    /**
+     *  Anti-aliases the stroke of path, which must only have lines, mapped by matrix, which must
+     *  be a similarity. The stroke is optionally dashed by dash. The outline of the stroke is
+     *  sent to the sparse tile filler a piece at a time, instead of being built as a path.
+     *  Returns false, without drawing anything, if the stroke has too many dashes.
+     */
+    static bool SparseAAStrokePath(const SkPath&, const SkMatrix&, const SkStrokeRec&,
+                                   const SkPathEffect::DashInfo* dash, const SkRasterClip&,
+                                   SkBlitter*);
+
     // Needed by do_fill_path in SkScanPriv.h
     static void FillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
 
@@ -90,6 +105,8 @@ private:
                             const SkIRect& clipBounds, bool forceRLE);
     static void SAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    static void SparseAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                 const SkIRect& clipBounds);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
@@ -672,6 +672,25 @@ static bool ShouldUseAAA(const SkPath& path, SkScalar avgLength, SkScalar comple
 #endif
 }
 
+// Paths with fewer points than this are filled quickly enough by scanning their edges that
+// binning them into tiles doesn't pay off.
+constexpr int kSparseMinPoints = 2048;
+
+static bool ShouldUseSparseAA(const SkPath& path, const SkIRect& ir) {
+    // Inverse fills are left to the scanline algorithms, which cover the clip outside the path.
+    if (path.isInverseFillType()) {
+        return false;
+    }
+    if (gSkForceSparseAA) {
+        return true;
+    }
+    if (!gSkUseSparseAA) {
+        return false;
+    }
+    // A short path doesn't have enough bands of tiles to spread over threads.
+    return path.countPoints() >= kSparseMinPoints && ir.height() >= 64;
+}
+
 void SkScan::SAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& ir,
                   const SkIRect& clipBounds, bool forceRLE) {
     bool containedInClip = clipBounds.contains(ir);
@@ -786,7 +805,9 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     SkScalar avgLength, complexity;
     compute_complexity(path, avgLength, complexity);
 
-    if (ShouldUseAAA(path, avgLength, complexity)) {
+    if (ShouldUseSparseAA(path, ir)) {
+        SkScan::SparseAAFillPath(path, blitter, ir, clipRgn->getBounds());
+    } else if (ShouldUseAAA(path, avgLength, complexity)) {
         // Do not use AAA if path is too complicated:
         // there won't be any speedup or significant visual improvement.
         SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
@@ -0,0 +1,975 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkStrokeRec.h"
+#include "include/private/SkTemplates.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkAAClip.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkScanPriv.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/utils/SkDashPathPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/*
+
+Sparse tile anti-aliasing
+
+Supersampling (SkScan_AntiPath) and analytic AA (SkScan_AAAPath) both walk a sorted list of
+active edges down the path one scanline at a time, so their cost grows with the number of edges
+times the number of rows, and a single path can only be filled by a single thread. For paths
+with thousands of edges (maps, charts, text converted to paths) that is the slowest way to fill.
+
+This algorithm instead flattens the path into lines, clips them to the bounds, and cuts them
+into pieces along a grid of 16x16 tiles. Each tile that any piece touches is resolved by
+accumulating the signed area each piece covers in each pixel of the tile, and taking a running
+sum across each row: the sum is the winding number, and its fractional part is the coverage of
+pixels an edge passes through. Tiles that no piece touches are never visited; the running sum
+at the right edge of a touched tile is the coverage of every pixel until the next touched tile
+in the same rows. Like AAA, the coverage is only approximate in pixels where edges cross.
+
+Each band of tiles only depends on its own pieces, so the bands are resolved in parallel on an
+SkTaskGroup. Blitting happens afterward on the calling thread, one row at a time and left to
+right, as the blitters expect.
+
+Since the lines are never sorted into a path, strokes of polylines can be sent to the same tiles
+without building their outline. The stroke is cut into convex pieces: a trapezoid for each side
+of each segment, and a triangle, quad or wedge of a circle for each join and cap. The pieces are
+all wound the same way and share their edges, so the winding is one inside the stroke, and where
+they do overlap nonzero filling still covers their union. Dashes are cut from the polyline as it
+is walked.
+
+*/
+
+namespace {
+
+constexpr int kTileShift = 4;
+constexpr int kTileSize  = 1 << kTileShift;
+
+// Curves are flattened into lines no further than this from the curve, in pixels. The lines all
+// fall on the same side of the curve, so their error adds up along its whole edge.
+constexpr SkScalar kFlattenTolerance = 1.0f / 16;
+constexpr int      kMaxCurveLines    = 256;
+
+// A line clipped to one tile, in coordinates relative to the top left of the tile.
+struct Piece {
+    int   fTileX;
+    float fX0, fY0, fX1, fY1;
+};
+
+// The coverage of one tile, and the running sum leaving its right edge on each row.
+struct ResolvedTile {
+    int     fTileX;
+    SkAlpha fAlpha[kTileSize][kTileSize];
+    float   fCarry[kTileSize];
+};
+
+// Clip the line (a0, b0)-(a1, b1) to lo <= a <= hi. Returns false if nothing is left.
+bool clip_to_range(float* a0, float* b0, float* a1, float* b1, float lo, float hi) {
+    if (std::max(*a0, *a1) <= lo || std::min(*a0, *a1) >= hi) {
+        return false;
+    }
+    float ca0 = SkTPin(*a0, lo, hi),
+          ca1 = SkTPin(*a1, lo, hi);
+    float slope = (*b1 - *b0) / (*a1 - *a0);
+    float cb0 = *b0 + (ca0 - *a0) * slope,
+          cb1 = *b1 + (ca1 - *a1) * slope;
+    *a0 = ca0; *b0 = cb0;
+    *a1 = ca1; *b1 = cb1;
+    return ca0 != ca1;
+}
+
+// Add the signed area that the piece covers in each pixel of its tile to cells. The area of a
+// pixel is spread over its own cell and the cells to its right, so that the running sum across a
+// row is the coverage. Lines going down count positive, lines going up count negative.
+void accumulate(const Piece& piece, float cells[kTileSize][kTileSize + 2]) {
+    float x0 = piece.fX0, y0 = piece.fY0,
+          x1 = piece.fX1, y1 = piece.fY1;
+    float dir = 1;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1;
+    }
+    if (y0 == y1) {
+        return;
+    }
+
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    const int bottom = std::min(kTileSize, (int)std::ceil(y1));
+    float x = x0;
+    for (int y = (int)y0; y < bottom; y++) {
+        float dy = std::min((float)(y + 1), y1) - std::max((float)y, y0);
+        float xNext = SkTPin(x + dxdy * dy, 0.0f, (float)kTileSize);
+        float d = dy * dir;
+        float* row = cells[y];
+
+        float l = std::min(x, xNext),
+              r = std::max(x, xNext);
+        float lFloor = std::floor(l),
+              rCeil  = std::ceil(r);
+        int li = (int)lFloor,
+            ri = (int)rCeil;
+        if (ri <= li + 1) {
+            // The line stays in one pixel in this row.
+            float xm = 0.5f * (x + xNext) - lFloor;
+            row[li]     += d - d * xm;
+            row[li + 1] += d * xm;
+        } else {
+            // A triangle in the first pixel, trapezoids in the middle, and the rest of the area
+            // in the last pixel.
+            float s  = 1 / (r - l);
+            float lf = l - lFloor;
+            float a0 = 0.5f * s * (1 - lf) * (1 - lf);
+            float rf = r - rCeil + 1;
+            float am = 0.5f * s * rf * rf;
+            row[li] += d * a0;
+            if (ri == li + 2) {
+                row[li + 1] += d * (1 - a0 - am);
+            } else {
+                float a1 = s * (1.5f - lf);
+                row[li + 1] += d * (a1 - a0);
+                for (int xi = li + 2; xi < ri - 1; xi++) {
+                    row[xi] += d * s;
+                }
+                float a2 = a1 + (ri - li - 3) * s;
+                row[ri - 1] += d * (1 - a2 - am);
+            }
+            row[ri] += d * am;
+        }
+        x = xNext;
+    }
+}
+
+class SparseRasterizer {
+public:
+    SparseRasterizer(const SkIRect& bounds, bool evenOdd)
+            : fBounds(bounds)
+            , fTilesWide((bounds.width() + kTileSize - 1) >> kTileShift)
+            , fEvenOdd(evenOdd)
+            , fBands((bounds.height() + kTileSize - 1) >> kTileShift)
+            , fResolved(fBands.size()) {}
+
+    void addPath(const SkPath& path) {
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkAutoConicToQuads quadder;
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kLine_Verb:
+                    this->addLine(pts[0], pts[1]);
+                    break;
+                case SkPath::kQuad_Verb:
+                    this->addQuad(pts);
+                    break;
+                case SkPath::kConic_Verb: {
+                    // Each split of a conic quarters the error of its quads, so more quads are
+                    // cheap. Leave nearly all of the tolerance to the lines.
+                    const SkPoint* quads =
+                            quadder.computeQuads(pts, iter.conicWeight(), kFlattenTolerance / 8);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addQuad(quads + 2 * i);
+                    }
+                    break;
+                }
+                case SkPath::kCubic_Verb:
+                    this->addCubic(pts);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Add a convex polygon, wound the same way as every other polygon added here, so that
+    // filling covers the union of the polygons.
+    void addConvexPolygon(const SkPoint pts[], int count) {
+        SkScalar area = 0;
+        for (int i = 1; i + 1 < count; ++i) {
+            area += (pts[i] - pts[0]).cross(pts[i + 1] - pts[0]);
+        }
+        if (area > 0) {
+            for (int i = 0, j = count - 1; i < count; j = i++) {
+                this->addLine(pts[j], pts[i]);
+            }
+        } else if (area < 0) {
+            for (int i = 0, j = count - 1; i < count; j = i++) {
+                this->addLine(pts[i], pts[j]);
+            }
+        }
+    }
+
+    void resolve() {
+        SkTaskGroup().batch(SkToInt(fBands.size()), [this](int band) {
+            this->resolveBand(band);
+        });
+    }
+
+    void blit(SkBlitter* blitter) const {
+        const int width = fBounds.width();
+        SkAutoTMalloc<SkAlpha> alphas(width + 1);
+        SkAutoTMalloc<int16_t> runs(width + 1);
+
+        for (size_t band = 0; band < fResolved.size(); ++band) {
+            const std::vector<ResolvedTile>& tiles = fResolved[band];
+            if (tiles.empty()) {
+                continue;
+            }
+            const int top = fBounds.fTop + SkToInt(band << kTileShift);
+            const int rows = std::min(kTileSize, fBounds.fBottom - top);
+            for (int row = 0; row < rows; ++row) {
+                int x = 0;
+                int lastRun = -1;
+                bool covered = false;
+                auto addRun = [&](int len, SkAlpha alpha) {
+                    if (len <= 0) {
+                        return;
+                    }
+                    covered |= alpha != 0;
+                    if (lastRun >= 0 && alphas[lastRun] == alpha) {
+                        runs[lastRun] += len;
+                    } else {
+                        lastRun = x;
+                        runs[x] = len;
+                        alphas[x] = alpha;
+                    }
+                    x += len;
+                };
+
+                float carry = 0;
+                for (const ResolvedTile& tile : tiles) {
+                    const int tileLeft = tile.fTileX << kTileShift;
+                    addRun(tileLeft - x, this->toAlpha(carry));
+                    const int count = std::min(kTileSize, width - tileLeft);
+                    for (int i = 0; i < count; ++i) {
+                        addRun(1, tile.fAlpha[row][i]);
+                    }
+                    carry = tile.fCarry[row];
+                }
+                addRun(width - x, this->toAlpha(carry));
+                runs[width] = 0;
+
+                if (covered) {
+                    blitter->blitAntiH(fBounds.fLeft, top + row, alphas, runs);
+                }
+            }
+        }
+    }
+
+private:
+    SkAlpha toAlpha(float winding) const {
+        float coverage = std::abs(winding);
+        if (fEvenOdd) {
+            coverage -= 2 * std::floor(coverage * 0.5f);
+            coverage = coverage > 1 ? 2 - coverage : coverage;
+        } else {
+            coverage = std::min(coverage, 1.0f);
+        }
+        return SkTo<SkAlpha>((int)(coverage * 255 + 0.5f));
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        // The distance from a quad to n lines between points on it is at most |dd| / (8 n^2).
+        SkVector dd = pts[0] - pts[1] - pts[1] + pts[2];
+        int n = SkTPin((int)std::ceil(std::sqrt(dd.length() / (8 * kFlattenTolerance))),
+                       1, kMaxCurveLines);
+        SkQuadCoeff coeff(pts);
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; ++i) {
+            SkPoint next = to_point(coeff.eval(i * (1.0f / n)));
+            this->addLine(prev, next);
+            prev = next;
+        }
+        this->addLine(prev, pts[2]);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        // The distance from a cubic to n lines between points on it is at most 3 M / (4 n^2),
+        // where M is the larger second difference of its control points.
+        SkVector dd0 = pts[0] - pts[1] - pts[1] + pts[2],
+                 dd1 = pts[1] - pts[2] - pts[2] + pts[3];
+        SkScalar m = std::max(dd0.length(), dd1.length());
+        int n = SkTPin((int)std::ceil(std::sqrt(0.75f * m / kFlattenTolerance)),
+                       1, kMaxCurveLines);
+        SkCubicCoeff coeff(pts);
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; ++i) {
+            SkPoint next = to_point(coeff.eval(i * (1.0f / n)));
+            this->addLine(prev, next);
+            prev = next;
+        }
+        this->addLine(prev, pts[3]);
+    }
+
+    // Clip the line to the bounds, and add it relative to the top left of the bounds.
+    void addLine(SkPoint p0, SkPoint p1) {
+        const float width  = fBounds.width(),
+                    height = fBounds.height();
+        float x0 = p0.fX - fBounds.fLeft, y0 = p0.fY - fBounds.fTop,
+              x1 = p1.fX - fBounds.fLeft, y1 = p1.fY - fBounds.fTop;
+        if (y0 == y1 || !clip_to_range(&y0, &x0, &y1, &x1, 0, height)) {
+            return;
+        }
+
+        // Whatever is left of the bounds still changes the winding of the pixels to its right,
+        // so it becomes a vertical line on the left edge.
+        if (x0 < 0 || x1 < 0) {
+            if (x0 <= 0 && x1 <= 0) {
+                this->addClippedLine(0, y0, 0, y1);
+                return;
+            }
+            float y = y0 + (0 - x0) * (y1 - y0) / (x1 - x0);
+            if (x0 < 0) {
+                this->addClippedLine(0, y0, 0, y);
+                x0 = 0;
+                y0 = y;
+            } else {
+                this->addClippedLine(0, y, 0, y1);
+                x1 = 0;
+                y1 = y;
+            }
+        }
+
+        // Whatever is right of the bounds doesn't cover anything.
+        if (x0 >= width && x1 >= width) {
+            return;
+        }
+        if (x0 > width || x1 > width) {
+            float y = y0 + (width - x0) * (y1 - y0) / (x1 - x0);
+            if (x0 > width) {
+                x0 = width;
+                y0 = y;
+            } else {
+                x1 = width;
+                y1 = y;
+            }
+        }
+        this->addClippedLine(x0, y0, x1, y1);
+    }
+
+    // Cut a line inside the bounds into a piece for each tile it crosses.
+    void addClippedLine(float x0, float y0, float x1, float y1) {
+        if (y0 == y1) {
+            return;
+        }
+        const int firstBand = (int)(std::min(y0, y1)) >> kTileShift,
+                  lastBand  = std::min(SkToInt(fBands.size()),
+                                       ((int)std::ceil(std::max(y0, y1)) + kTileSize - 1)
+                                               >> kTileShift);
+        for (int band = firstBand; band < lastBand; ++band) {
+            float bx0 = x0, by0 = y0,
+                  bx1 = x1, by1 = y1;
+            const float bandTop = (float)(band << kTileShift);
+            if (!clip_to_range(&by0, &bx0, &by1, &bx1, bandTop, bandTop + kTileSize)) {
+                continue;
+            }
+            by0 -= bandTop;
+            by1 -= bandTop;
+
+            if (bx0 == bx1) {
+                this->addPiece(band, (int)bx0 >> kTileShift, bx0, by0, bx1, by1);
+                continue;
+            }
+            const int firstTile = (int)(std::min(bx0, bx1)) >> kTileShift,
+                      lastTile  = ((int)std::ceil(std::max(bx0, bx1)) + kTileSize - 1)
+                                  >> kTileShift;
+            for (int tile = firstTile; tile < lastTile; ++tile) {
+                float tx0 = bx0, ty0 = by0,
+                      tx1 = bx1, ty1 = by1;
+                const float tileLeft = (float)(tile << kTileShift);
+                if (clip_to_range(&tx0, &ty0, &tx1, &ty1, tileLeft, tileLeft + kTileSize)) {
+                    this->addPiece(band, tile, tx0, ty0, tx1, ty1);
+                }
+            }
+        }
+    }
+
+    void addPiece(int band, int tileX, float x0, float y0, float x1, float y1) {
+        // Lines on the right edge of the bounds don't cover anything.
+        if (tileX >= fTilesWide || y0 == y1) {
+            return;
+        }
+        const float tileLeft = (float)(tileX << kTileShift);
+        auto pinX = [&](float x) { return SkTPin(x - tileLeft, 0.0f, (float)kTileSize); };
+        auto pinY = [&](float y) { return SkTPin(y, 0.0f, (float)kTileSize); };
+        fBands[band].push_back({tileX, pinX(x0), pinY(y0), pinX(x1), pinY(y1)});
+    }
+
+    void resolveBand(int band) {
+        std::vector<Piece> pieces = std::move(fBands[band]);
+        std::sort(pieces.begin(), pieces.end(), [](const Piece& a, const Piece& b) {
+            return a.fTileX < b.fTileX;
+        });
+
+        std::vector<ResolvedTile>& resolved = fResolved[band];
+        float carry[kTileSize] = {};
+        // Two extra cells for the area right of the tile; it only adds to the carry.
+        float cells[kTileSize][kTileSize + 2];
+        for (size_t i = 0; i < pieces.size();) {
+            const int tileX = pieces[i].fTileX;
+            memset(cells, 0, sizeof(cells));
+            for (; i < pieces.size() && pieces[i].fTileX == tileX; ++i) {
+                accumulate(pieces[i], cells);
+            }
+
+            resolved.emplace_back();
+            ResolvedTile& tile = resolved.back();
+            tile.fTileX = tileX;
+            for (int row = 0; row < kTileSize; ++row) {
+                float winding = carry[row];
+                for (int col = 0; col < kTileSize; ++col) {
+                    winding += cells[row][col];
+                    tile.fAlpha[row][col] = this->toAlpha(winding);
+                }
+                winding += cells[row][kTileSize] + cells[row][kTileSize + 1];
+                carry[row] = tile.fCarry[row] = winding;
+            }
+        }
+    }
+
+    const SkIRect fBounds;
+    const int     fTilesWide;
+    const bool    fEvenOdd;
+
+    // The pieces in each band of tiles, in the order they were added.
+    std::vector<std::vector<Piece>> fBands;
+    // The touched tiles of each band, from left to right.
+    std::vector<std::vector<ResolvedTile>> fResolved;
+};
+
+// Round joins and caps are split into at most this many lines, each within kFlattenTolerance of
+// the circle.
+constexpr int kMaxArcLines = 64;
+
+SkVector perp(const SkVector& v) {
+    return {v.fY, -v.fX};
+}
+
+// Sends the outline of stroked polylines to a SparseRasterizer as convex pieces. Each side of
+// each segment is a trapezoid between the segment and its offset. On the inside of a turn the
+// trapezoids of both segments end on the line from the point to where their offsets meet, and on
+// the outside they end square, with the join filling the gap. The pieces share their edges, so
+// they cover the stroke once, except at turns too sharp for the segments' lengths, where the
+// inside ends stay square and overlap instead.
+class PolylineStroker {
+public:
+    PolylineStroker(SparseRasterizer* rasterizer, SkScalar radius, SkPaint::Cap cap,
+                    SkPaint::Join join, SkScalar miterLimit, SkVector upright)
+            : fRasterizer(rasterizer)
+            , fRadius(radius)
+            , fCap(cap)
+            , fJoin(join)
+            , fUpright(upright) {
+        if (join == SkPaint::kMiter_Join) {
+            if (miterLimit <= 1) {
+                fJoin = SkPaint::kBevel_Join;
+            } else {
+                // The miter is 1 / cos(half the turn) times the radius, and
+                // cos^2(half the turn) = (1 + the dot product of the directions) / 2.
+                fMinMiterDot = 2 / (miterLimit * miterLimit) - 1;
+            }
+        }
+        // The angle a line can cut off the circle while staying within the tolerance of it.
+        fMaxArcStep = radius > kFlattenTolerance
+                ? 2 * std::acos(1 - kFlattenTolerance / radius)
+                : SK_ScalarPI;
+    }
+
+    void moveTo(SkPoint pt) {
+        this->finish();
+        fFirstPt = fPrevPt = pt;
+        fSegmentCount = 0;
+        fInContour = true;
+        fSawLine = false;
+    }
+
+    void lineTo(SkPoint pt) {
+        fSawLine = true;
+        Segment segment;
+        segment.fStart = fPrevPt;
+        segment.fEnd = pt;
+        segment.fDir = pt - fPrevPt;
+        // Lines with no length have no direction, and only count toward caps.
+        segment.fLength = segment.fDir.length();
+        if (!segment.fDir.normalize()) {
+            return;
+        }
+        fPrevPt = pt;
+        fSegmentCount += 1;
+        if (fSegmentCount == 1) {
+            fFirst = fLast = segment;
+            return;
+        }
+
+        this->join(&fLast, &segment);
+        // The first segment waits for the contour to be closed or capped.
+        if (fSegmentCount > 2) {
+            this->addSegment(fLast);
+        } else {
+            fFirst = fLast;
+        }
+        fLast = segment;
+    }
+
+    void close() {
+        if (fSegmentCount == 0) {
+            // Like SkStroke, treat a closed contour without length as a line without length.
+            fSawLine = true;
+            this->finish();
+            return;
+        }
+        this->lineTo(fFirstPt);
+        if (fSegmentCount > 1) {
+            this->join(&fLast, &fFirst);
+            this->addSegment(fFirst);
+        }
+        this->addSegment(fLast);
+        fInContour = false;
+    }
+
+    // Cap the contour if it's still open.
+    void finish() {
+        if (!fInContour) {
+            return;
+        }
+        fInContour = false;
+        if (fSegmentCount > 0) {
+            if (fSegmentCount > 1) {
+                this->addSegment(fFirst);
+            }
+            this->addSegment(fLast);
+            this->cap(fFirst.fStart, -fFirst.fDir);
+            this->cap(fLast.fEnd, fLast.fDir);
+        } else if (fSawLine) {
+            // SkStroke caps lines without length as if they were upright.
+            this->cap(fFirstPt, fUpright);
+            this->cap(fFirstPt, -fUpright);
+        }
+    }
+
+private:
+    struct Segment {
+        SkPoint  fStart, fEnd;
+        SkVector fDir;
+        SkScalar fLength;
+        // How far each side's trapezoid is cut back from square at each end; the sides are
+        // +perp(fDir) and -perp(fDir).
+        SkScalar fStartCut[2] = {0, 0};
+        SkScalar fEndCut[2]   = {0, 0};
+    };
+
+    void addSegment(const Segment& segment) {
+        const SkVector normal = perp(segment.fDir) * fRadius;
+        for (int side = 0; side < 2; ++side) {
+            const SkVector offset = side == 0 ? normal : -normal;
+            const SkScalar startCut = segment.fStartCut[side],
+                           endCut   = segment.fEndCut[side];
+            SkPoint trapezoid[] = { segment.fStart,
+                                    segment.fStart + offset + segment.fDir * startCut,
+                                    segment.fEnd + offset - segment.fDir * endCut,
+                                    segment.fEnd };
+            fRasterizer->addConvexPolygon(trapezoid, 4);
+        }
+    }
+
+    // Join before to after, which starts where before ends.
+    void join(Segment* before, Segment* after) {
+        const SkPoint pt = after->fStart;
+        const SkScalar dot   = before->fDir.dot(after->fDir),
+                       cross = before->fDir.cross(after->fDir);
+        if (dot > 0 && SkScalarNearlyZero(cross)) {
+            return;
+        }
+        // The offsets on the inside of the turn meet tan(half the turn) times the radius
+        // before and after the point. If either segment is too short to reach there, both
+        // ends stay square, and overlap.
+        const SkScalar outside = cross < 0 ? -1 : 1;
+        const int inside = outside > 0 ? 1 : 0;
+        if (1 + dot > SK_ScalarNearlyZero) {
+            const SkScalar cut = fRadius * SkScalarAbs(cross) / (1 + dot);
+            if (cut <= before->fLength - before->fStartCut[inside] &&
+                cut <= after->fLength - after->fEndCut[inside]) {
+                before->fEndCut[inside] = cut;
+                after->fStartCut[inside] = cut;
+            }
+        }
+
+        const SkVector from = perp(before->fDir) * outside,
+                       to   = perp(after->fDir)  * outside;
+        switch (fJoin) {
+            case SkPaint::kRound_Join:
+                this->addWedge(pt, from, to, std::acos(SkTPin(dot, -1.0f, 1.0f)), outside);
+                return;
+            case SkPaint::kMiter_Join:
+                if (dot >= fMinMiterDot) {
+                    SkPoint quad[] = { pt,
+                                       pt + from * fRadius,
+                                       pt + (from + to) * (fRadius / (1 + dot)),
+                                       pt + to * fRadius };
+                    fRasterizer->addConvexPolygon(quad, 4);
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+        SkPoint triangle[] = { pt, pt + from * fRadius, pt + to * fRadius };
+        fRasterizer->addConvexPolygon(triangle, 3);
+    }
+
+    // dir points out of the end of the stroke.
+    void cap(SkPoint pt, SkVector dir) {
+        const SkVector normal = perp(dir);
+        switch (fCap) {
+            case SkPaint::kButt_Cap:
+                break;
+            case SkPaint::kSquare_Cap: {
+                const SkVector n = normal * fRadius,
+                               d = dir * fRadius;
+                SkPoint quad[] = { pt + n, pt + n + d, pt - n + d, pt - n };
+                fRasterizer->addConvexPolygon(quad, 4);
+                break;
+            }
+            case SkPaint::kRound_Cap:
+                // Turning from the normal toward dir.
+                this->addWedge(pt, normal, -normal, SK_ScalarPI, 1);
+                break;
+        }
+    }
+
+    // Add the part of the circle around center between the unit vectors from and to, turning
+    // by angle (at most pi) in the direction of sign.
+    void addWedge(SkPoint center, SkVector from, SkVector to, SkScalar angle, SkScalar sign) {
+        const int lines = SkTPin((int)std::ceil(angle / fMaxArcStep), 1, kMaxArcLines);
+        const SkScalar step = angle / lines * sign,
+                       c = std::cos(step),
+                       s = std::sin(step);
+        SkPoint pts[kMaxArcLines + 2];
+        pts[0] = center;
+        SkVector v = from;
+        for (int i = 0; i < lines; ++i) {
+            pts[i + 1] = center + v * fRadius;
+            v = {v.fX * c - v.fY * s, v.fX * s + v.fY * c};
+        }
+        pts[lines + 1] = center + to * fRadius;
+        fRasterizer->addConvexPolygon(pts, lines + 2);
+    }
+
+    SparseRasterizer*  fRasterizer;
+    const SkScalar     fRadius;
+    const SkPaint::Cap fCap;
+    SkPaint::Join      fJoin;
+    const SkVector     fUpright;
+    SkScalar           fMinMiterDot = 1;
+    SkScalar           fMaxArcStep;
+
+    SkPoint fFirstPt, fPrevPt;
+    // The first and last segments of the contour, which haven't been added yet.
+    Segment fFirst, fLast;
+    int     fSegmentCount = 0;
+    bool    fInContour = false;
+    bool    fSawLine = false;
+};
+
+// Calls fn(pts, count, isClosed) for each contour of a path that only has lines.
+template <typename Fn>
+void for_each_polyline(const SkPath& path, Fn&& fn) {
+    const uint8_t* verbs = SkPathPriv::VerbData(path);
+    const SkPoint* pts = SkPathPriv::PointData(path);
+    const int verbCount = path.countVerbs();
+    int start = 0,
+        count = 0;
+    for (int i = 0; i < verbCount; ++i) {
+        switch ((SkPathVerb)verbs[i]) {
+            case SkPathVerb::kMove:
+                if (count > 0) {
+                    fn(pts + start, count, false);
+                }
+                start += count;
+                count = 1;
+                break;
+            case SkPathVerb::kLine:
+                count += 1;
+                break;
+            case SkPathVerb::kClose:
+                if (count > 0) {
+                    fn(pts + start, count, true);
+                }
+                start += count;
+                count = 0;
+                break;
+            default:
+                SkDEBUGFAIL("expected a polyline");
+                return;
+        }
+    }
+    if (count > 0) {
+        fn(pts + start, count, false);
+    }
+}
+
+double polyline_length(const SkPoint pts[], int count, bool isClosed) {
+    double length = 0;
+    for (int i = 1; i < count; ++i) {
+        length += SkPoint::Distance(pts[i - 1], pts[i]);
+    }
+    if (isClosed && count > 1) {
+        length += SkPoint::Distance(pts[count - 1], pts[0]);
+    }
+    return length;
+}
+
+// Walks forward along a contour mapped to device space.
+class PolylineCursor {
+public:
+    PolylineCursor(const SkPoint pts[], int count, bool isClosed, const SkMatrix& matrix)
+            : fPts(pts)
+            , fCount(count)
+            , fLastSegment(isClosed ? count - 1 : count - 2)
+            , fMatrix(matrix) {
+        this->setSegment(0);
+    }
+
+    double segmentLength() const { return fLength; }
+    bool nextSegment() {
+        if (fSegment >= fLastSegment) {
+            return false;
+        }
+        fStart += fLength;
+        this->setSegment(fSegment + 1);
+        return true;
+    }
+
+    // Move to distance along the contour, drawing each point passed on the way if stroker
+    // isn't null, and return the point there.
+    SkPoint advanceTo(double distance, PolylineStroker* stroker) {
+        while (distance > fStart + fLength && fSegment < fLastSegment) {
+            if (stroker) {
+                stroker->lineTo(fB);
+            }
+            this->nextSegment();
+        }
+        double t = fLength > 0 ? SkTPin((distance - fStart) / fLength, 0.0, 1.0) : 0;
+        return fA + (fB - fA) * (SkScalar)t;
+    }
+
+private:
+    void setSegment(int segment) {
+        fSegment = segment;
+        fA = fMatrix.mapXY(fPts[segment].fX, fPts[segment].fY);
+        const SkPoint& b = fPts[segment + 1 < fCount ? segment + 1 : 0];
+        fB = fMatrix.mapXY(b.fX, b.fY);
+        fLength = SkPoint::Distance(fA, fB);
+    }
+
+    const SkPoint*  fPts;
+    const int       fCount;
+    const int       fLastSegment;
+    const SkMatrix& fMatrix;
+    int             fSegment;
+    SkPoint         fA, fB;
+    double          fStart = 0;
+    double          fLength;
+};
+
+struct DashParams {
+    const SkScalar* fIntervals;
+    int             fCount;
+    double          fScale;          // from the intervals to device space
+    double          fInitialLength;  // in device space
+    int             fInitialIndex;
+};
+
+// Dash a contour the same way as SkDashPath::InternalFilter(), but in device space.
+void dash_polyline(PolylineStroker* stroker, const SkPoint pts[], int count, bool isClosed,
+                   const SkMatrix& matrix, const DashParams& dash) {
+    if (count < 2) {
+        return;
+    }
+    double length = 0;
+    {
+        PolylineCursor cursor(pts, count, isClosed, matrix);
+        do {
+            length += cursor.segmentLength();
+        } while (cursor.nextSegment());
+    }
+    if (!(length > 0)) {
+        return;
+    }
+
+    // A closed contour's first dash is drawn last, so it can be joined to the last dash.
+    bool skipFirstDash = isClosed;
+    bool inDash = false;
+    double distance = 0;
+    double dlen = dash.fInitialLength;
+    int index = dash.fInitialIndex;
+    PolylineCursor cursor(pts, count, isClosed, matrix);
+    while (distance < length) {
+        inDash = (index % 2 == 0) && !skipFirstDash;
+        if (inDash) {
+            SkPoint start = cursor.advanceTo(distance, nullptr);
+            stroker->moveTo(start);
+            stroker->lineTo(start);  // in case the dash has no length
+            stroker->lineTo(cursor.advanceTo(std::min(distance + dlen, length), stroker));
+        }
+        distance += dlen;
+        skipFirstDash = false;
+
+        index += 1;
+        if (index == dash.fCount) {
+            index = 0;
+        }
+        dlen = dash.fIntervals[index] * dash.fScale;
+    }
+
+    if (isClosed && dash.fInitialIndex % 2 == 0) {
+        PolylineCursor first(pts, count, isClosed, matrix);
+        if (!inDash) {
+            SkPoint start = first.advanceTo(0, nullptr);
+            stroker->moveTo(start);
+            stroker->lineTo(start);
+        }
+        stroker->lineTo(first.advanceTo(std::min(dash.fInitialLength, length), stroker));
+    }
+    stroker->finish();
+}
+
+}  // namespace
+
+void SkScan::SparseAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& ir,
+                              const SkIRect& clipBounds) {
+    SkASSERT(!path.isInverseFillType());
+
+    SkIRect bounds;
+    if (!bounds.intersect(ir, clipBounds)) {
+        return;
+    }
+
+    SparseRasterizer rasterizer(bounds, path.getFillType() == SkPathFillType::kEvenOdd);
+    rasterizer.addPath(path);
+    rasterizer.resolve();
+    rasterizer.blit(blitter);
+}
+
+bool SkScan::SparseAAStrokePath(const SkPath& path, const SkMatrix& matrix,
+                                const SkStrokeRec& rec, const SkPathEffect::DashInfo* dash,
+                                const SkRasterClip& clip, SkBlitter* blitter) {
+    SkASSERT(!(path.getSegmentMasks() & ~SkPath::kLine_SegmentMask));
+    SkASSERT(matrix.isSimilarity());
+    SkASSERT(rec.getWidth() > 0);
+
+    if (clip.isEmpty() || !path.isFinite()) {
+        return true;
+    }
+
+    // A similarity scales every length by the same amount, so the stroke can be built in device
+    // space with a scaled radius.
+    const SkScalar scale = SkPoint::Length(matrix.getScaleX(), matrix.getSkewY());
+    const SkScalar radius = rec.getWidth() * 0.5f * scale;
+
+    DashParams dashParams = {nullptr, 0, scale, 0, 0};
+    if (dash) {
+        if (!SkDashPath::ValidDashPath(dash->fPhase, dash->fIntervals, dash->fCount)) {
+            return false;
+        }
+        SkScalar initialLength, intervalLength;
+        SkDashPath::CalcDashParameters(dash->fPhase, dash->fIntervals, dash->fCount,
+                                       &initialLength, &dashParams.fInitialIndex,
+                                       &intervalLength);
+        // Give up where SkDashPath does.
+        double dashCount = 0;
+        for_each_polyline(path, [&](const SkPoint pts[], int count, bool isClosed) {
+            dashCount += polyline_length(pts, count, isClosed) * (dash->fCount >> 1) /
+                         intervalLength;
+        });
+        if (dashCount > SkDashPath::kMaxDashCount) {
+            return false;
+        }
+        dashParams.fIntervals = dash->fIntervals;
+        dashParams.fCount = dash->fCount;
+        dashParams.fInitialLength = initialLength * (double)scale;
+    }
+
+    SkScalar outset = radius;
+    if (rec.getJoin() == SkPaint::kMiter_Join) {
+        outset *= std::max(rec.getMiter(), 1.0f);
+    }
+    if (rec.getCap() == SkPaint::kSquare_Cap) {
+        outset = std::max(outset, radius * SK_ScalarSqrt2);
+    }
+    const SkRect devBounds = matrix.mapRect(path.getBounds()).makeOutset(outset, outset);
+    if (!devBounds.isFinite()) {
+        return false;
+    }
+    const SkIRect ir = devBounds.roundOut();
+
+    const SkRegion* clipRgn;
+    SkRegion        tmp;
+    SkAAClipBlitter aaBlitter;
+    if (clip.isBW()) {
+        clipRgn = &clip.bwRgn();
+    } else {
+        tmp.setRect(clip.getBounds());
+        aaBlitter.init(blitter, &clip.aaRgn());
+        clipRgn = &tmp;
+        blitter = &aaBlitter;
+    }
+
+    // The runs passed to the blitter are int16_t, so restrict the clip to 32767 as
+    // AntiFillPath does.
+    SkRegion limitedClip;
+    {
+        static const int32_t kMaxClipCoord = 32767;
+        const SkIRect& clipBounds = clipRgn->getBounds();
+        if (clipBounds.fRight > kMaxClipCoord || clipBounds.fBottom > kMaxClipCoord) {
+            limitedClip.op(*clipRgn, SkIRect::MakeWH(kMaxClipCoord, kMaxClipCoord),
+                           SkRegion::kIntersect_Op);
+            clipRgn = &limitedClip;
+        }
+    }
+    SkScanClipper clipper(blitter, clipRgn, ir);
+    SkIRect bounds;
+    if (clipper.getBlitter() == nullptr || !bounds.intersect(ir, clipRgn->getBounds())) {
+        return true;
+    }
+
+    SparseRasterizer rasterizer(bounds, false);
+    SkVector upright = matrix.mapVector(0, 1);
+    upright.normalize();
+    PolylineStroker stroker(&rasterizer, radius, rec.getCap(), rec.getJoin(), rec.getMiter(),
+                            upright);
+    for_each_polyline(path, [&](const SkPoint pts[], int count, bool isClosed) {
+        if (dash) {
+            dash_polyline(&stroker, pts, count, isClosed, matrix, dashParams);
+            return;
+        }
+        stroker.moveTo(matrix.mapXY(pts[0].fX, pts[0].fY));
+        for (int i = 1; i < count; ++i) {
+            stroker.lineTo(matrix.mapXY(pts[i].fX, pts[i].fY));
+        }
+        if (isClosed) {
+            stroker.close();
+        } else {
+            stroker.finish();
+        }
+    });
+    rasterizer.resolve();
+    rasterizer.blit(clipper.getBlitter());
+    return true;
+}
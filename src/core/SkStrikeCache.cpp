@@ -78,11 +78,13 @@ bool operator == (decltype(nullptr), const SkStrikeCache::ExclusiveStrikePtr& rh
 }
 
 SkStrikeCache::~SkStrikeCache() {
-    Strike* strike = fHead;
-    while (strike) {
-        Strike* next = strike->fNext;
-        strike->unref();
-        strike = next;
+    for (Shard& shard : fShards) {
+        Strike* strike = shard.fHead;
+        while (strike) {
+            Strike* next = strike->fNext;
+            strike->unref();
+            strike = next;
+        }
     }
 }
 
@@ -95,13 +97,40 @@ SkExclusiveStrikePtr SkStrikeCache::findOrCreateStrikeExclusive(
 auto SkStrikeCache::findOrCreateStrike(const SkDescriptor& desc,
                                        const SkScalerContextEffects& effects,
                                        const SkTypeface& typeface) -> sk_sp<Strike> {
-    SkAutoSpinlock ac(fLock);
-    sk_sp<Strike> strike = this->internalFindStrikeOrNull(desc);
+    Shard& shard = this->shardFor(desc);
+    sk_sp<Strike> strike;
+    {
+        SkAutoSpinlock ac(shard.fLock);
+        strike = this->internalFindStrikeOrNull(shard, desc);
+    }
     if (strike == nullptr) {
+        // Make the strike, and fill it from the persistent cache, before taking the lock. Reading
+        // a saved strike means hashing the font file and loading every glyph, and other threads
+        // using this shard should not wait for that.
         auto scaler = typeface.createScalerContext(effects, &desc);
-        strike = this->internalCreateStrike(desc, std::move(scaler));
+        SkFontMetrics savedMetrics;
+        sk_sp<SkData> saved;
+        if (sk_sp<SkStrikePersistentCache> persistent = this->persistentCache()) {
+            saved = persistent->find(desc, typeface, &savedMetrics);
+        }
+        auto created = sk_make_sp<Strike>(this, &shard, desc, std::move(scaler),
+                                          saved ? &savedMetrics : nullptr, nullptr);
+        if (saved != nullptr) {
+            // The strike is not in the cache yet, so no other thread can be using it.
+            created->fMemoryUsed +=
+                    SkStrikePersistentCache::LoadGlyphs(*saved, &created->fScalerCache);
+            created->fPersistedMemoryUsed = created->fMemoryUsed;
+        }
+
+        SkAutoSpinlock ac(shard.fLock);
+        // Another thread may have added the same strike while this one was being made.
+        strike = this->internalFindStrikeOrNull(shard, desc);
+        if (strike == nullptr) {
+            strike = std::move(created);
+            this->internalAttachToHead(shard, strike);
+        }
     }
-    this->internalPurge();
+    this->purge();
     return strike;
 }
 
@@ -175,33 +204,42 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
                                "glyph_count", "objects",
                                strike.fScalerCache.countCachedGlyphs());
         dump->setMemoryBacking(dumpName.c_str(), "malloc", nullptr);
+
+        SkString atlasDumpName = dumpName;
+        atlasDumpName.append("/atlas");
+        strike.fScalerCache.dumpAtlasMemoryStatistics(dump, atlasDumpName.c_str());
     };
 
     GlobalStrikeCache()->forEachStrike(visitor);
 }
 
 SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc) {
-    SkAutoSpinlock ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    Shard& shard = this->shardFor(desc);
+    sk_sp<SkStrike> result;
+    {
+        SkAutoSpinlock ac(shard.fLock);
+        result = this->internalFindStrikeOrNull(shard, desc);
+    }
+    this->purge();
     return SkExclusiveStrikePtr(result);
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<Strike> {
-    for (Strike* strike = fHead; strike != nullptr; strike = strike->fNext) {
+auto SkStrikeCache::internalFindStrikeOrNull(Shard& shard, const SkDescriptor& desc)
+        -> sk_sp<Strike> {
+    for (Strike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
         if (strike->fScalerCache.getDescriptor() == desc) {
-            if (fHead != strike) {
+            if (shard.fHead != strike) {
                 // Make most recently used
                 strike->fPrev->fNext = strike->fNext;
                 if (strike->fNext != nullptr) {
                     strike->fNext->fPrev = strike->fPrev;
                 } else {
-                    fTail = strike->fPrev;
+                    shard.fTail = strike->fPrev;
                 }
-                fHead->fPrev = strike;
-                strike->fNext = fHead;
+                shard.fHead->fPrev = strike;
+                strike->fNext = shard.fHead;
                 strike->fPrev = nullptr;
-                fHead = strike;
+                shard.fHead = strike;
             }
 
             return sk_ref_sp(strike);
@@ -217,53 +255,47 @@ SkExclusiveStrikePtr SkStrikeCache::createStrikeExclusive(
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner)
 {
-    SkAutoSpinlock ac(fLock);
-    return SkExclusiveStrikePtr(
-            this->internalCreateStrike(desc, std::move(scaler), maybeMetrics, std::move(pinner)));
+    Shard& shard = this->shardFor(desc);
+    SkAutoSpinlock ac(shard.fLock);
+    return SkExclusiveStrikePtr(this->internalCreateStrike(
+            shard, desc, std::move(scaler), maybeMetrics, std::move(pinner)));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard& shard,
         const SkDescriptor& desc,
         std::unique_ptr<SkScalerContext> scaler,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<Strike> {
-    auto strike =
-            sk_make_sp<Strike>(this, desc, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    auto strike = sk_make_sp<Strike>(
+            this, &shard, desc, std::move(scaler), maybeMetrics, std::move(pinner));
+    this->internalAttachToHead(shard, strike);
     return strike;
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoSpinlock ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    this->purge(fTotalMemoryUsed);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoSpinlock ac(fLock);
     return fTotalMemoryUsed;
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoSpinlock ac(fLock);
     return fCacheCount;
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoSpinlock ac(fLock);
     return fCacheCountLimit;
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoSpinlock ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit);
+    this->purge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoSpinlock ac(fLock);
     return fCacheSizeLimit;
 }
 
@@ -272,16 +304,12 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoSpinlock ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+    int prevCount = fCacheCountLimit.exchange(newCount);
+    this->purge();
     return prevCount;
 }
 
 int SkStrikeCache::getCachePointSizeLimit() const {
-    SkAutoSpinlock ac(fLock);
     return fPointSizeLimit;
 }
 
@@ -290,41 +318,77 @@ int SkStrikeCache::setCachePointSizeLimit(int newLimit) {
         newLimit = 0;
     }
 
-    SkAutoSpinlock ac(fLock);
+    return fPointSizeLimit.exchange(newLimit);
+}
 
-    int prevLimit = fPointSizeLimit;
-    fPointSizeLimit = newLimit;
-    return prevLimit;
+void SkStrikeCache::setPersistentCacheDirectory(const char* directory) {
+    sk_sp<SkStrikePersistentCache> persistent =
+            directory ? sk_make_sp<SkStrikePersistentCache>(directory) : nullptr;
+    SkAutoSpinlock lock{fPersistentCacheLock};
+    fPersistentCache = std::move(persistent);
+}
+
+sk_sp<SkStrikePersistentCache> SkStrikeCache::persistentCache() const {
+    SkAutoSpinlock lock{fPersistentCacheLock};
+    return fPersistentCache;
+}
+
+void SkStrikeCache::writePersistentCache() {
+    sk_sp<SkStrikePersistentCache> persistent = this->persistentCache();
+    if (persistent == nullptr) {
+        return;
+    }
+
+    // Collect the strikes under the shard locks, but do the file writing without them.
+    std::vector<sk_sp<Strike>> changed;
+    for (Shard& shard : fShards) {
+        SkAutoSpinlock ac(shard.fLock);
+        for (Strike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            if (strike->fMemoryUsed != strike->fPersistedMemoryUsed) {
+                strike->fPersistedMemoryUsed = strike->fMemoryUsed;
+                changed.push_back(sk_ref_sp(strike));
+            }
+        }
+    }
+
+    for (const sk_sp<Strike>& strike : changed) {
+        persistent->save(strike->fScalerCache);
+    }
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const Strike&)> visitor) const {
-    SkAutoSpinlock ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoSpinlock ac(shard.fLock);
 
-    this->validate();
+        this->validate(shard);
 
-    for (Strike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+        for (Strike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
     }
 }
 
-size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
-    this->validate();
+size_t SkStrikeCache::purge(size_t minBytesNeeded) {
+    size_t totalMemoryUsed = fTotalMemoryUsed;
+    size_t cacheSizeLimit = fCacheSizeLimit;
+    int32_t cacheCount = fCacheCount;
+    int32_t cacheCountLimit = fCacheCountLimit;
 
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > cacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - cacheSizeLimit;
     }
     bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = std::max(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > cacheCountLimit) {
+        countNeeded = cacheCount - cacheCountLimit;
         // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
+        countNeeded = std::max(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -332,12 +396,49 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         return 0;
     }
 
+    SkAutoSpinlock purgeLock(fPurgeLock);
+
+    size_t  bytesFreed = 0;
+    int     countFreed = 0;
+
+    // Each shard keeps its own LRU order, so take an even share from the tail of every shard
+    // and go around again until the targets are met or nothing more can be removed.
+    bool freedAny = true;
+    while (freedAny && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
+        freedAny = false;
+        size_t bytesShare = bytesFreed < bytesNeeded
+                          ? (bytesNeeded - bytesFreed + kShardCount - 1) / kShardCount : 0;
+        int countShare = countFreed < countNeeded
+                       ? (countNeeded - countFreed + kShardCount - 1) / kShardCount : 0;
+        for (Shard& shard : fShards) {
+            SkAutoSpinlock ac(shard.fLock);
+            auto [shardBytes, shardCount] = this->internalPurgeShard(shard, bytesShare, countShare);
+            bytesFreed += shardBytes;
+            countFreed += shardCount;
+            freedAny |= shardCount > 0;
+        }
+    }
+
+#ifdef SPEW_PURGE_STATUS
+    if (countFreed) {
+        SkDebugf("purging %dK from font cache [%d entries]\n",
+                 (int)(bytesFreed >> 10), countFreed);
+    }
+#endif
+
+    return bytesFreed;
+}
+
+std::tuple<size_t, int> SkStrikeCache::internalPurgeShard(
+        Shard& shard, size_t bytesNeeded, int countNeeded) {
+    this->validate(shard);
+
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
     // Start at the tail and proceed backwards deleting; the list is in LRU
     // order, with unimportant entries at the tail.
-    Strike* strike = fTail;
+    Strike* strike = shard.fTail;
     while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         Strike* prev = strike->fPrev;
 
@@ -345,67 +446,63 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
             bytesFreed += strike->fMemoryUsed;
             countFreed += 1;
-            this->internalRemoveStrike(strike);
+            this->internalRemoveStrike(shard, strike);
         }
         strike = prev;
     }
 
-    this->validate();
-
-#ifdef SPEW_PURGE_STATUS
-    if (countFreed) {
-        SkDebugf("purging %dK from font cache [%d entries]\n",
-                 (int)(bytesFreed >> 10), countFreed);
-    }
-#endif
-
-    return bytesFreed;
+    this->validate(shard);
+    return {bytesFreed, countFreed};
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<Strike> strike) {
+void SkStrikeCache::internalAttachToHead(Shard& shard, sk_sp<Strike> strike) {
     SkASSERT(nullptr == strike->fPrev && nullptr == strike->fNext);
 
+    shard.fCount += 1;
+    shard.fMemoryUsed += strike->fMemoryUsed;
     fCacheCount += 1;
     fTotalMemoryUsed += strike->fMemoryUsed;
 
-    if (fHead) {
-        fHead->fPrev = strike.get();
-        strike->fNext = fHead;
+    if (shard.fHead) {
+        shard.fHead->fPrev = strike.get();
+        strike->fNext = shard.fHead;
     }
 
-    if (fTail == nullptr) {
-        fTail = strike.get();
+    if (shard.fTail == nullptr) {
+        shard.fTail = strike.get();
     }
 
-    fHead = strike.release(); // Transfer ownership of strike to the cache list.
+    shard.fHead = strike.release(); // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(Strike* strike) {
-    SkASSERT(fCacheCount > 0);
+void SkStrikeCache::internalRemoveStrike(Shard& shard, Strike* strike) {
+    SkASSERT(shard.fCount > 0);
+    shard.fCount -= 1;
+    shard.fMemoryUsed -= strike->fMemoryUsed;
     fCacheCount -= 1;
     fTotalMemoryUsed -= strike->fMemoryUsed;
 
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
     } else {
-        fHead = strike->fNext;
+        shard.fHead = strike->fNext;
     }
     if (strike->fNext) {
         strike->fNext->fPrev = strike->fPrev;
     } else {
-        fTail = strike->fPrev;
+        shard.fTail = strike->fPrev;
     }
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
     strike->unref();
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::validate(const Shard& shard) const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
 
-    const Strike* strike = fHead;
+    const Strike* strike = shard.fHead;
     while (strike != nullptr) {
         computedBytes += strike->fMemoryUsed;
         computedCount += 1;
@@ -413,22 +510,23 @@ void SkStrikeCache::validate() const {
     }
 
     // Can't use SkASSERTF because it looses thread annotations.
-    if (fCacheCount != computedCount) {
-        SkDebugf("fCacheCount: %d, computedCount: %d", fCacheCount, computedCount);
-        SK_ABORT("fCacheCount != computedCount");
+    if (shard.fCount != computedCount) {
+        SkDebugf("fCount: %d, computedCount: %d", shard.fCount, computedCount);
+        SK_ABORT("fCount != computedCount");
     }
-    if (fTotalMemoryUsed != computedBytes) {
-        SkDebugf("fTotalMemoryUsed: %d, computedBytes: %d", fTotalMemoryUsed, computedBytes);
-        SK_ABORT("fTotalMemoryUsed == computedBytes");
+    if (shard.fMemoryUsed != computedBytes) {
+        SkDebugf("fMemoryUsed: %zu, computedBytes: %zu", shard.fMemoryUsed, computedBytes);
+        SK_ABORT("fMemoryUsed == computedBytes");
     }
 #endif
 }
 
 void SkStrikeCache::Strike::updateDelta(size_t increase) {
     if (increase != 0) {
-        SkAutoSpinlock lock{fStrikeCache->fLock};
+        SkAutoSpinlock lock{fShard->fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
+            fShard->fMemoryUsed += increase;
             fStrikeCache->fTotalMemoryUsed += increase;
         }
     }
@@ -8,6 +8,8 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -15,6 +17,7 @@
 #include "include/private/SkTemplates.h"
 #include "src/core/SkDescriptor.h"
 #include "src/core/SkScalerCache.h"
+#include "src/core/SkStrikePersistentCache.h"
 
 class SkTraceMemoryDump;
 
@@ -39,6 +42,8 @@ public:
 };
 
 class SkStrikeCache final : public SkStrikeForGPUCacheInterface {
+    struct Shard;
+
 public:
     SkStrikeCache() = default;
     ~SkStrikeCache() override;
@@ -46,11 +51,13 @@ public:
     class Strike final : public SkRefCnt, public SkStrikeForGPU {
     public:
         Strike(SkStrikeCache* strikeCache,
+               Shard* shard,
                const SkDescriptor& desc,
                std::unique_ptr<SkScalerContext> scaler,
                const SkFontMetrics* metrics,
                std::unique_ptr<SkStrikePinner> pinner)
                 : fStrikeCache{strikeCache}
+                , fShard{shard}
                 , fScalerCache{desc, std::move(scaler), metrics}
                 , fPinner{std::move(pinner)} {}
 
@@ -138,11 +145,15 @@ public:
         void updateDelta(size_t increase);
 
         SkStrikeCache* const            fStrikeCache;
+        Shard* const                    fShard;
         Strike*                         fNext{nullptr};
         Strike*                         fPrev{nullptr};
         SkScalerCache                   fScalerCache;
         std::unique_ptr<SkStrikePinner> fPinner;
         size_t                          fMemoryUsed{sizeof(SkScalerCache)};
+        // The value of fMemoryUsed when the strike was last loaded from or written to the
+        // persistent cache.
+        size_t                          fPersistedMemoryUsed{0};
         bool                            fRemoved{false};
     };  // Strike
 
@@ -169,23 +180,23 @@ public:
 
     static SkStrikeCache* GlobalStrikeCache();
 
-    ExclusiveStrikePtr findStrikeExclusive(const SkDescriptor&) SK_EXCLUDES(fLock);
+    ExclusiveStrikePtr findStrikeExclusive(const SkDescriptor&);
 
     ExclusiveStrikePtr createStrikeExclusive(
             const SkDescriptor& desc,
             std::unique_ptr<SkScalerContext> scaler,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr);
 
     ExclusiveStrikePtr findOrCreateStrikeExclusive(
             const SkDescriptor& desc,
             const SkScalerContextEffects& effects,
-            const SkTypeface& typeface) SK_EXCLUDES(fLock);
+            const SkTypeface& typeface);
 
     SkScopedStrikeForGPU findOrCreateScopedStrike(
             const SkDescriptor& desc,
             const SkScalerContextEffects& effects,
-            const SkTypeface& typeface) override SK_EXCLUDES(fLock);
+            const SkTypeface& typeface) override;
 
     static void PurgeAll();
     static void Dump();
@@ -194,53 +205,89 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
-    void purgeAll() SK_EXCLUDES(fLock); // does not change budget
+    void purgeAll(); // does not change budget
+
+    int getCacheCountLimit() const;
+    int setCacheCountLimit(int limit);
+    int getCacheCountUsed() const;
 
-    int getCacheCountLimit() const SK_EXCLUDES(fLock);
-    int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
-    int getCacheCountUsed() const SK_EXCLUDES(fLock);
+    size_t getCacheSizeLimit() const;
+    size_t setCacheSizeLimit(size_t limit);
+    size_t getTotalMemoryUsed() const;
 
-    size_t getCacheSizeLimit() const SK_EXCLUDES(fLock);
-    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
-    size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
+    int  getCachePointSizeLimit() const;
+    int  setCachePointSizeLimit(int limit);
 
-    int  getCachePointSizeLimit() const SK_EXCLUDES(fLock);
-    int  setCachePointSizeLimit(int limit) SK_EXCLUDES(fLock);
+    // Fill new strikes with glyphs saved in directory by an earlier process, and save glyphs
+    // there when writePersistentCache is called. Pass nullptr to stop using a directory.
+    void setPersistentCacheDirectory(const char* directory);
+
+    // Save the glyphs of each strike that has grown since it was loaded or last saved.
+    void writePersistentCache();
 
 private:
-    sk_sp<Strike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+    // The strikes are split between shards by descriptor checksum. Each shard has its own lock
+    // and LRU list, so threads drawing with different strikes rarely wait on each other.
+    struct Shard {
+        mutable SkSpinlock fLock;
+        Strike* fHead SK_GUARDED_BY(fLock) {nullptr};
+        Strike* fTail SK_GUARDED_BY(fLock) {nullptr};
+        size_t  fMemoryUsed SK_GUARDED_BY(fLock) {0};
+        int32_t fCount SK_GUARDED_BY(fLock) {0};
+    };
+    static constexpr int kShardCount = 8;
+
+    Shard& shardFor(const SkDescriptor& desc) {
+        return fShards[desc.getChecksum() % kShardCount];
+    }
+
+    sk_sp<Strike> internalFindStrikeOrNull(Shard& shard, const SkDescriptor& desc)
+            SK_REQUIRES(shard.fLock);
     sk_sp<Strike> internalCreateStrike(
+            Shard& shard,
             const SkDescriptor& desc,
             std::unique_ptr<SkScalerContext> scaler,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(shard.fLock);
     sk_sp<Strike> findOrCreateStrike(
             const SkDescriptor& desc,
             const SkScalerContextEffects& effects,
-            const SkTypeface& typeface) SK_EXCLUDES(fLock);
+            const SkTypeface& typeface);
 
-    // The following methods can only be called when mutex is already held.
-    void internalRemoveStrike(Strike* strike) SK_REQUIRES(fLock);
-    void internalAttachToHead(sk_sp<Strike> strike) SK_REQUIRES(fLock);
+    // The following methods can only be called when the shard's lock is already held.
+    void internalRemoveStrike(Shard& shard, Strike* strike) SK_REQUIRES(shard.fLock);
+    void internalAttachToHead(Shard& shard, sk_sp<Strike> strike) SK_REQUIRES(shard.fLock);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
     // and attempt to purge caches to match.
     // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0) SK_REQUIRES(fLock);
+    size_t purge(size_t minBytesNeeded = 0) SK_EXCLUDES(fPurgeLock);
+
+    // Remove unpinned strikes from the LRU end of the shard until the byte and count targets are
+    // met or the shard has nothing left to remove.
+    std::tuple<size_t, int> internalPurgeShard(Shard& shard, size_t bytesNeeded, int countNeeded)
+            SK_REQUIRES(shard.fLock);
 
     // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
-
-    void forEachStrike(std::function<void(const Strike&)> visitor) const SK_EXCLUDES(fLock);
-
-    mutable SkSpinlock fLock;
-    Strike* fHead SK_GUARDED_BY(fLock) {nullptr};
-    Strike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
-    int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
-    int32_t fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+    void validate(const Shard& shard) const SK_REQUIRES(shard.fLock);
+
+    void forEachStrike(std::function<void(const Strike&)> visitor) const;
+
+    sk_sp<SkStrikePersistentCache> persistentCache() const SK_EXCLUDES(fPersistentCacheLock);
+
+    Shard fShards[kShardCount];
+
+    // Only one thread purges at a time, taking the shard locks one after another.
+    SkSpinlock fPurgeLock;
+
+    mutable SkSpinlock fPersistentCacheLock;
+    sk_sp<SkStrikePersistentCache> fPersistentCache SK_GUARDED_BY(fPersistentCacheLock);
+
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
+    std::atomic<int32_t> fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
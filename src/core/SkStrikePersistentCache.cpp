@@ -0,0 +1,256 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkStrikePersistentCache.h"
+
+#include "include/core/SkFontMetrics.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTime.h"
+#include "include/core/SkTypeface.h"
+#include "src/core/SkDescriptor.h"
+#include "src/core/SkFontDescriptor.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkScalerCache.h"
+#include "src/core/SkScalerContext.h"
+#include "src/core/SkWriteBuffer.h"
+#include "src/utils/SkOSPath.h"
+
+#include <cstdio>
+
+static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'g', 'c');
+// Bump this whenever the file layout, or the glyphs produced for a descriptor, change.
+static constexpr uint32_t kVersion = 1;
+
+enum PathState : uint32_t {
+    kPathNotSet,
+    kNoPath,
+    kHasPath,
+};
+
+// SkReadBuffer::checkInt is not available when SK_DISABLE_READBUFFER is set.
+static int32_t read_int_in_range(SkReadBuffer* buffer, int32_t min, int32_t max) {
+    int32_t value = buffer->readInt();
+    return buffer->validate(min <= value && value <= max) ? value : min;
+}
+
+// Copy desc, replacing the font id in the rec so the result is the same in every process.
+static void normalize_descriptor(const SkDescriptor& desc, SkAutoDescriptor* ad) {
+    ad->reset(desc.getLength());
+    SkDescriptor* normalized = ad->getDesc();
+
+    uint32_t size;
+    const void* ptr = desc.findEntry(kRec_SkDescriptorTag, &size);
+    SkScalerContextRec rec;
+    std::memcpy((void*)&rec, ptr, size);
+    rec.fFontID = 0;
+    normalized->addEntry(kRec_SkDescriptorTag, sizeof(rec), &rec);
+
+    ptr = desc.findEntry(kEffects_SkDescriptorTag, &size);
+    if (ptr) { normalized->addEntry(kEffects_SkDescriptorTag, size, ptr); }
+
+    normalized->computeChecksum();
+}
+
+SkStrikePersistentCache::SkStrikePersistentCache(const char* directory)
+        : fDirectory{directory} {}
+
+uint32_t SkStrikePersistentCache::typefaceHash(const SkTypeface& typeface) {
+    {
+        SkAutoMutexExclusive lock{fMutex};
+        if (uint32_t* hash = fTypefaceHashes.find(typeface.uniqueID())) {
+            return *hash;
+        }
+    }
+
+    uint32_t hash = 0;
+    std::unique_ptr<SkFontData> fontData = typeface.makeFontData();
+    if (fontData && fontData->hasStream()) {
+        SkStreamAsset* stream = fontData->getStream();
+        sk_sp<SkData> data = SkData::MakeFromStream(stream, stream->getLength());
+        if (data) {
+            hash = SkOpts::hash(data->data(), data->size());
+            int index = fontData->getIndex();
+            hash = SkOpts::hash(&index, sizeof(index), hash);
+            hash = SkOpts::hash(fontData->getAxis(),
+                                fontData->getAxisCount() * sizeof(SkFixed), hash);
+            // Zero is reserved for typefaces that can't be stored.
+            hash = hash ? hash : 1;
+        }
+    }
+
+    SkAutoMutexExclusive lock{fMutex};
+    fTypefaceHashes.set(typeface.uniqueID(), hash);
+    return hash;
+}
+
+bool SkStrikePersistentCache::fileName(const SkDescriptor& desc, const SkTypeface& typeface,
+                                       SkAutoDescriptor* normalized, SkString* path,
+                                       uint32_t* hash) {
+    *hash = this->typefaceHash(typeface);
+    if (*hash == 0 || desc.findEntry(kRec_SkDescriptorTag, nullptr) == nullptr) {
+        return false;
+    }
+    normalize_descriptor(desc, normalized);
+    SkString name = SkStringPrintf("%08x%08x.strike", *hash, normalized->getDesc()->getChecksum());
+    *path = SkOSPath::Join(fDirectory.c_str(), name.c_str());
+    return true;
+}
+
+bool SkStrikePersistentCache::ReadHeader(SkReadBuffer* buffer, uint32_t typefaceHash,
+                                         const SkDescriptor& normalized, SkFontMetrics* metrics) {
+    if (buffer->readUInt() != kMagic
+        || buffer->readUInt() != kVersion
+        || buffer->readUInt() != typefaceHash) {
+        return false;
+    }
+
+    // The name only has the checksum, so make sure this is really the same strike.
+    uint32_t descLength = buffer->getArrayCount();
+    if (descLength != normalized.getLength()) {
+        return false;
+    }
+    SkAutoDescriptor saved{descLength};
+    if (!buffer->readByteArray(saved.getDesc(), descLength) || *saved.getDesc() != normalized) {
+        return false;
+    }
+
+    return buffer->readByteArray(metrics, sizeof(SkFontMetrics)) && buffer->validate(true);
+}
+
+sk_sp<SkData> SkStrikePersistentCache::find(const SkDescriptor& desc, const SkTypeface& typeface,
+                                            SkFontMetrics* metrics) {
+    SkAutoDescriptor normalized;
+    SkString path;
+    uint32_t hash;
+    if (!this->fileName(desc, typeface, &normalized, &path, &hash)) {
+        return nullptr;
+    }
+
+    sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    SkReadBuffer buffer{data->data(), data->size()};
+    if (!ReadHeader(&buffer, hash, *normalized.getDesc(), metrics)) {
+        return nullptr;
+    }
+    return data;
+}
+
+size_t SkStrikePersistentCache::LoadGlyphs(const SkData& data, SkScalerCache* cache) {
+    SkReadBuffer buffer{data.data(), data.size()};
+
+    // find() already checked the header against the strike, so only skip over it here.
+    buffer.readUInt();
+    buffer.readUInt();
+    buffer.readUInt();
+    buffer.skip(buffer.readUInt());
+    buffer.skip(buffer.readUInt());
+
+    size_t delta = 0;
+    while (buffer.validate(true) && buffer.readBool()) {
+        SkGlyph glyph{SkPackedGlyphID{buffer.readUInt()}};
+        glyph.fAdvanceX = buffer.readScalar();
+        glyph.fAdvanceY = buffer.readScalar();
+        glyph.fWidth = SkTo<uint16_t>(read_int_in_range(&buffer, 0, UINT16_MAX));
+        glyph.fHeight = SkTo<uint16_t>(read_int_in_range(&buffer, 0, UINT16_MAX));
+        glyph.fTop = SkTo<int16_t>(read_int_in_range(&buffer, INT16_MIN, INT16_MAX));
+        glyph.fLeft = SkTo<int16_t>(read_int_in_range(&buffer, INT16_MIN, INT16_MAX));
+        glyph.fMaskFormat =
+                SkTo<uint8_t>(read_int_in_range(&buffer, 0, SkMask::kCountMaskFormats - 1));
+        glyph.fForceBW = buffer.readBool();
+
+        if (buffer.readBool()) {
+            uint32_t imageSize = buffer.readUInt();
+            if (!buffer.validate(imageSize == glyph.imageSize())) { break; }
+            glyph.fImage = const_cast<void*>(buffer.skip(imageSize));
+        }
+
+        uint32_t pathState = buffer.readUInt();
+        SkPath path;
+        if (pathState == kHasPath) {
+            buffer.readPath(&path);
+        }
+
+        if (!buffer.validate(true)) {
+            break;
+        }
+
+        auto [cached, glyphDelta] = cache->mergeGlyphAndImage(glyph.getPackedID(), glyph);
+        delta += glyphDelta;
+        if (pathState != kPathNotSet) {
+            auto [_, pathDelta] = cache->mergePath(cached, pathState == kHasPath ? &path : nullptr);
+            delta += pathDelta;
+        }
+    }
+
+    return delta;
+}
+
+void SkStrikePersistentCache::save(const SkScalerCache& cache) {
+    const SkTypeface& typeface = *cache.getScalerContext()->getTypeface();
+    SkAutoDescriptor normalized;
+    SkString path;
+    uint32_t hash;
+    if (!this->fileName(cache.getDescriptor(), typeface, &normalized, &path, &hash)) {
+        return;
+    }
+
+    SkBinaryWriteBuffer buffer;
+    buffer.writeUInt(kMagic);
+    buffer.writeUInt(kVersion);
+    buffer.writeUInt(hash);
+    buffer.writeByteArray(normalized.getDesc(), normalized.getDesc()->getLength());
+    buffer.writeByteArray(&cache.getFontMetrics(), sizeof(SkFontMetrics));
+
+    cache.forEachGlyph([&](const SkGlyph& glyph) {
+        buffer.writeBool(true);
+        buffer.writeUInt(glyph.getPackedID().value());
+        buffer.writeScalar(glyph.fAdvanceX);
+        buffer.writeScalar(glyph.fAdvanceY);
+        buffer.writeInt(glyph.fWidth);
+        buffer.writeInt(glyph.fHeight);
+        buffer.writeInt(glyph.fTop);
+        buffer.writeInt(glyph.fLeft);
+        buffer.writeInt(glyph.fMaskFormat);
+        buffer.writeBool(glyph.fForceBW);
+
+        bool hasImage = glyph.fImage != nullptr;
+        buffer.writeBool(hasImage);
+        if (hasImage) {
+            buffer.writeByteArray(glyph.fImage, glyph.imageSize());
+        }
+
+        if (!glyph.setPathHasBeenCalled()) {
+            buffer.writeUInt(kPathNotSet);
+        } else if (glyph.path() == nullptr) {
+            buffer.writeUInt(kNoPath);
+        } else {
+            buffer.writeUInt(kHasPath);
+            buffer.writePath(*glyph.path());
+        }
+    });
+    buffer.writeBool(false);
+
+    // Write to a private file and rename it into place, so another process never maps a file
+    // that is partly written.
+    SkString tempPath = SkStringPrintf("%s.%llx.tmp", path.c_str(),
+                                       (unsigned long long)SkTime::GetNSecs());
+    {
+        SkFILEWStream stream{tempPath.c_str()};
+        if (!stream.isValid() || !buffer.writeToStream(&stream)) {
+            return;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+    }
+}
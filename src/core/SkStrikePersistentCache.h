@@ -0,0 +1,65 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrikePersistentCache_DEFINED
+#define SkStrikePersistentCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+
+class SkAutoDescriptor;
+class SkDescriptor;
+class SkReadBuffer;
+class SkScalerCache;
+struct SkFontMetrics;
+
+// SkStrikePersistentCache keeps the glyphs of strikes in files in a directory so a later process
+// can fill its strikes without asking the scaler context for the same metrics, images and paths
+// again. Each strike is stored in its own file, named by a hash of the typeface's font data and
+// the checksum of the strike's descriptor with the process specific font id removed. The files
+// are mapped when read, and are replaced as a whole when written.
+class SkStrikePersistentCache : public SkNVRefCnt<SkStrikePersistentCache> {
+public:
+    explicit SkStrikePersistentCache(const char* directory);
+
+    // Return the saved data for the strike described by desc, or nullptr if there is none. On
+    // success, metrics is set to the saved font metrics.
+    sk_sp<SkData> find(const SkDescriptor& desc, const SkTypeface& typeface,
+                       SkFontMetrics* metrics);
+
+    // Add the glyphs from data returned by find to cache. Returns the number of bytes added to
+    // the cache.
+    static size_t LoadGlyphs(const SkData& data, SkScalerCache* cache);
+
+    // Save all the glyphs in cache, replacing any earlier file for the strike.
+    void save(const SkScalerCache& cache);
+
+private:
+    // Return a hash of the font data and variation of typeface, or 0 if the data is not
+    // available.
+    uint32_t typefaceHash(const SkTypeface& typeface) SK_EXCLUDES(fMutex);
+
+    // Find the file name for desc and typeface, and make a copy of desc that does not depend on
+    // the typeface's id. Returns false if the strike can't be stored.
+    bool fileName(const SkDescriptor& desc, const SkTypeface& typeface,
+                  SkAutoDescriptor* normalized, SkString* path, uint32_t* hash);
+
+    static bool ReadHeader(SkReadBuffer* buffer, uint32_t typefaceHash,
+                           const SkDescriptor& normalized, SkFontMetrics* metrics);
+
+    const SkString fDirectory;
+
+    SkMutex fMutex;
+    SkTHashMap<SkFontID, uint32_t> fTypefaceHashes SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkStrikePersistentCache_DEFINED
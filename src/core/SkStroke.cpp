@@ -9,10 +9,12 @@
 
 #include "include/private/SkMacros.h"
 #include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
 
+#include <algorithm>
 #include <utility>
 
 enum {
@@ -135,6 +137,12 @@ public:
 
     void moveTo(const SkPoint&);
     void lineTo(const SkPoint&, const SkPath::Iter* iter = nullptr);
+    // Line-only paths can name their points by index, so their normals can be computed ahead.
+    void setPolyline(const SkPoint pts[], int count) {
+        fPolylinePts = pts;
+        fPolylineCount = count;
+    }
+    void polylineTo(int ptIndex, const SkPath::Iter* iter);
     void quadTo(const SkPoint&, const SkPoint&);
     void conicTo(const SkPoint&, const SkPoint&, SkScalar weight);
     void cubicTo(const SkPoint&, const SkPoint&, const SkPoint&);
@@ -172,6 +180,16 @@ private:
 
     SkPath  fInner, fOuter, fCusper; // outer is our working answer, inner is temp
 
+    // The unit normals of the polyline's segments are computed kLineNormalBatch at a time.
+    // fLineNormals[i] belongs to the segment ending at fPolylinePts[fLineNormalsStart + i],
+    // and is (0,0) if that segment can't be normalized.
+    static constexpr int kLineNormalBatch = 64;
+    const SkPoint*  fPolylinePts = nullptr;
+    int             fPolylineCount = 0;
+    int             fLineNormalsStart = 0;
+    int             fLineNormalsCount = 0;
+    SkVector        fLineNormals[kLineNormalBatch];
+
     enum StrokeType {
         kOuter_StrokeType = 1,      // use sign-opposite values later to flip perpendicular axis
         kInner_StrokeType = -1
@@ -243,10 +261,14 @@ private:
     void    finishContour(bool close, bool isLine);
     bool    preJoinTo(const SkPoint&, SkVector* normal, SkVector* unitNormal,
                       bool isLine);
+    void    joinTo(const SkVector& normal, const SkVector& unitNormal, bool isLine);
     void    postJoinTo(const SkPoint&, const SkVector& normal,
                        const SkVector& unitNormal);
 
     void    line_to(const SkPoint& currPt, const SkVector& normal);
+
+    void            computeLineNormals(int ptIndex);
+    const SkVector* lineUnitNormal(int ptIndex);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -255,9 +277,6 @@ bool SkPathStroker::preJoinTo(const SkPoint& currPt, SkVector* normal,
                               SkVector* unitNormal, bool currIsLine) {
     SkASSERT(fSegmentCount >= 0);
 
-    SkScalar    prevX = fPrevPt.fX;
-    SkScalar    prevY = fPrevPt.fY;
-
     if (!set_normal_unitnormal(fPrevPt, currPt, fResScale, fRadius, normal, unitNormal)) {
         if (SkStrokerPriv::CapFactory(SkPaint::kButt_Cap) == fCapper) {
             return false;
@@ -268,20 +287,26 @@ bool SkPathStroker::preJoinTo(const SkPoint& currPt, SkVector* normal,
         normal->set(fRadius, 0);
         unitNormal->set(1, 0);
     }
+    this->joinTo(*normal, *unitNormal, currIsLine);
+    return true;
+}
+
+void SkPathStroker::joinTo(const SkVector& normal, const SkVector& unitNormal, bool currIsLine) {
+    SkScalar    prevX = fPrevPt.fX;
+    SkScalar    prevY = fPrevPt.fY;
 
     if (fSegmentCount == 0) {
-        fFirstNormal = *normal;
-        fFirstUnitNormal = *unitNormal;
-        fFirstOuterPt.set(prevX + normal->fX, prevY + normal->fY);
+        fFirstNormal = normal;
+        fFirstUnitNormal = unitNormal;
+        fFirstOuterPt.set(prevX + normal.fX, prevY + normal.fY);
 
         fOuter.moveTo(fFirstOuterPt.fX, fFirstOuterPt.fY);
-        fInner.moveTo(prevX - normal->fX, prevY - normal->fY);
+        fInner.moveTo(prevX - normal.fX, prevY - normal.fY);
     } else {    // we have a previous segment
-        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, *unitNormal,
+        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, unitNormal,
                 fRadius, fInvMiterLimit, fPrevIsLine, currIsLine);
     }
     fPrevIsLine = currIsLine;
-    return true;
 }
 
 void SkPathStroker::postJoinTo(const SkPoint& currPt, const SkVector& normal,
@@ -447,6 +472,82 @@ void SkPathStroker::lineTo(const SkPoint& currPt, const SkPath::Iter* iter) {
     this->postJoinTo(currPt, normal, unitNormal);
 }
 
+void SkPathStroker::computeLineNormals(int ptIndex) {
+    SkASSERT(ptIndex > 0 && ptIndex < fPolylineCount);
+    using F4 = skvx::Vec<4, float>;
+    using D4 = skvx::Vec<4, double>;
+
+    const int count = std::min(kLineNormalBatch, fPolylineCount - ptIndex);
+    const SkPoint* pts = fPolylinePts + ptIndex;
+    fLineNormalsStart = ptIndex;
+    fLineNormalsCount = count;
+
+    // This matches set_normal_unitnormal() bit for bit: setNormalize() computes the length and
+    // its reciprocal in doubles, and scales the float vector by it.
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto p0 = skvx::Vec<8, float>::Load(pts + i - 1),
+             p1 = skvx::Vec<8, float>::Load(pts + i);
+        F4 dx = (skvx::shuffle<0,2,4,6>(p1) - skvx::shuffle<0,2,4,6>(p0)) * fResScale,
+           dy = (skvx::shuffle<1,3,5,7>(p1) - skvx::shuffle<1,3,5,7>(p0)) * fResScale;
+        D4 xx = skvx::cast<double>(dx),
+           yy = skvx::cast<double>(dy);
+        D4 scale = 1.0 / sqrt(xx * xx + yy * yy);
+        F4 ux = skvx::cast<float>(xx * scale),
+           uy = skvx::cast<float>(yy * scale);
+        for (int j = 0; j < 4; ++j) {
+            if (SkScalarsAreFinite(ux[j], uy[j]) && (ux[j] != 0 || uy[j] != 0)) {
+                fLineNormals[i + j].set(uy[j], -ux[j]);
+            } else {
+                fLineNormals[i + j].set(0, 0);
+            }
+        }
+    }
+    for (; i < count; ++i) {
+        SkVector normal;
+        if (!set_normal_unitnormal(pts[i - 1], pts[i], fResScale, fRadius, &normal,
+                                   &fLineNormals[i])) {
+            fLineNormals[i].set(0, 0);
+        }
+    }
+}
+
+const SkVector* SkPathStroker::lineUnitNormal(int ptIndex) {
+    // If a short line was skipped, the segment starts somewhere else.
+    if (fPrevPt != fPolylinePts[ptIndex - 1]) {
+        return nullptr;
+    }
+    if (ptIndex < fLineNormalsStart || ptIndex >= fLineNormalsStart + fLineNormalsCount) {
+        this->computeLineNormals(ptIndex);
+    }
+    const SkVector* unitNormal = &fLineNormals[ptIndex - fLineNormalsStart];
+    return unitNormal->fX == 0 && unitNormal->fY == 0 ? nullptr : unitNormal;
+}
+
+void SkPathStroker::polylineTo(int ptIndex, const SkPath::Iter* iter) {
+    SkASSERT(fPolylinePts && ptIndex < fPolylineCount);
+    const SkPoint& currPt = fPolylinePts[ptIndex];
+    const SkVector* unitNormal = this->lineUnitNormal(ptIndex);
+    if (!unitNormal) {
+        this->lineTo(currPt, iter);
+        return;
+    }
+
+    bool teenyLine = SkPointPriv::EqualsWithinTolerance(fPrevPt, currPt, SK_ScalarNearlyZero * fInvResScale);
+    if (SkStrokerPriv::CapFactory(SkPaint::kButt_Cap) == fCapper && teenyLine) {
+        return;
+    }
+    if (teenyLine && (fJoinCompleted || (iter && has_valid_tangent(iter)))) {
+        return;
+    }
+    SkVector normal;
+    unitNormal->scale(fRadius, &normal);
+
+    this->joinTo(normal, *unitNormal, true);
+    this->line_to(currPt, normal);
+    this->postJoinTo(currPt, normal, *unitNormal);
+}
+
 void SkPathStroker::setQuadEndNormal(const SkPoint quad[3], const SkVector& normalAB,
         const SkVector& unitNormalAB, SkVector* normalBC, SkVector* unitNormalBC) {
     if (!set_normal_unitnormal(quad[1], quad[2], fResScale, fRadius, normalBC, unitNormalBC)) {
@@ -1413,14 +1514,29 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
     SkPath::Iter    iter(src, false);
     SkPath::Verb    lastSegment = SkPath::kMove_Verb;
 
+    // Polylines (including curves that were flattened before stroking) are common and long, so
+    // their segment normals are computed in batches. Every move and every line that isn't the
+    // implied closing line consumes one point, so we can track which point the iterator is on.
+    const bool isPolyline = (src.getSegmentMasks() == SkPath::kLine_SegmentMask);
+    if (isPolyline) {
+        stroker.setPolyline(SkPathPriv::PointData(src), src.countPoints());
+    }
+    int ptIndex = -1;
+
     for (;;) {
         SkPoint  pts[4];
         switch (iter.next(pts)) {
             case SkPath::kMove_Verb:
+                ptIndex += 1;
                 stroker.moveTo(pts[0]);
                 break;
             case SkPath::kLine_Verb:
-                stroker.lineTo(pts[1], &iter);
+                if (isPolyline && !iter.isCloseLine()) {
+                    ptIndex += 1;
+                    stroker.polylineTo(ptIndex, &iter);
+                } else {
+                    stroker.lineTo(pts[1], &iter);
+                }
                 lastSegment = SkPath::kLine_Verb;
                 break;
             case SkPath::kQuad_Verb:
@@ -17,6 +17,7 @@
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkSurfacePriv.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/core/SkTypefaceCmapCache.h"
 #include "src/sfnt/SkOTTable_OS_2.h"
 
 SkTypeface::SkTypeface(const SkFontStyle& style, bool isFixedPitch)
@@ -295,15 +296,20 @@ std::unique_ptr<SkFontData> SkTypeface::onMakeFontData() const {
     return std::make_unique<SkFontData>(std::move(stream), index, nullptr, 0);
 };
 
+SkTypefaceCmapCache* SkTypeface::cmapCache() const {
+    fCmapCacheOnce([this] { fCmapCache = std::make_unique<SkTypefaceCmapCache>(); });
+    return fCmapCache.get();
+}
+
 void SkTypeface::unicharsToGlyphs(const SkUnichar uni[], int count, SkGlyphID glyphs[]) const {
     if (count > 0 && glyphs && uni) {
-        this->onCharsToGlyphs(uni, count, glyphs);
+        this->cmapCache()->charsToGlyphs(*this, uni, count, glyphs);
     }
 }
 
 SkGlyphID SkTypeface::unicharToGlyph(SkUnichar uni) const {
     SkGlyphID glyphs[1] = { 0 };
-    this->onCharsToGlyphs(&uni, 1, glyphs);
+    this->cmapCache()->charsToGlyphs(*this, &uni, 1, glyphs);
     return glyphs[0];
 }
 
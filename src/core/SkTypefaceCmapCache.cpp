@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkTypefaceCmapCache.h"
+
+#include "include/core/SkTypeface.h"
+#include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
+
+#include <memory>
+
+SkTypefaceCmapCache::~SkTypefaceCmapCache() {
+    for (auto& block : fBlocks) {
+        delete[] block.load(std::memory_order_relaxed);
+    }
+}
+
+const SkGlyphID* SkTypefaceCmapCache::makeBlock(const SkTypeface& typeface, int index) {
+    SkUnichar chars[kBlockSize];
+    for (int i = 0; i < kBlockSize; i++) {
+        chars[i] = (index << kBlockBits) + i;
+    }
+    std::unique_ptr<SkGlyphID[]> block{new SkGlyphID[kBlockSize]};
+    typeface.onCharsToGlyphs(chars, kBlockSize, block.get());
+
+    // If another thread published the block first, use theirs; both have the same glyphs.
+    const SkGlyphID* expected = nullptr;
+    if (fBlocks[index].compare_exchange_strong(expected, block.get(),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+        return block.release();
+    }
+    return expected;
+}
+
+SkGlyphID SkTypefaceCmapCache::supplementaryCharToGlyph(const SkTypeface& typeface, SkUnichar c) {
+    {
+        SkAutoMutexExclusive lock{fSupplementaryMutex};
+        int index = fSupplementary.findGlyphIndex(c);
+        if (index >= 0) {
+            return SkToU16(index);
+        }
+    }
+
+    // Don't hold the lock while calling the font host.
+    SkGlyphID glyph = 0;
+    typeface.onCharsToGlyphs(&c, 1, &glyph);
+
+    SkAutoMutexExclusive lock{fSupplementaryMutex};
+    fSupplementary.addCharAndGlyph(c, glyph);
+    return glyph;
+}
+
+SkGlyphID SkTypefaceCmapCache::charToGlyph(const SkTypeface& typeface, SkUnichar c) {
+    if (0 <= c && c < 0x10000) {
+        const SkGlyphID* block = fBlocks[c >> kBlockBits].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            block = this->makeBlock(typeface, c >> kBlockBits);
+        }
+        return block[c & (kBlockSize - 1)];
+    }
+
+    if (c <= 0x10FFFF) {
+        return this->supplementaryCharToGlyph(typeface, c);
+    }
+
+    // Not a character; let the font host decide what to do with it.
+    SkGlyphID glyph = 0;
+    typeface.onCharsToGlyphs(&c, 1, &glyph);
+    return glyph;
+}
+
+void SkTypefaceCmapCache::charsToGlyphs(const SkTypeface& typeface,
+                                        const SkUnichar chars[], int count, SkGlyphID glyphs[]) {
+    using U32 = skvx::Vec<8, uint32_t>;
+
+    // Most text is runs of Latin-1. Check 8 characters at a time, and look them up in the first
+    // block without going through charToGlyph.
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const SkGlyphID* latin1 = fBlocks[0].load(std::memory_order_acquire);
+        // Negative values become large unsigned values, and fail the test.
+        U32 c = skvx::bit_pun<U32>(skvx::Vec<8, int32_t>::Load(chars + i));
+        if (latin1 != nullptr && skvx::all(c < kBlockSize)) {
+            for (int j = 0; j < 8; j++) {
+                glyphs[i + j] = latin1[c[j]];
+            }
+        } else {
+            for (int j = 0; j < 8; j++) {
+                glyphs[i + j] = this->charToGlyph(typeface, chars[i + j]);
+            }
+        }
+    }
+    for (; i < count; i++) {
+        glyphs[i] = this->charToGlyph(typeface, chars[i]);
+    }
+}
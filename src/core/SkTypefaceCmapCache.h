@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTypefaceCmapCache_DEFINED
+#define SkTypefaceCmapCache_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "include/private/SkMutex.h"
+#include "src/utils/SkCharToGlyphCache.h"
+
+#include <atomic>
+
+class SkTypeface;
+
+// SkTypefaceCmapCache remembers the character to glyph mapping of a typeface, so that the font
+// host is only asked once for each character no matter how many fonts use the typeface.
+//
+// The Basic Multilingual Plane is split into blocks of 256 characters. The first character looked
+// up in a block fills the whole block with one call to the font host, and the block is published
+// with an atomic pointer so later lookups in the block don't lock. Characters in the
+// supplementary planes are rare and sparse, so they are kept in an SkCharToGlyphCache behind a
+// mutex.
+class SkTypefaceCmapCache {
+public:
+    SkTypefaceCmapCache() = default;
+    ~SkTypefaceCmapCache();
+
+    // Same as SkTypeface::unicharsToGlyphs, using typeface for characters not yet cached.
+    void charsToGlyphs(const SkTypeface& typeface,
+                       const SkUnichar chars[], int count, SkGlyphID glyphs[]);
+
+private:
+    static constexpr int kBlockBits = 8;
+    static constexpr int kBlockSize = 1 << kBlockBits;
+    static constexpr int kBlockCount = 0x10000 >> kBlockBits;
+
+    SkGlyphID charToGlyph(const SkTypeface& typeface, SkUnichar c);
+
+    // Fill in and publish the block for the characters [index << kBlockBits, (index + 1) <<
+    // kBlockBits).
+    const SkGlyphID* makeBlock(const SkTypeface& typeface, int index);
+
+    SkGlyphID supplementaryCharToGlyph(const SkTypeface& typeface, SkUnichar c);
+
+    std::atomic<const SkGlyphID*> fBlocks[kBlockCount] = {};
+
+    SkMutex fSupplementaryMutex;
+    SkCharToGlyphCache fSupplementary SK_GUARDED_BY(fSupplementaryMutex);
+};
+
+#endif  // SkTypefaceCmapCache_DEFINED
@@ -14,9 +14,9 @@
 #include "include/core/SkSize.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkIPoint16.h"
+#include "src/core/SkRectanizerSkyline.h"
 #include "src/core/SkTInternalLList.h"
 
-#include "src/gpu/GrRectanizerSkyline.h"
 #include "src/gpu/ops/GrDrawOp.h"
 
 class GrOnFlushResourceProvider;
@@ -370,7 +370,7 @@ private:
         const int fHeight;
         const int fX;
         const int fY;
-        GrRectanizerSkyline fRectanizer;
+        SkRectanizerSkyline fRectanizer;
         const SkIPoint16 fOffset;  // the offset of the plot in the backing texture
         const GrColorType fColorType;
         const size_t fBytesPerPixel;
@@ -7,9 +7,9 @@
 
 #include "src/gpu/GrDynamicAtlas.h"
 
+#include "src/core/SkRectanizerSkyline.h"
 #include "src/gpu/GrOnFlushResourceProvider.h"
 #include "src/gpu/GrProxyProvider.h"
-#include "src/gpu/GrRectanizerSkyline.h"
 #include "src/gpu/GrRenderTarget.h"
 #include "src/gpu/GrRenderTargetContext.h"
 
@@ -42,7 +42,7 @@ public:
 private:
     const std::unique_ptr<Node> fPrevious;
     const int fX, fY;
-    GrRectanizerSkyline fRectanizer;
+    SkRectanizerSkyline fRectanizer;
 };
 
 sk_sp<GrTextureProxy> GrDynamicAtlas::MakeLazyAtlasProxy(
@@ -8,6 +8,7 @@
 #ifndef SkBlitMask_opts_DEFINED
 #define SkBlitMask_opts_DEFINED
 
+#include "include/private/SkVx.h"
 #include "src/core/Sk4px.h"
 
 namespace SK_OPTS_NS {
@@ -154,6 +155,90 @@ namespace SK_OPTS_NS {
         } while (--height != 0);
     }
 
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // With AVX2 we blend 8 pixels at a time, 32 bytes to a register. The math is the same as the
+    // Sk4px code below, so both give exactly the same results.
+    using U8x8  = skvx::Vec< 8, uint8_t>;
+    using U8x32 = skvx::Vec<32, uint8_t>;
+
+    // (x*y + x) / 256, as in Sk4px::approxMulDiv255().
+    static inline U8x32 approx_mul_div_255(const U8x32& x, const U8x32& y) {
+        return skvx::cast<uint8_t>((mull(x, y) + skvx::cast<uint16_t>(x)) >> 8);
+    }
+
+    static inline U8x32 alphas(const U8x32& px) {
+        return skvx::shuffle< 3, 3, 3, 3,  7, 7, 7, 7, 11,11,11,11, 15,15,15,15,
+                             19,19,19,19, 23,23,23,23, 27,27,27,27, 31,31,31,31>(px);
+    }
+
+    // Like Sk4px::MapDstAlpha(), fn takes 8 dst pixels and their 8 mask values, each repeated 4
+    // times, and returns the 8 new dst pixels.
+    template <typename Fn>
+    static void map_dst_alpha_8(int w, SkPMColor* dst, const SkAlpha* mask, const Fn& fn) {
+        auto expand = [](const U8x8& aa) {
+            return skvx::shuffle<0,0,0,0, 1,1,1,1, 2,2,2,2, 3,3,3,3,
+                                 4,4,4,4, 5,5,5,5, 6,6,6,6, 7,7,7,7>(aa);
+        };
+        while (w >= 8) {
+            fn(U8x32::Load(dst), expand(U8x8::Load(mask))).store(dst);
+            dst  += 8;
+            mask += 8;
+            w    -= 8;
+        }
+        if (w > 0) {
+            SkPMColor d[8] = {0};
+            SkAlpha aa[8] = {0};
+            memcpy(d,  dst,  w * sizeof(SkPMColor));
+            memcpy(aa, mask, w * sizeof(SkAlpha));
+            fn(U8x32::Load(d), expand(U8x8::Load(aa))).store(d);
+            memcpy(dst, d, w * sizeof(SkPMColor));
+        }
+    }
+
+    static void blit_mask_d32_a8_general(SkPMColor* dst, size_t dstRB,
+                                         const SkAlpha* mask, size_t maskRB,
+                                         SkColor color, int w, int h) {
+        auto s = skvx::bit_pun<U8x32>(skvx::Vec<8, uint32_t>(SkPreMultiplyColor(color)));
+        auto fn = [&](const U8x32& d, const U8x32& aa) {
+            auto left = approx_mul_div_255(s, aa);
+            return left + approx_mul_div_255(d, 255 - alphas(left));
+        };
+        while (h --> 0) {
+            map_dst_alpha_8(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+
+    static void blit_mask_d32_a8_opaque(SkPMColor* dst, size_t dstRB,
+                                        const SkAlpha* mask, size_t maskRB,
+                                        SkColor color, int w, int h) {
+        SkASSERT(SkColorGetA(color) == 0xFF);
+        auto s = skvx::bit_pun<U8x32>(skvx::Vec<8, uint32_t>(SkPreMultiplyColor(color)));
+        auto fn = [&](const U8x32& d, const U8x32& aa) {
+            return approx_mul_div_255(s, aa) + approx_mul_div_255(d, 255 - aa);
+        };
+        while (h --> 0) {
+            map_dst_alpha_8(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+
+    static void blit_mask_d32_a8_black(SkPMColor* dst, size_t dstRB,
+                                       const SkAlpha* mask, size_t maskRB,
+                                       int w, int h) {
+        auto alphaOnly = skvx::bit_pun<U8x32>(skvx::Vec<8, uint32_t>(SK_A32_MASK << SK_A32_SHIFT));
+        auto fn = [&](const U8x32& d, const U8x32& aa) {
+            return (aa & alphaOnly) + approx_mul_div_255(d, 255 - aa);
+        };
+        while (h --> 0) {
+            map_dst_alpha_8(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+
 #else
     static void blit_mask_d32_a8_general(SkPMColor* dst, size_t dstRB,
                                          const SkAlpha* mask, size_t maskRB,
@@ -10,6 +10,7 @@
 #define SK_OPTS_NS hsw
 #include "src/core/SkCubicSolver.h"
 #include "src/opts/SkBitmapProcState_opts.h"
+#include "src/opts/SkBlitMask_opts.h"
 #include "src/opts/SkBlitRow_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
 #include "src/opts/SkUtils_opts.h"
@@ -18,6 +19,7 @@ namespace SkOpts {
     void Init_hsw() {
         blit_row_color32     = hsw::blit_row_color32;
         blit_row_s32a_opaque = hsw::blit_row_s32a_opaque;
+        blit_mask_d32_a8     = hsw::blit_mask_d32_a8;
 
         S32_alpha_D32_filter_DX  = hsw::S32_alpha_D32_filter_DX;
 
@@ -10,8 +10,14 @@
 #include "src/pathops/SkIntersectionHelper.h"
 #include "src/pathops/SkIntersections.h"
 
+#include <atomic>
+
 class SkOpCoincidence;
 
+// AddIntersectTs sweeps for the segment pairs to intersect when two contours have at least this
+// many pairs of segments.
+extern std::atomic<int64_t> gSkPathOpsSweepMinPairs;
+
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence);
 
 #endif
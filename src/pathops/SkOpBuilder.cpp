@@ -9,9 +9,15 @@
 #include "include/pathops/SkPathOps.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkRTree.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
 #include "src/pathops/SkPathOpsCommon.h"
 
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
     int verbCount = path.countVerbs();
@@ -193,3 +199,127 @@ bool SkOpBuilder::resolve(SkPath* result) {
     }
     return success;
 }
+
+bool SkOpBuilder::resolveBalanced(SkPath* result, SkExecutor* executor) {
+    int count = fOps.count();
+    for (int index = 0; index < count; ++index) {
+        if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+            return this->resolve(result);
+        }
+    }
+
+    // Group operands whose bounds overlap, directly or through other operands. Different groups
+    // cover disjoint areas, so each can be unioned on its own, and the results simply added.
+    // Bounds are outset a little so operands that share an edge are joined by the union.
+    std::vector<SkRect> bounds(count);
+    SkRect total = SkRect::MakeEmpty();
+    for (int index = 0; index < count; ++index) {
+        bounds[index] = fPathRefs[index].getBounds();
+        total.join(bounds[index]);
+    }
+    const SkScalar slop = std::max(total.width(), total.height()) * (1.0f / (1 << 16));
+    SkRTree rtree;
+    rtree.insert(bounds.data(), count);
+
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    std::vector<int> overlaps;
+    for (int index = 0; index < count; ++index) {
+        overlaps.clear();
+        rtree.search(bounds[index].makeOutset(slop, slop), &overlaps);
+        for (int other : overlaps) {
+            int a = find(index),
+                b = find(other);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    // Keep the groups in the order of their first operand.
+    std::vector<std::vector<SkPath>> groups;
+    std::vector<int> groupOf(count, -1);
+    for (int index = 0; index < count; ++index) {
+        int root = find(index);
+        if (groupOf[root] < 0) {
+            groupOf[root] = SkToInt(groups.size());
+            groups.emplace_back();
+        }
+        groups[groupOf[root]].push_back(std::move(fPathRefs[index]));
+    }
+    SkPath original = *result;
+    reset();
+
+    // Union each group pairwise, a level of the tree at a time, so each path is only combined
+    // with paths of about the same complexity. A group with a single operand is simplified
+    // instead, so that every group ends up in the same even-odd form.
+    struct Job {
+        SkPath*       fDst;
+        const SkPath* fSrc;  // nullptr to simplify fDst.
+    };
+    std::vector<Job> jobs;
+    for (auto& group : groups) {
+        if (group.size() == 1) {
+            jobs.push_back({&group[0], nullptr});
+        }
+    }
+    std::atomic<bool> failed{false};
+    for (;;) {
+        for (auto& group : groups) {
+            for (size_t i = 0; i + 1 < group.size(); i += 2) {
+                jobs.push_back({&group[i], &group[i + 1]});
+            }
+        }
+        if (jobs.empty()) {
+            break;
+        }
+
+        auto run = [&](int i) {
+            const Job& job = jobs[i];
+            bool success = job.fSrc ? Op(*job.fDst, *job.fSrc, kUnion_SkPathOp, job.fDst)
+                                    : Simplify(*job.fDst, job.fDst);
+            if (!success) {
+                failed = true;
+            }
+        };
+        if (executor != nullptr && jobs.size() > 1) {
+            SkTaskGroup(*executor).batch(SkToInt(jobs.size()), run);
+        } else {
+            for (int i = 0; i < SkToInt(jobs.size()); ++i) {
+                run(i);
+            }
+        }
+        if (failed) {
+            *result = original;
+            return false;
+        }
+        jobs.clear();
+
+        // The even paths now hold the unions; drop the odd ones.
+        for (auto& group : groups) {
+            for (size_t i = 2; i < group.size(); i += 2) {
+                group[i / 2] = std::move(group[i]);
+            }
+            group.resize((group.size() + 1) / 2);
+        }
+    }
+
+    if (groups.size() == 1) {
+        *result = std::move(groups[0][0]);
+        return true;
+    }
+    SkPath sum;
+    for (const auto& group : groups) {
+        sum.addPath(group[0]);
+    }
+    sum.setFillType(SkPathFillType::kEvenOdd);
+    *result = std::move(sum);
+    return true;
+}
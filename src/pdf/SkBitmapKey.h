@@ -18,5 +18,15 @@ struct SkBitmapKey {
     bool operator!=(const SkBitmapKey& rhs) const { return !(*this == rhs); }
 };
 
+// Key for an image that was embedded after being reduced by 1/fSampleSize.
+struct SkDownsampledBitmapKey {
+    SkBitmapKey fKey;
+    int fSampleSize;
+    bool operator==(const SkDownsampledBitmapKey& rhs) const {
+        return fKey == rhs.fKey && fSampleSize == rhs.fSampleSize;
+    }
+    bool operator!=(const SkDownsampledBitmapKey& rhs) const { return !(*this == rhs); }
+};
+
 
 #endif  // SkBitmapKey_DEFINED
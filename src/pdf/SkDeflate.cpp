@@ -26,6 +26,16 @@ template <typename T> void* skia_alloc_func(void*, T items, T size) {
 
 void skia_free_func(void*, void* address) { sk_free(address); }
 
+int to_zlib_strategy(SkDeflateWStream::Strategy strategy) {
+    switch (strategy) {
+        case SkDeflateWStream::Strategy::kDefault:     return Z_DEFAULT_STRATEGY;
+        case SkDeflateWStream::Strategy::kFiltered:    return Z_FILTERED;
+        case SkDeflateWStream::Strategy::kHuffmanOnly: return Z_HUFFMAN_ONLY;
+        case SkDeflateWStream::Strategy::kRLE:         return Z_RLE;
+    }
+    SkUNREACHABLE;
+}
+
 }  // namespace
 
 #define SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE 4096
@@ -66,7 +76,8 @@ struct SkDeflateWStream::Impl {
 
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
+                                   bool gzip,
+                                   Strategy strategy)
     : fImpl(std::make_unique<SkDeflateWStream::Impl>()) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
@@ -80,7 +91,7 @@ SkDeflateWStream::SkDeflateWStream(SkWStream* out,
     SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
     SkDEBUGCODE(int r =) deflateInit2(&fImpl->fZStream, compressionLevel,
                                       Z_DEFLATED, gzip ? 0x1F : 0x0F,
-                                      8, Z_DEFAULT_STRATEGY);
+                                      8, to_zlib_strategy(strategy));
     SkASSERT(Z_OK == r);
 }
 
@@ -19,6 +19,16 @@
   */
 class SkDeflateWStream final : public SkWStream {
 public:
+    /** Mirrors zlib's deflate strategies.  kRLE limits match distances to
+        one, which is much faster and suits image rows; kHuffmanOnly skips
+        string matching entirely. */
+    enum class Strategy {
+        kDefault,
+        kFiltered,
+        kHuffmanOnly,
+        kRLE,
+    };
+
     /** Does not take ownership of the stream.
 
         @param compressionLevel - 0 is no compression; 1 is best
@@ -29,10 +39,13 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, allowing a client to identify a gzip file.
+
+        @param strategy - tunes the compression algorithm; see Strategy.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel = -1,
-                     bool gzip = false);
+                     bool gzip = false,
+                     Strategy strategy = Strategy::kDefault);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
@@ -7,9 +7,11 @@
 
 #include "src/pdf/SkPDFBitmap.h"
 
+#include "include/codec/SkCodec.h"
 #include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkImageEncoder.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkColorData.h"
 #include "include/private/SkImageInfoPriv.h"
@@ -65,6 +67,13 @@ static SkColor get_neighbor_avg_color(const SkPixmap& bm, int xOrig, int yOrig)
                  : SK_ColorTRANSPARENT;
 }
 
+// How an image stream's data is encoded.
+enum class ImageFilter {
+    kNone,
+    kFlate,
+    kDCT,
+};
+
 template <typename T>
 static void emit_image_stream(SkPDFDocument* doc,
                               SkPDFIndirectReference ref,
@@ -73,7 +82,7 @@ static void emit_image_stream(SkPDFDocument* doc,
                               const char* colorSpace,
                               SkPDFIndirectReference sMask,
                               int length,
-                              bool isJpeg) {
+                              ImageFilter filter) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
     pdfDict.insertInt("Width", size.width());
@@ -83,27 +92,45 @@ static void emit_image_stream(SkPDFDocument* doc,
         pdfDict.insertRef("SMask", sMask);
     }
     pdfDict.insertInt("BitsPerComponent", 8);
+    const char* filterName = filter == ImageFilter::kDCT   ? "DCTDecode"
+                           : filter == ImageFilter::kFlate ? "FlateDecode"
+                                                           : nullptr;
     #ifdef SK_PDF_BASE85_BINARY
     auto filters = SkPDFMakeArray();
     filters->appendName("ASCII85Decode");
-    filters->appendName(isJpeg ? "DCTDecode" : "FlateDecode");
+    if (filterName) {
+        filters->appendName(filterName);
+    }
     pdfDict.insertObject("Filter", std::move(filters));
     #else
-    pdfDict.insertName("Filter", isJpeg ? "DCTDecode" : "FlateDecode");
+    if (filterName) {
+        pdfDict.insertName("Filter", filterName);
+    }
     #endif
-    if (isJpeg) {
+    if (filter == ImageFilter::kDCT) {
         pdfDict.insertInt("ColorTransform", 0);
     }
     pdfDict.insertInt("Length", length);
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
+// Returns a stream that deflates into dst, or nullptr if the document asked for uncompressed
+// streams.
+static std::unique_ptr<SkDeflateWStream> make_deflate_stream(SkPDFDocument* doc, SkWStream* dst) {
+    if (doc->metadata().fCompressionLevel == SkPDF::Metadata::CompressionLevel::kNone) {
+        return nullptr;
+    }
+    return std::make_unique<SkDeflateWStream>(dst, doc->deflateLevel(), false,
+                                              doc->deflateStrategy());
+}
+
 static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    std::unique_ptr<SkDeflateWStream> deflateWStream = make_deflate_stream(doc, &buffer);
+    SkWStream* out = deflateWStream ? static_cast<SkWStream*>(deflateWStream.get()) : &buffer;
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
-        buffer.write(pm.addr8(), pm.width() * pm.height());
+        out->write(pm.addr8(), pm.width() * pm.height());
     } else {
         SkASSERT(pm.alphaType() == kUnpremul_SkAlphaType);
         SkASSERT(pm.colorType() == kBGRA_8888_SkColorType);
@@ -117,13 +144,15 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
         while (ptr != stop) {
             *dst++ = 0xFF & ((*ptr++) >> SK_BGRA_A32_SHIFT);
             if (dst == bufferStop) {
-                deflateWStream.write(byteBuffer, sizeof(byteBuffer));
+                out->write(byteBuffer, sizeof(byteBuffer));
                 dst = byteBuffer;
             }
         }
-        deflateWStream.write(byteBuffer, dst - byteBuffer);
+        out->write(byteBuffer, dst - byteBuffer);
+    }
+    if (deflateWStream) {
+        deflateWStream->finalize();
     }
-    deflateWStream.finalize();
 
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
@@ -131,7 +160,7 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
     int length = SkToInt(buffer.bytesWritten());
     emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
                       pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(),
-                      length, false);
+                      length, deflateWStream ? ImageFilter::kFlate : ImageFilter::kNone);
 }
 
 static void do_deflated_image(const SkPixmap& pm,
@@ -143,16 +172,17 @@ static void do_deflated_image(const SkPixmap& pm,
         sMask = doc->reserveRef();
     }
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    std::unique_ptr<SkDeflateWStream> deflateWStream = make_deflate_stream(doc, &buffer);
+    SkWStream* out = deflateWStream ? static_cast<SkWStream*>(deflateWStream.get()) : &buffer;
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
-            fill_stream(&deflateWStream, '\x00', pm.width() * pm.height());
+            fill_stream(out, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
             SkASSERT(sMask.fValue = -1);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
-            deflateWStream.write(pm.addr8(), pm.width() * pm.height());
+            out->write(pm.addr8(), pm.width() * pm.height());
             break;
         default:
             colorSpace = "DeviceRGB";
@@ -174,27 +204,30 @@ static void do_deflated_image(const SkPixmap& pm,
                     *dst++ = SkColorGetG(color);
                     *dst++ = SkColorGetB(color);
                     if (dst == bufferStop) {
-                        deflateWStream.write(byteBuffer, sizeof(byteBuffer));
+                        out->write(byteBuffer, sizeof(byteBuffer));
                         dst = byteBuffer;
                     }
                 }
             }
-            deflateWStream.write(byteBuffer, dst - byteBuffer);
+            out->write(byteBuffer, dst - byteBuffer);
+    }
+    if (deflateWStream) {
+        deflateWStream->finalize();
     }
-    deflateWStream.finalize();
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
     int length = SkToInt(buffer.bytesWritten());
     emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), colorSpace, sMask, length, false);
+                      pm.info().dimensions(), colorSpace, sMask, length,
+                      deflateWStream ? ImageFilter::kFlate : ImageFilter::kNone);
     if (!isOpaque) {
         do_deflated_alpha(pm, doc, sMask);
     }
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+// Returns true if the JPEG data can be embedded as-is for an image of the given size.
+static bool is_embeddable_jpeg(const SkData* data, SkISize size, bool* yuv) {
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
@@ -202,11 +235,17 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
                        &jpegColorType, &exifOrientation)) {
         return false;
     }
-    bool yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
-    bool goodColorType = yuv || jpegColorType == SkEncodedInfo::kGray_Color;
-    if (jpegSize != size  // Sanity check.
-            || !goodColorType
-            || kTopLeft_SkEncodedOrigin != exifOrientation) {
+    *yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
+    bool goodColorType = *yuv || jpegColorType == SkEncodedInfo::kGray_Color;
+    return jpegSize == size  // Sanity check.
+        && goodColorType
+        && kTopLeft_SkEncodedOrigin == exifOrientation;
+}
+
+static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
+                    SkPDFIndirectReference ref) {
+    bool yuv;
+    if (!is_embeddable_jpeg(data.get(), size, &yuv)) {
         return false;
     }
     #ifdef SK_PDF_BASE85_BINARY
@@ -217,11 +256,15 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
 
     emit_image_stream(doc, ref,
                       [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), true);
+                      size, yuv ? "DeviceRGB" : "DeviceGray",
+                      SkPDFIndirectReference(), SkToInt(data->size()), ImageFilter::kDCT);
     return true;
 }
 
+// Re-encoding quality used when the document asks for lossless images; the
+// source is already lossy, so this only trades a little more size for fidelity.
+static constexpr int kDownsampledJpegDefaultQuality = 90;
+
 static SkBitmap to_pixels(const SkImage* image) {
     SkBitmap bm;
     int w = image->width(),
@@ -288,3 +331,51 @@ SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
     serialize_image(img, encodingQuality, doc, ref);
     return ref;
 }
+
+int SkPDFJpegSampleSize(const SkImage* img, const SkISize& neededSize) {
+    SkASSERT(img);
+    if (neededSize.isEmpty()) {
+        return 1;
+    }
+    sk_sp<SkData> data = img->refEncodedData();
+    bool yuv;
+    if (!data || !is_embeddable_jpeg(data.get(), img->dimensions(), &yuv)) {
+        return 1;
+    }
+    // libjpeg-turbo can scale by 1/2, 1/4 and 1/8 in the DCT domain.
+    int sampleSize = 1;
+    while (sampleSize < 8 &&
+           img->width()  >= 2 * sampleSize * neededSize.width() &&
+           img->height() >= 2 * sampleSize * neededSize.height()) {
+        sampleSize *= 2;
+    }
+    return sampleSize;
+}
+
+/*  Let the JPEG decoder reduce the image while it is still in the DCT domain
+    (libjpeg-turbo only computes a 1/2, 1/4 or 1/8 sized IDCT per block), so
+    the full-resolution pixels are never materialized.  The reduced pixels are
+    then re-encoded, which is cheap at that size. */
+sk_sp<SkImage> SkPDFDownsampleJpeg(const SkImage* img, int sampleSize, int encodingQuality) {
+    SkASSERT(img);
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(img->refEncodedData());
+    if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG) {
+        return nullptr;
+    }
+    SkISize scaledSize = codec->getScaledDimensions(1.0f / sampleSize);
+    if (scaledSize == codec->dimensions()) {
+        return nullptr;
+    }
+    SkImageInfo info = codec->getInfo().makeDimensions(scaledSize)
+                                       .makeAlphaType(kOpaque_SkAlphaType);
+    if (info.colorType() != kGray_8_SkColorType) {
+        info = info.makeColorType(kN32_SkColorType);
+    }
+    SkBitmap bm;
+    if (!bm.tryAllocPixels(info) || SkCodec::kSuccess != codec->getPixels(bm.pixmap())) {
+        return nullptr;
+    }
+    int quality = encodingQuality <= 100 ? encodingQuality : kDownsampledJpegDefaultQuality;
+    sk_sp<SkData> jpeg = SkEncodePixmap(bm.pixmap(), SkEncodedImageFormat::kJPEG, quality);
+    return jpeg ? SkImage::MakeFromEncoded(std::move(jpeg)) : nullptr;
+}
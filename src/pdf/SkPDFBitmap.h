@@ -7,8 +7,11 @@
 #ifndef SkPDFBitmap_DEFINED
 #define SkPDFBitmap_DEFINED
 
+#include "include/core/SkRefCnt.h"
+
 class SkImage;
 class SkPDFDocument;
+struct SkISize;
 struct SkPDFIndirectReference;
 
 /**
@@ -19,4 +22,17 @@ SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
                                            int encodingQuality = 101);
 
+/**
+ *  If img is backed by JPEG data that could be embedded directly, return the
+ *  largest DCT scaling factor (2, 4 or 8) that still leaves at least
+ *  neededSize pixels.  Returns 1 if the image should not be downsampled.
+ */
+int SkPDFJpegSampleSize(const SkImage* img, const SkISize& neededSize);
+
+/**
+ *  Decode img's JPEG data reduced by sampleSize and re-encode it as a JPEG
+ *  image.  Returns nullptr if it could not be reduced.
+ */
+sk_sp<SkImage> SkPDFDownsampleJpeg(const SkImage* img, int sampleSize, int encodingQuality);
+
 #endif  // SkPDFBitmap_DEFINED
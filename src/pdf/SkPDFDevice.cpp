@@ -1683,6 +1683,32 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     }
 
     SkBitmapKey key = imageSubset.key();
+    if (fDocument->metadata().fDownsampleJpegs) {
+        // Device space is already at fRasterDPI, so |scaled| maps the unit
+        // square to the number of device pixels the image covers.
+        SkISize neededSize = SkSize::Make(scaled.mapVector(1, 0).length(),
+                                          scaled.mapVector(0, 1).length()).toCeil();
+        int sampleSize = SkPDFJpegSampleSize(imageSubset.image().get(), neededSize);
+        if (sampleSize > 1) {
+            SkDownsampledBitmapKey downsampledKey = {key, sampleSize};
+            SkPDFIndirectReference* ptr = fDocument->fPDFDownsampledJpegMap.find(downsampledKey);
+            if (!ptr) {
+                // If the image can't be reduced, remember that with a null reference and
+                // draw the full size image below, so it is only embedded once.
+                int quality = fDocument->metadata().fEncodingQuality;
+                sk_sp<SkImage> reduced =
+                        SkPDFDownsampleJpeg(imageSubset.image().get(), sampleSize, quality);
+                ptr = fDocument->fPDFDownsampledJpegMap.set(
+                        downsampledKey, reduced ? SkPDFSerializeImage(reduced.get(), fDocument,
+                                                                      quality)
+                                                : SkPDFIndirectReference());
+            }
+            if (*ptr != SkPDFIndirectReference()) {
+                this->drawFormXObject(*ptr, content.stream());
+                return;
+            }
+        }
+    }
     SkPDFIndirectReference* pdfimagePtr = fDocument->fPDFBitmapMap.find(key);
     SkPDFIndirectReference pdfimage = pdfimagePtr ? *pdfimagePtr : SkPDFIndirectReference();
     if (!pdfimagePtr) {
@@ -572,6 +572,17 @@ void SkPDFDocument::waitForJobs() {
      }
 }
 
+SkDeflateWStream::Strategy SkPDFDocument::deflateStrategy() const {
+    using Strategy = SkPDF::Metadata::CompressionStrategy;
+    switch (fMetadata.fCompressionStrategy) {
+        case Strategy::kDefault:     return SkDeflateWStream::Strategy::kDefault;
+        case Strategy::kFiltered:    return SkDeflateWStream::Strategy::kFiltered;
+        case Strategy::kHuffmanOnly: return SkDeflateWStream::Strategy::kHuffmanOnly;
+        case Strategy::kRLE:         return SkDeflateWStream::Strategy::kRLE;
+    }
+    return SkDeflateWStream::Strategy::kDefault;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkPDF::SetNodeId(SkCanvas* canvas, int nodeID) {
@@ -588,6 +599,10 @@ sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream* stream, const SkPDF::Metadata&
     if (meta.fEncodingQuality < 0) {
         meta.fEncodingQuality = 0;
     }
+    int compressionLevel = static_cast<int>(meta.fCompressionLevel);
+    if (compressionLevel < -1 || compressionLevel > 9) {
+        meta.fCompressionLevel = SkPDF::Metadata::CompressionLevel::kDefault;
+    }
     return stream ? sk_make_sp<SkPDFDocument>(stream, std::move(meta)) : nullptr;
 }
 
@@ -12,6 +12,7 @@
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkTHash.h"
+#include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFMetadata.h"
 #include "src/pdf/SkPDFTag.h"
 
@@ -24,6 +25,7 @@ class SkPDFDevice;
 class SkPDFFont;
 struct SkAdvancedTypefaceMetrics;
 struct SkBitmapKey;
+struct SkDownsampledBitmapKey;
 struct SkPDFFillGraphicState;
 struct SkPDFImageShaderKey;
 struct SkPDFStrokeGraphicState;
@@ -91,6 +93,10 @@ public:
 
     const SkPDF::Metadata& metadata() const { return fMetadata; }
 
+    // Deflate settings for SkDeflateWStream, taken from the metadata.
+    int deflateLevel() const { return static_cast<int>(fMetadata.fCompressionLevel); }
+    SkDeflateWStream::Strategy deflateStrategy() const;
+
     SkPDFIndirectReference getPage(size_t pageIndex) const;
     SkPDFIndirectReference currentPage() const {
         return SkASSERT(!fPageRefs.empty()), fPageRefs.back();
@@ -113,6 +119,7 @@ public:
     SkTHashMap<SkPDFGradientShader::Key, SkPDFIndirectReference, SkPDFGradientShader::KeyHash>
         fGradientPatternMap;
     SkTHashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
+    SkTHashMap<SkDownsampledBitmapKey, SkPDFIndirectReference> fPDFDownsampledJpegMap;
     SkTHashMap<uint32_t, std::unique_ptr<SkAdvancedTypefaceMetrics>> fTypefaceMetrics;
     SkTHashMap<uint32_t, std::vector<SkString>> fType1GlyphNames;
     SkTHashMap<uint32_t, std::vector<SkUnichar>> fToUnicodeMap;
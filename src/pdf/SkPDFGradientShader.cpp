@@ -291,6 +291,86 @@ static std::unique_ptr<SkPDFDict> gradientStitchCode(const SkShader::GradientInf
     return retval;
 }
 
+// Beyond this many periods, a repeating gradient is emitted as a PostScript function.
+static constexpr int kMaxStitchedTiles = 64;
+
+/* For a repeating or mirrored linear or radial gradient, find the whole
+   periods [firstTile, lastTile) of t that cover bbox, so that the gradient
+   can be drawn as an axial or radial shading with an extended domain. */
+static bool gradient_tile_range(const SkPDFGradientShader::Key& state,
+                                const SkMatrix& finalMatrix,
+                                int* firstTile, int* lastTile) {
+    const SkShader::GradientInfo& info = state.fInfo;
+    SkRect bbox = SkRect::Make(state.fBBox);
+    if (!SkPDFUtils::InverseTransformBBox(finalMatrix, &bbox)) {
+        return false;
+    }
+    SkPoint corners[4];
+    bbox.toQuad(corners);
+    SkScalar tMin = SK_ScalarInfinity;
+    SkScalar tMax = SK_ScalarNegativeInfinity;
+    if (state.fType == SkShader::kLinear_GradientType) {
+        SkVector axis = info.fPoint[1] - info.fPoint[0];
+        SkScalar lengthSquared = SkPoint::DotProduct(axis, axis);
+        if (!(lengthSquared > 0)) {
+            return false;
+        }
+        for (const SkPoint& corner : corners) {
+            SkScalar t = SkPoint::DotProduct(corner - info.fPoint[0], axis) / lengthSquared;
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+    } else if (state.fType == SkShader::kRadial_GradientType) {
+        if (!(info.fRadius[0] > 0)) {
+            return false;
+        }
+        tMin = 0;
+        for (const SkPoint& corner : corners) {
+            tMax = std::max(tMax, SkPoint::Distance(corner, info.fPoint[0]) / info.fRadius[0]);
+        }
+    } else {
+        return false;
+    }
+    if (!SkScalarIsFinite(tMin) || !SkScalarIsFinite(tMax) ||
+        tMax - tMin > kMaxStitchedTiles) {
+        return false;
+    }
+    *firstTile = SkScalarFloorToInt(tMin);
+    *lastTile = std::max(SkScalarCeilToInt(tMax), *firstTile + 1);
+    return *lastTile - *firstTile <= kMaxStitchedTiles;
+}
+
+/* Stitch one copy of the gradient per period over [firstTile, lastTile).
+   Odd periods of a mirrored gradient are reversed through their Encode
+   entries, so a single function object is shared by every period. */
+static std::unique_ptr<SkPDFDict> tiled_gradient_stitch_code(const SkShader::GradientInfo& info,
+                                                              int firstTile, int lastTile,
+                                                              SkPDFDocument* doc) {
+    SkPDFIndirectReference period = doc->emit(*gradientStitchCode(info));
+    bool mirror = (SkTileMode)info.fTileMode == SkTileMode::kMirror;
+
+    auto encode = SkPDFMakeArray();
+    auto bounds = SkPDFMakeArray();
+    auto functions = SkPDFMakeArray();
+    for (int tile = firstTile; tile < lastTile; ++tile) {
+        if (tile > firstTile) {
+            bounds->appendInt(tile);
+        }
+        bool reversed = mirror && (tile & 1);
+        encode->appendInt(reversed ? 1 : 0);
+        encode->appendInt(reversed ? 0 : 1);
+        functions->appendRef(period);
+    }
+
+    auto retval = SkPDFMakeDict();
+    retval->insertObject("Domain", SkPDFMakeArray(firstTile, lastTile));
+    retval->insertInt("FunctionType", 3);
+    retval->insertObject("Encode", std::move(encode));
+    retval->insertObject("Bounds", std::move(bounds));
+    retval->insertObject("Functions", std::move(functions));
+    return retval;
+}
+
 /* Map a value of t on the stack into [0, 1) for Repeat or Mirror tile mode. */
 static void tileModeCode(SkTileMode mode, SkDynamicMemoryWStream* result) {
     if (mode == SkTileMode::kRepeat) {
@@ -591,19 +671,64 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
     SkMatrix finalMatrix = state.fCanvasTransform;
     finalMatrix.preConcat(state.fShaderTransform);
 
+    SkTileMode tileMode = (SkTileMode)info.fTileMode;
     bool doStitchFunctions = (state.fType == SkShader::kLinear_GradientType ||
                               state.fType == SkShader::kRadial_GradientType ||
                               state.fType == SkShader::kConical_GradientType) &&
-                              (SkTileMode)info.fTileMode == SkTileMode::kClamp &&
+                              tileMode == SkTileMode::kClamp &&
                               !finalMatrix.hasPerspective();
 
+    // Repeating and mirrored linear and radial gradients can also use a
+    // stitching function, by extending the shading's domain over every period
+    // that the bbox touches.
+    int firstTile = 0, lastTile = 1;
+    bool doTiledStitchFunctions = (state.fType == SkShader::kLinear_GradientType ||
+                                   state.fType == SkShader::kRadial_GradientType) &&
+                                  (tileMode == SkTileMode::kRepeat ||
+                                   tileMode == SkTileMode::kMirror) &&
+                                  !finalMatrix.hasPerspective() &&
+                                  gradient_tile_range(state, finalMatrix, &firstTile, &lastTile);
+
     int32_t shadingType = 1;
     auto pdfShader = SkPDFMakeDict();
     // The two point radial gradient further references
     // state.fInfo
     // in translating from x, y coordinates to the t parameter. So, we have
     // to transform the points and radii according to the calculated matrix.
-    if (doStitchFunctions) {
+    if (doTiledStitchFunctions) {
+        pdfShader->insertObject("Function",
+                                tiled_gradient_stitch_code(info, firstTile, lastTile, doc));
+        pdfShader->insertObject("Domain", SkPDFMakeArray(firstTile, lastTile));
+        shadingType = (state.fType == SkShader::kLinear_GradientType) ? 2 : 3;
+
+        auto extend = SkPDFMakeArray();
+        extend->reserve(2);
+        extend->appendBool(true);
+        extend->appendBool(true);
+        pdfShader->insertObject("Extend", std::move(extend));
+
+        // The coordinates are the endpoints of the extended domain.
+        std::unique_ptr<SkPDFArray> coords;
+        if (state.fType == SkShader::kRadial_GradientType) {
+            SkASSERT(firstTile == 0);
+            const SkPoint& center = info.fPoint[0];
+            coords = SkPDFMakeArray(center.x(),
+                                    center.y(),
+                                    0,
+                                    center.x(),
+                                    center.y(),
+                                    info.fRadius[0] * lastTile);
+        } else {
+            SkVector axis = info.fPoint[1] - info.fPoint[0];
+            SkPoint pt1 = info.fPoint[0] + axis * SkIntToScalar(firstTile);
+            SkPoint pt2 = info.fPoint[0] + axis * SkIntToScalar(lastTile);
+            coords = SkPDFMakeArray(pt1.x(),
+                                    pt1.y(),
+                                    pt2.x(),
+                                    pt2.y());
+        }
+        pdfShader->insertObject("Coords", std::move(coords));
+    } else if (doStitchFunctions) {
         pdfShader->insertObject("Function", gradientStitchCode(info));
         shadingType = (state.fType == SkShader::kLinear_GradientType) ? 2 : 3;
 
@@ -254,6 +254,14 @@ private:
 
 struct SkFaceRec;
 
+/*  Locking:
+    f_t_mutex() guards the FT_Library, its reference count and the list of
+    SkFaceRecs, and must be held while any FT_Face is opened or closed.
+    Each SkFaceRec has its own fMutex which guards all other use of its
+    FT_Face (the glyph slot, the active FT_Size, the transform), so scaler
+    contexts for different faces generate glyphs in parallel.
+    The two are never held at the same time.
+*/
 static SkMutex& f_t_mutex() {
     static SkMutex& mutex = *(new SkMutex);
     return mutex;
@@ -296,6 +304,8 @@ static void unref_ft_library() {
 
 struct SkFaceRec {
     SkFaceRec* fNext;
+    // Guards use of fFace after it is opened. See f_t_mutex().
+    SkMutex fMutex;
     std::unique_ptr<FT_FaceRec, SkFunctionWrapper<decltype(FT_Done_Face), FT_Done_Face>> fFace;
     FT_StreamRec fFTStream;
     std::unique_ptr<SkStreamAsset> fSkStream;
@@ -482,17 +492,25 @@ extern /*static*/ void unref_ft_face(SkFaceRec* faceRec) {
 class AutoFTAccess {
 public:
     AutoFTAccess(const SkTypeface* tf) : fFaceRec(nullptr) {
-        f_t_mutex().acquire();
-        SkASSERT_RELEASE(ref_ft_library());
-        fFaceRec = ref_ft_face(tf);
+        {
+            SkAutoMutexExclusive ac(f_t_mutex());
+            SkASSERT_RELEASE(ref_ft_library());
+            fFaceRec = ref_ft_face(tf);
+        }
+        if (fFaceRec) {
+            fFaceRec->fMutex.acquire();
+        }
     }
 
     ~AutoFTAccess() {
+        if (fFaceRec) {
+            fFaceRec->fMutex.release();
+        }
+        SkAutoMutexExclusive ac(f_t_mutex());
         if (fFaceRec) {
             unref_ft_face(fFaceRec);
         }
         unref_ft_library();
-        f_t_mutex().release();
     }
 
     FT_Face face() { return fFaceRec ? fFaceRec->fFace.get() : nullptr; }
@@ -553,9 +571,9 @@ private:
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -849,10 +867,12 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-    SkASSERT_RELEASE(ref_ft_library());
+    {
+        SkAutoMutexExclusive  ac(f_t_mutex());
+        SkASSERT_RELEASE(ref_ft_library());
 
-    fFaceRec.reset(ref_ft_face(this->getTypeface()));
+        fFaceRec.reset(ref_ft_face(this->getTypeface()));
+    }
 
     // load the font file
     if (nullptr == fFaceRec) {
@@ -860,6 +880,8 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
         return;
     }
 
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
+
     fLCDIsVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
 
     // compute the flags we send to Load_Glyph
@@ -1027,12 +1049,12 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (fFTSize != nullptr) {
+        SkAutoMutexExclusive  ac(fFaceRec->fMutex);
         FT_Done_Size(fFTSize);
     }
 
+    SkAutoMutexExclusive  ac(f_t_mutex());
     fFaceRec = nullptr;
 
     unref_ft_library();
@@ -1042,7 +1064,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
+    fFaceRec->fMutex.assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1063,7 +1085,7 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         glyph->zeroMetrics();
@@ -1168,7 +1190,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     glyph->fMaskFormat = fRec.fMaskFormat;
 
@@ -1320,7 +1342,7 @@ void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         sk_bzero(glyph.fImage, glyph.imageSize());
@@ -1353,7 +1375,7 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
     if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
@@ -1394,7 +1416,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
+    SkAutoMutexExclusive ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
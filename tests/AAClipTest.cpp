@@ -21,6 +21,7 @@
 #include "src/core/SkAAClip.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkRasterClipStack.h"
 #include "tests/Test.h"
 
 #include <string.h>
@@ -441,3 +442,88 @@ DEF_TEST(AAClip, reporter) {
     test_crbug_422693(reporter);
     test_huge(reporter);
 }
+
+DEF_TEST(RasterClipStack_cache, reporter) {
+    const SkIRect bounds = SkIRect::MakeWH(100, 100);
+    SkRasterClipStack stack(bounds.width(), bounds.height());
+
+    auto expected = [&](const SkRasterClip& parent, const SkPath& path, const SkMatrix& ctm) {
+        SkRasterClip rc(parent);
+        rc.op(path, ctm, bounds, SkRegion::kIntersect_Op, true);
+        return rc;
+    };
+
+    SkPath path;
+    path.addCircle(50, 50, 30);
+    const SkMatrix ctm = SkMatrix::MakeTrans(0.5f, 0);
+    const SkRRect rrect = SkRRect::MakeRectXY({10, 10, 60, 90}, 8, 8);
+
+    stack.save();
+    stack.clipPath(ctm, path, SkClipOp::kIntersect, true);
+    const SkRasterClip first(stack.rc());
+    const uint64_t firstGenID = stack.genID();
+    REPORTER_ASSERT(reporter, first.isAA());
+    REPORTER_ASSERT(reporter, first == expected(SkRasterClip(bounds), path, ctm));
+    stack.save();
+    stack.clipRRect(ctm, rrect, SkClipOp::kDifference, true);
+    const SkRasterClip nested(stack.rc());
+    const uint64_t nestedGenID = stack.genID();
+    REPORTER_ASSERT(reporter, nestedGenID != firstGenID);
+    stack.restore();
+    stack.restore();
+    REPORTER_ASSERT(reporter, stack.rc().isRect());
+
+    // The same clips again come from the cache, nested ones included, which gives them back the
+    // gen IDs they had the first time.
+    for (int i = 0; i < 2; ++i) {
+        stack.save();
+        stack.clipPath(ctm, path, SkClipOp::kIntersect, true);
+        REPORTER_ASSERT(reporter, stack.rc() == first);
+        REPORTER_ASSERT(reporter, stack.genID() == firstGenID);
+        stack.save();
+        stack.clipRRect(ctm, rrect, SkClipOp::kDifference, true);
+        REPORTER_ASSERT(reporter, stack.rc() == nested);
+        REPORTER_ASSERT(reporter, stack.genID() == nestedGenID);
+        stack.restore();
+        stack.restore();
+    }
+
+    // A different matrix, an edited path, or a different clip underneath are not cache hits.
+    stack.save();
+    const SkMatrix ctm2 = SkMatrix::MakeTrans(1.5f, 0);
+    stack.clipPath(ctm2, path, SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, stack.rc() == expected(SkRasterClip(bounds), path, ctm2));
+    REPORTER_ASSERT(reporter, stack.genID() != firstGenID);
+    stack.restore();
+
+    path.offset(10, 0);
+    stack.save();
+    stack.clipPath(ctm, path, SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, stack.rc() == expected(SkRasterClip(bounds), path, ctm));
+    REPORTER_ASSERT(reporter, stack.rc() != first);
+    REPORTER_ASSERT(reporter, stack.genID() != firstGenID);
+    stack.restore();
+
+    stack.save();
+    stack.clipRect(SkMatrix::I(), {0, 0, 50, 100}, SkClipOp::kIntersect, false);
+    stack.clipPath(ctm, path, SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter,
+                    stack.rc() == expected(SkRasterClip(SkIRect::MakeWH(50, 100)), path, ctm));
+    stack.restore();
+
+    // Nor is the same path under another fill type, which keeps its gen ID.
+    SkPath overlap;
+    overlap.addCircle(40, 50, 25);
+    overlap.addCircle(60, 50, 25);
+    stack.save();
+    stack.clipPath(ctm, overlap, SkClipOp::kIntersect, true);
+    const SkRasterClip winding(stack.rc());
+    REPORTER_ASSERT(reporter, winding == expected(SkRasterClip(bounds), overlap, ctm));
+    stack.restore();
+    overlap.setFillType(SkPathFillType::kEvenOdd);
+    stack.save();
+    stack.clipPath(ctm, overlap, SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, stack.rc() == expected(SkRasterClip(bounds), overlap, ctm));
+    REPORTER_ASSERT(reporter, stack.rc() != winding);
+    stack.restore();
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkScan.h"
+#include "tests/Test.h"
+
+#include <cmath>
+#include <vector>
+
+// The exact area of the part of the polygon inside the pixel at (x, y), found by clipping the
+// polygon to each side of the pixel in turn.
+static double pixel_coverage(const std::vector<SkPoint>& polygon, int x, int y) {
+    struct Point { double fX, fY; };
+    std::vector<Point> pts;
+    for (SkPoint p : polygon) {
+        pts.push_back({p.fX, p.fY});
+    }
+    // Keep the part of pts where sign * (p[axis] - edge) >= 0.
+    auto clip = [&pts](int axis, double edge, double sign) {
+        auto coord = [axis](const Point& p) { return axis == 0 ? p.fX : p.fY; };
+        std::vector<Point> clipped;
+        for (size_t i = 0; i < pts.size(); ++i) {
+            const Point& a = pts[i];
+            const Point& b = pts[(i + 1) % pts.size()];
+            bool aIn = sign * (coord(a) - edge) >= 0,
+                 bIn = sign * (coord(b) - edge) >= 0;
+            if (aIn) {
+                clipped.push_back(a);
+            }
+            if (aIn != bIn) {
+                double t = (edge - coord(a)) / (coord(b) - coord(a));
+                clipped.push_back({a.fX + t * (b.fX - a.fX), a.fY + t * (b.fY - a.fY)});
+            }
+        }
+        pts = std::move(clipped);
+    };
+    clip(0, x, 1);
+    clip(0, x + 1, -1);
+    clip(1, y, 1);
+    clip(1, y + 1, -1);
+
+    double area = 0;
+    for (size_t i = 0; i < pts.size(); ++i) {
+        const Point& a = pts[i];
+        const Point& b = pts[(i + 1) % pts.size()];
+        area += a.fX * b.fY - b.fX * a.fY;
+    }
+    return std::fabs(area) / 2;
+}
+
+// Compare analytic AA coverage of simple polygons with their exact coverage. The polygons are 32
+// pixels across, which AAA fills through its mask blitter, and 256 pixels across, which it fills
+// through its run based blitter. Some are squashed so that their edges are long and shallow, and
+// each row of coverage under them is long. Vertex y coordinates are on quarter pixels, where
+// AAA puts them anyway. AAA approximates the coverage of pixels next to vertices, so those are
+// only included in each polygon's total.
+DEF_TEST(AnalyticAAPathCoverage, r) {
+    bool forceAnalyticAA = gSkForceAnalyticAA.exchange(true);
+    bool useSparseAA = gSkUseSparseAA.exchange(false);
+
+    SkRandom rand;
+    for (int size : {32, 256}) {
+        for (int i = 0; i < 24; ++i) {
+            int count = 3 + i % 6;
+            float squash = i % 3 == 0 ? 1 : 0.25f;
+            std::vector<SkPoint> polygon;
+            for (int j = 0; j < count; ++j) {
+                float angle = (j + 0.8f * rand.nextF()) * 2 * SK_FloatPI / count;
+                float radius = (size / 2 - 1) * (0.3f + 0.7f * rand.nextF());
+                float y = size / 2 + squash * radius * std::sin(angle);
+                polygon.push_back({size / 2 + radius * std::cos(angle), std::round(y * 4) / 4});
+            }
+            SkPath path;
+            path.addPoly(polygon.data(), count, true);
+
+            SkBitmap bitmap;
+            bitmap.allocPixels(SkImageInfo::MakeA8(size, size));
+            bitmap.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas canvas(bitmap);
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas.drawPath(path, paint);
+
+            double total = 0, expectedTotal = 0;
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    double exact = pixel_coverage(polygon, x, y);
+                    int coverage = *bitmap.getAddr8(x, y);
+                    total += coverage;
+                    expectedTotal += 255 * exact;
+
+                    bool nearVertex = false;
+                    for (SkPoint v : polygon) {
+                        nearVertex |= std::fabs(v.fX - x - 0.5f) < 2 &&
+                                      std::fabs(v.fY - y - 0.5f) < 2;
+                    }
+                    int expected = (int)std::lround(255 * exact);
+                    if (!nearVertex && std::abs(coverage - expected) > 16) {
+                        ERRORF(r, "size %d polygon %d: pixel (%d, %d) is %d, expected %d",
+                               size, i, x, y, coverage, expected);
+                    }
+                }
+            }
+            REPORTER_ASSERT(r, std::fabs(total - expectedTotal) <= 0.005 * expectedTotal + 255,
+                            "size %d polygon %d: total coverage %g, expected %g",
+                            size, i, total, expectedTotal);
+        }
+    }
+
+    gSkForceAnalyticAA = forceAnalyticAA;
+    gSkUseSparseAA = useSparseAA;
+}
@@ -8,14 +8,14 @@
 #include "include/core/SkSize.h"
 #include "include/private/SkTDArray.h"
 #include "include/utils/SkRandom.h"
-#include "src/gpu/GrRectanizerSkyline.h"
+#include "src/core/SkRectanizerSkyline.h"
 #include "tests/Test.h"
 
 static const int kWidth = 1024;
 static const int kHeight = 1024;
 
 // Basic test of a GrRectanizer-derived class' functionality
-static void test_rectanizer_basic(skiatest::Reporter* reporter, GrRectanizerSkyline* rectanizer) {
+static void test_rectanizer_basic(skiatest::Reporter* reporter, SkRectanizerSkyline* rectanizer) {
     REPORTER_ASSERT(reporter, kWidth == rectanizer->width());
     REPORTER_ASSERT(reporter, kHeight == rectanizer->height());
 
@@ -26,7 +26,7 @@ static void test_rectanizer_basic(skiatest::Reporter* reporter, GrRectanizerSkyl
 }
 
 static void test_rectanizer_inserts(skiatest::Reporter*,
-                                    GrRectanizerSkyline* rectanizer,
+                                    SkRectanizerSkyline* rectanizer,
                                     const SkTDArray<SkISize>& rects) {
     int i;
     for (i = 0; i < rects.count(); ++i) {
@@ -40,7 +40,7 @@ static void test_rectanizer_inserts(skiatest::Reporter*,
 }
 
 static void test_skyline(skiatest::Reporter* reporter, const SkTDArray<SkISize>& rects) {
-    GrRectanizerSkyline skylineRectanizer(kWidth, kHeight);
+    SkRectanizerSkyline skylineRectanizer(kWidth, kHeight);
 
     test_rectanizer_basic(reporter, &skylineRectanizer);
     test_rectanizer_inserts(reporter, &skylineRectanizer, rects);
@@ -5,8 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkPath.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkMaskCache.h"
+#include "src/core/SkPathMaskCache.h"
 #include "src/core/SkResourceCache.h"
 #include "tests/Test.h"
 
@@ -102,3 +107,168 @@ DEF_TEST(RectsMaskCache, reporter) {
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
+
+static SkBitmap draw_path(const SkPath& path, const SkPaint& paint, SkScalar dx, SkScalar dy) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    canvas.translate(dx, dy);
+    canvas.drawPath(path, paint);
+    return bitmap;
+}
+
+static bool equal_pixels(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(uint32_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool in_path_mask_cache(const SkPath& path, const SkPaint& paint,
+                               SkScalar dx, SkScalar dy) {
+    SkPathMaskCache::Desc desc;
+    SkIPoint offset;
+    if (!SkPathMaskCache::MakeDesc(path, paint, SkMatrix::MakeTrans(dx, dy), &desc, &offset)) {
+        return false;
+    }
+    SkMask mask;
+    SkCachedData* data = SkPathMaskCache::FindAndRef(desc, &mask);
+    if (!data) {
+        return false;
+    }
+    data->unref();
+    return true;
+}
+
+// Draws that hit the path mask cache should draw exactly what they draw without it.
+DEF_TEST(PathMaskCache, reporter) {
+    // A five pointed star drawn without lifting the pen, so its middle differs between fills.
+    SkPath path;
+    path.moveTo(50, 10);
+    path.lineTo(73.5f, 82.4f);
+    path.lineTo(12, 37.6f);
+    path.lineTo(88, 37.6f);
+    path.lineTo(26.5f, 82.4f);
+    path.close();
+
+    SkPaint fill;
+    fill.setAntiAlias(true);
+    SkPaint stroke = fill;
+    stroke.setStyle(SkPaint::kStroke_Style);
+    stroke.setStrokeWidth(3);
+    stroke.setStrokeJoin(SkPaint::kRound_Join);
+
+    struct {
+        const SkPaint&      fPaint;
+        SkPathFillType      fFillType;
+        SkScalar            fDX, fDY;
+    } draws[] = {
+        {fill,   SkPathFillType::kWinding,  0,     0},
+        // Shares the mask of the draw before it, at another integer translation.
+        {fill,   SkPathFillType::kWinding,  7,    -3},
+        // Needs its own mask, a quarter pixel over.
+        {fill,   SkPathFillType::kWinding,  7.25f, 2.5f},
+        // The same path with the same generation ID, but another fill type.
+        {fill,   SkPathFillType::kEvenOdd,  0,     0},
+        {fill,   SkPathFillType::kEvenOdd, -4,     5},
+        {stroke, SkPathFillType::kWinding,  3,     3},
+    };
+
+    const size_t oldLimit = SkGraphics::SetPathMaskCacheByteLimit(0);
+    for (const auto& d : draws) {
+        path.setFillType(d.fFillType);
+        SkGraphics::SetPathMaskCacheByteLimit(0);
+        SkBitmap expected = draw_path(path, d.fPaint, d.fDX, d.fDY);
+
+        SkGraphics::SetPathMaskCacheByteLimit(1 << 20);
+        SkBitmap first = draw_path(path, d.fPaint, d.fDX, d.fDY);
+        REPORTER_ASSERT(reporter, in_path_mask_cache(path, d.fPaint, d.fDX, d.fDY));
+        SkBitmap hit = draw_path(path, d.fPaint, d.fDX, d.fDY);
+        REPORTER_ASSERT(reporter, equal_pixels(first, expected));
+        REPORTER_ASSERT(reporter, equal_pixels(hit, expected));
+    }
+    SkGraphics::SetPathMaskCacheByteLimit(oldLimit);
+}
+
+static SkPath make_circle(SkScalar radius) {
+    SkPath path;
+    path.addCircle(50, 50, radius);
+    return path;
+}
+
+// Masks are evicted, oldest first, to stay within the limit, and masks that would not fit are
+// never made.
+DEF_TEST(PathMaskCache_Budget, reporter) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    // The circles' masks take from 0.5K to 1K each, so the limit can't hold all six.
+    const size_t oldLimit = SkGraphics::SetPathMaskCacheByteLimit(0);
+    SkGraphics::SetPathMaskCacheByteLimit(4096);
+    SkPath paths[6];
+    for (int i = 0; i < 6; i++) {
+        paths[i] = make_circle(10 + i);
+        draw_path(paths[i], paint, 0, 0);
+        REPORTER_ASSERT(reporter, in_path_mask_cache(paths[i], paint, 0, 0));
+        REPORTER_ASSERT(reporter, SkPathMaskCache::GetBytesUsed() <= 4096);
+    }
+    REPORTER_ASSERT(reporter, !in_path_mask_cache(paths[0], paint, 0, 0));
+
+    // Lowering the limit evicts the masks that no longer fit.
+    SkGraphics::SetPathMaskCacheByteLimit(2048);
+    REPORTER_ASSERT(reporter, SkPathMaskCache::GetBytesUsed() <= 2048);
+    REPORTER_ASSERT(reporter, in_path_mask_cache(paths[5], paint, 0, 0));
+    REPORTER_ASSERT(reporter, !in_path_mask_cache(paths[3], paint, 0, 0));
+
+    // A mask bigger than the limit is drawn directly, without being cached.
+    SkGraphics::SetPathMaskCacheByteLimit(0);
+    SkPath big = make_circle(40);
+    SkBitmap expected = draw_path(big, paint, 0, 0);
+    SkGraphics::SetPathMaskCacheByteLimit(2048);
+    SkBitmap direct = draw_path(big, paint, 0, 0);
+    REPORTER_ASSERT(reporter, !in_path_mask_cache(big, paint, 0, 0));
+    REPORTER_ASSERT(reporter, equal_pixels(direct, expected));
+
+    SkGraphics::SetPathMaskCacheByteLimit(oldLimit);
+}
+
+// The masks of a path are purged when it is edited or deleted.
+DEF_TEST(PathMaskCache_GenIDChange, reporter) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    const size_t oldLimit = SkGraphics::SetPathMaskCacheByteLimit(0);
+    SkGraphics::SetPathMaskCacheByteLimit(1 << 20);
+    SkPathMaskCache::Desc desc;
+    SkIPoint offset;
+    SkMask mask;
+    {
+        SkPath path = make_circle(20);
+        draw_path(path, paint, 0, 0);
+        REPORTER_ASSERT(reporter, SkPathMaskCache::MakeDesc(path, paint, SkMatrix::I(),
+                                                            &desc, &offset));
+        REPORTER_ASSERT(reporter, in_path_mask_cache(path, paint, 0, 0));
+
+        path.lineTo(10, 10);
+        SkCachedData* data = SkPathMaskCache::FindAndRef(desc, &mask);
+        REPORTER_ASSERT(reporter, !data);
+        if (data) {
+            data->unref();
+        }
+
+        draw_path(path, paint, 0, 0);
+        REPORTER_ASSERT(reporter, SkPathMaskCache::MakeDesc(path, paint, SkMatrix::I(),
+                                                            &desc, &offset));
+        REPORTER_ASSERT(reporter, in_path_mask_cache(path, paint, 0, 0));
+    }
+    SkCachedData* data = SkPathMaskCache::FindAndRef(desc, &mask);
+    REPORTER_ASSERT(reporter, !data);
+    if (data) {
+        data->unref();
+    }
+
+    SkGraphics::SetPathMaskCacheByteLimit(oldLimit);
+}
@@ -167,4 +167,38 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateWStream_Settings, r) {
+    static const char kText[] =
+            "0 0 m 100 0 l 100 100 l 0 100 l h f\n"
+            "0 0 m 100 0 l 100 100 l 0 100 l h f\n"
+            "BT /F1 12 Tf 10 10 Td (Hello Skia) Tj ET\n";
+    const SkDeflateWStream::Strategy kStrategies[] = {
+        SkDeflateWStream::Strategy::kDefault,
+        SkDeflateWStream::Strategy::kFiltered,
+        SkDeflateWStream::Strategy::kHuffmanOnly,
+        SkDeflateWStream::Strategy::kRLE,
+    };
+    for (int level : {-1, 0, 1, 6, 9}) {
+        for (SkDeflateWStream::Strategy strategy : kStrategies) {
+            SkDynamicMemoryWStream compressedWStream;
+            {
+                SkDeflateWStream deflateWStream(&compressedWStream, level, false, strategy);
+                for (int i = 0; i < 100; ++i) {
+                    deflateWStream.write(kText, strlen(kText));
+                }
+            }
+            std::unique_ptr<SkStreamAsset> compressed(compressedWStream.detachAsStream());
+            std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+            if (!decompressed) {
+                ERRORF(r, "Decompression failed for level %d.", level);
+                continue;
+            }
+            REPORTER_ASSERT(r, decompressed->getLength() == 100 * strlen(kText));
+            if (level != 0) {
+                REPORTER_ASSERT(r, compressed->getLength() < decompressed->getLength());
+            }
+        }
+    }
+}
+
 #endif
@@ -221,6 +221,30 @@ DEF_TEST(SkPDF_unicode_metadata, r) {
     }
 }
 
+// Verify that CompressionLevel::kNone leaves content streams and images uncompressed.
+DEF_TEST(SkPDF_uncompressed_document, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_uncompressed_document, r);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(0x80FF0000);
+    for (auto level : {SkPDF::Metadata::CompressionLevel::kDefault,
+                       SkPDF::Metadata::CompressionLevel::kNone}) {
+        SkPDF::Metadata metadata;
+        metadata.fCompressionLevel = level;
+        SkDynamicMemoryWStream buffer;
+        auto doc = SkPDF::MakeDocument(&buffer, metadata);
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (int i = 0; i < 20; ++i) {
+            canvas->drawRect(SkRect::MakeXYWH(10 * i, 10 * i, 100, 100), SkPaint());
+        }
+        canvas->drawBitmap(bitmap, 300, 300);
+        doc->close();
+        sk_sp<SkData> data(buffer.detachAsData());
+        bool deflated = contains(data->bytes(), data->size(), "FlateDecode");
+        REPORTER_ASSERT(r, deflated == (level != SkPDF::Metadata::CompressionLevel::kNone));
+    }
+}
+
 // Make sure we excercise the multi-page functionality without problems.
 // Add this to args.gn to output the PDF to a file:
 //   extra_cflags = [ "-DSK_PDF_TEST_MULTIPAGE=\"/tmp/skpdf_test_multipage.pdf\"" ]
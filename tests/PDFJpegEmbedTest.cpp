@@ -79,6 +79,39 @@ DEF_TEST(SkPDF_JpegEmbedTest, r) {
     REPORTER_ASSERT(r, !is_subset_of(cmykData.get(), pdfData.get()));
 }
 
+static sk_sp<SkData> draw_small_jpeg(sk_sp<SkImage> image, bool downsample) {
+    SkDynamicMemoryWStream pdf;
+    SkPDF::Metadata metadata;
+    metadata.fDownsampleJpegs = downsample;
+    auto document = SkPDF::MakeDocument(&pdf, metadata);
+    SkCanvas* canvas = document->beginPage(256, 256);
+    canvas->drawImageRect(image, SkRect::MakeWH(64, 64), nullptr);
+    document->close();
+    return pdf.detachAsData();
+}
+
+/**
+ *  Test that a JPEG drawn far below its native resolution is embedded at a
+ *  reduced size when fDownsampleJpegs is set, and passed through otherwise.
+ */
+DEF_TEST(SkPDF_JpegDownsampleTest, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_JpegDownsampleTest, r);
+    sk_sp<SkData> mandrillData(load_resource(r, "SkPDF_JpegDownsampleTest",
+                                             "images/mandrill_512_q075.jpg"));
+    if (!mandrillData) {
+        return;
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(mandrillData);
+    sk_sp<SkData> fullPdf = draw_small_jpeg(image, false);
+    sk_sp<SkData> smallPdf = draw_small_jpeg(image, true);
+
+    #ifndef SK_PDF_BASE85_BINARY
+    REPORTER_ASSERT(r, is_subset_of(mandrillData.get(), fullPdf.get()));
+    #endif
+    REPORTER_ASSERT(r, !is_subset_of(mandrillData.get(), smallPdf.get()));
+    REPORTER_ASSERT(r, smallPdf->size() < fullPdf->size());
+}
+
 #ifdef SK_SUPPORT_PDF
 
 #include "src/pdf/SkJpegInfo.h"
@@ -17,6 +17,7 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/effects/SkMorphologyImageFilter.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/private/SkTo.h"
@@ -443,6 +444,40 @@ DEF_TEST(SkPDF_Clusterator, reporter) {
     }
 }
 
+static bool contains(const SkData* data, const char* str) {
+    size_t len = strlen(str);
+    for (size_t i = 0; i + len <= data->size(); ++i) {
+        if (0 == memcmp(data->bytes() + i, str, len)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Repeating and mirrored linear and radial gradients should be drawn with
+// stitched sampled functions, not PostScript calculator (Type 4) functions.
+DEF_TEST(SkPDF_TiledGradientShading, reporter) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_TiledGradientShading, reporter);
+    const SkPoint pts[2] = {{10, 10}, {30, 30}};
+    const SkColor colors[3] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+    for (SkTileMode mode : {SkTileMode::kRepeat, SkTileMode::kMirror}) {
+        for (bool radial : {false, true}) {
+            SkDynamicMemoryWStream stream;
+            auto doc = SkPDF::MakeDocument(&stream);
+            SkCanvas* canvas = doc->beginPage(200, 200);
+            SkPaint paint;
+            paint.setShader(radial
+                    ? SkGradientShader::MakeRadial(pts[0], 20, colors, nullptr, 3, mode)
+                    : SkGradientShader::MakeLinear(pts, colors, nullptr, 3, mode));
+            canvas->drawRect({0, 0, 200, 200}, paint);
+            doc->close();
+            sk_sp<SkData> pdf = stream.detachAsData();
+            REPORTER_ASSERT(reporter, contains(pdf.get(), "/FunctionType 3"));
+            REPORTER_ASSERT(reporter, !contains(pdf.get(), "/FunctionType 4"));
+        }
+    }
+}
+
 DEF_TEST(fuzz875632f0, reporter) {
     SkNullWStream stream;
     auto doc = SkPDF::MakeDocument(&stream);
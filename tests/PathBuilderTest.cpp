@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPathBuilder.h"
+#include "include/utils/SkRandom.h"
+#include "tests/Test.h"
+
+DEF_TEST(PathBuilder_matchesPath, reporter) {
+    SkRandom rand;
+    for (int trial = 0; trial < 1000; ++trial) {
+        SkPathBuilder builder;
+        SkPath path;
+        const int verbCount = rand.nextULessThan(12);
+        for (int i = 0; i < verbCount; ++i) {
+            SkPoint p0 = { rand.nextSScalar1() * 100, rand.nextSScalar1() * 100 },
+                    p1 = { rand.nextSScalar1() * 100, rand.nextSScalar1() * 100 },
+                    p2 = { rand.nextSScalar1() * 100, rand.nextSScalar1() * 100 };
+            switch (rand.nextULessThan(6)) {
+                case 0: builder.moveTo(p0);              path.moveTo(p0);              break;
+                case 1: builder.lineTo(p0);              path.lineTo(p0);              break;
+                case 2: builder.quadTo(p0, p1);          path.quadTo(p0, p1);          break;
+                case 3: builder.conicTo(p0, p1, 0.5f);   path.conicTo(p0, p1, 0.5f);   break;
+                case 4: builder.cubicTo(p0, p1, p2);     path.cubicTo(p0, p1, p2);     break;
+                case 5: builder.close();                 path.close();                 break;
+            }
+
+            SkPath snapshot = builder.snapshot();
+            REPORTER_ASSERT(reporter, snapshot == path);
+            REPORTER_ASSERT(reporter, snapshot.getBounds() == path.getBounds());
+            REPORTER_ASSERT(reporter, builder.getBounds() == path.getBounds());
+
+            // The builder only decides a path is concave when SkPath would too.
+            SkPathConvexityType convexity = snapshot.getConvexityTypeOrUnknown();
+            REPORTER_ASSERT(reporter, convexity == SkPathConvexityType::kUnknown ||
+                                      convexity == path.getConvexityType());
+        }
+    }
+}
+
+DEF_TEST(PathBuilder_snapshots, reporter) {
+    SkPathBuilder builder;
+    builder.moveTo(0, 0).lineTo(10, 0).lineTo(10, 10);
+
+    // Taking a snapshot again without edits returns the same path.
+    SkPath held = builder.snapshot();
+    REPORTER_ASSERT(reporter, held.getGenerationID() == builder.snapshot().getGenerationID());
+
+    // Appending while a snapshot is held leaves the snapshot as it was.
+    builder.lineTo(0, 10).close();
+    REPORTER_ASSERT(reporter, held.countVerbs() == 3);
+    REPORTER_ASSERT(reporter, held.getBounds() == SkRect::MakeWH(10, 10));
+
+    SkPath current = builder.snapshot();
+    REPORTER_ASSERT(reporter, current.countVerbs() == 5);
+    REPORTER_ASSERT(reporter, current.getGenerationID() != held.getGenerationID());
+    REPORTER_ASSERT(reporter, current.isConvex());
+
+    // Appending after the snapshot is gone reuses its storage, with a new generation ID.
+    uint32_t genID = current.getGenerationID();
+    current.reset();
+    builder.moveTo(20, 20).lineTo(30, 20);
+    SkPath next = builder.snapshot();
+    REPORTER_ASSERT(reporter, next.getGenerationID() != genID);
+    REPORTER_ASSERT(reporter, next.getBounds() == SkRect::MakeLTRB(0, 0, 30, 20));
+    REPORTER_ASSERT(reporter, next.getConvexityTypeOrUnknown() == SkPathConvexityType::kConcave);
+
+    builder.reset();
+    REPORTER_ASSERT(reporter, builder.snapshot().isEmpty());
+    REPORTER_ASSERT(reporter, next.countVerbs() == 7);
+}
+
+DEF_TEST(PathBuilder_nonFinite, reporter) {
+    SkPathBuilder builder;
+    builder.moveTo(0, 0).lineTo(SK_ScalarInfinity, 5).lineTo(10, 10);
+    REPORTER_ASSERT(reporter, !builder.isFinite());
+    REPORTER_ASSERT(reporter, builder.getBounds().isEmpty());
+
+    SkPath path = builder.snapshot();
+    REPORTER_ASSERT(reporter, !path.isFinite());
+    REPORTER_ASSERT(reporter, path.getBounds().isEmpty());
+}
@@ -306,3 +306,40 @@ DEF_TEST(contour_measure, reporter) {
     test_empty_contours(reporter);
     test_MLM_contours(reporter);
 }
+
+DEF_TEST(contour_measure_getPosTans, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(50, 0);
+    path.quadTo(100, 0, 100, 50);
+    path.conicTo(100, 100, 50, 100, 0.7f);
+    path.cubicTo(30, 100, 30, 100, 0, 60);   // first control point on the start point
+    path.close();
+
+    auto cm = SkContourMeasureIter(path, false).next();
+    const SkScalar length = cm->length();
+
+    // Increasing, with repeats and the ends, then going backwards, then out of range.
+    const SkScalar distances[] = {
+        0, 0, length * 0.1f, length * 0.3f, length * 0.3f, length * 0.55f, length * 0.8f,
+        length, length * 0.5f, length * 0.2f, -10, length + 10,
+    };
+    constexpr int kCount = SK_ARRAY_COUNT(distances);
+
+    SkPoint  positions[kCount];
+    SkVector tangents[kCount];
+    REPORTER_ASSERT(reporter, cm->getPosTans(distances, kCount, positions, tangents));
+    for (int i = 0; i < kCount; ++i) {
+        SkPoint  pos;
+        SkVector tan;
+        REPORTER_ASSERT(reporter, cm->getPosTan(distances[i], &pos, &tan));
+        REPORTER_ASSERT(reporter, pos == positions[i] && tan == tangents[i]);
+    }
+
+    // NaN distances are reported, and leave their results alone.
+    const SkScalar withNaN[] = { 1, SK_ScalarNaN, 2 };
+    SkPoint nanPositions[3] = {{-1, -1}, {-1, -1}, {-1, -1}};
+    REPORTER_ASSERT(reporter, !cm->getPosTans(withNaN, 3, nanPositions, nullptr));
+    REPORTER_ASSERT(reporter, nanPositions[1] == SkPoint::Make(-1, -1));
+    REPORTER_ASSERT(reporter, nanPositions[2] == SkPoint::Make(2, 0));
+}
@@ -6,6 +6,8 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
+#include "include/utils/SkRandom.h"
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/PathOpsTestCommon.h"
 #include "tests/Test.h"
@@ -361,3 +363,42 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderBalanced, reporter) {
+    SkRandom rand;
+    SkTArray<SkPath> paths;
+    for (int i = 0; i < 200; ++i) {
+        int x = rand.nextULessThan(240),
+            y = rand.nextULessThan(240),
+            w = 1 + rand.nextULessThan(16),
+            h = 1 + rand.nextULessThan(16);
+        paths.push_back().addRect(SkRect::MakeXYWH(x, y, w, h));
+    }
+
+    auto build = [&]() {
+        SkOpBuilder builder;
+        for (const SkPath& path : paths) {
+            builder.add(path, kUnion_SkPathOp);
+        }
+        return builder;
+    };
+
+    SkPath expected;
+    REPORTER_ASSERT(reporter, build().resolve(&expected));
+
+    SkPath balanced;
+    REPORTER_ASSERT(reporter, build().resolveBalanced(&balanced));
+    REPORTER_ASSERT(reporter, comparePaths(reporter, __FUNCTION__, expected, balanced) == 0);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkPath threaded;
+    REPORTER_ASSERT(reporter, build().resolveBalanced(&threaded, executor.get()));
+    REPORTER_ASSERT(reporter, comparePaths(reporter, __FUNCTION__, expected, threaded) == 0);
+
+    // Operators other than union use resolve().
+    SkOpBuilder builder = build();
+    builder.add(paths[0], kDifference_SkPathOp);
+    SkPath mixed;
+    REPORTER_ASSERT(reporter, builder.resolveBalanced(&mixed, executor.get()));
+    REPORTER_ASSERT(reporter, !mixed.getBounds().isEmpty());
+}
@@ -4,6 +4,8 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/utils/SkRandom.h"
+#include "src/pathops/SkAddIntersections.h"
 #include "tests/PathOpsExtendedTest.h"
 
 #define TEST(name) { name, #name }
@@ -9854,3 +9856,46 @@ DEF_TEST(PathOpsSimplify, reporter) {
         RunTestSet(reporter, subTests, subTestCount, firstSubTest, nullptr, stopTest, runReverse);
     }
 }
+
+static SkPath wobbly_ring(SkRandom* rand, int count, SkScalar cx, SkScalar cy) {
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar angle = i * SK_ScalarPI * 2 / count;
+        SkScalar radius = 100 + 10 * SkScalarSin(angle * 37) + rand->nextRangeF(-2, 2);
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        if (i == 0) {
+            path.moveTo(pt);
+        } else {
+            path.lineTo(pt);
+        }
+    }
+    path.close();
+    return path;
+}
+
+// Contours this long have enough pairs of segments that AddIntersectTs sweeps for the pairs to
+// intersect. The result must be exactly what the pairwise loop finds.
+DEF_TEST(PathOpsSimplifySweep, reporter) {
+    constexpr int kCount = 500;
+    REPORTER_ASSERT(reporter, (int64_t)kCount * kCount >= gSkPathOpsSweepMinPairs);
+    SkRandom rand;
+    SkPath one = wobbly_ring(&rand, kCount, 0, 0);
+    SkPath two = wobbly_ring(&rand, kCount, 15, 10);
+    SkPath both = one;
+    both.addPath(two);
+
+    SkPath sweptSimplify, sweptUnion;
+    bool sweptSimplifyOk = Simplify(both, &sweptSimplify);
+    bool sweptUnionOk = Op(one, two, kUnion_SkPathOp, &sweptUnion);
+
+    int64_t minPairs = gSkPathOpsSweepMinPairs.exchange(INT64_MAX);
+    SkPath pairwiseSimplify, pairwiseUnion;
+    bool pairwiseSimplifyOk = Simplify(both, &pairwiseSimplify);
+    bool pairwiseUnionOk = Op(one, two, kUnion_SkPathOp, &pairwiseUnion);
+    gSkPathOpsSweepMinPairs = minPairs;
+
+    REPORTER_ASSERT(reporter, sweptSimplifyOk && pairwiseSimplifyOk);
+    REPORTER_ASSERT(reporter, sweptSimplify == pairwiseSimplify);
+    REPORTER_ASSERT(reporter, sweptUnionOk && pairwiseUnionOk);
+    REPORTER_ASSERT(reporter, sweptUnion == pairwiseUnion);
+}
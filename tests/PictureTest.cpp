@@ -11,18 +11,22 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPixelRef.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/utils/SkRandom.h"
@@ -968,3 +972,158 @@ DEF_TEST(Picture_fillsBBH, r) {
                         "results.size() == %d, want %d\n", (int)results.size(), n);
     }
 }
+
+static sk_sp<SkImage> make_blue_image() {
+    SkBitmap bm;
+    bm.allocN32Pixels(8, 8);
+    bm.eraseColor(SK_ColorBLUE);
+    return SkImage::MakeFromBitmap(bm);
+}
+
+// Records paths, the image and a nested picture, for the tests of loading pictures.
+static void draw_loading_test_content(SkCanvas* c, const SkPaint& paint,
+                                      const sk_sp<SkImage>& image) {
+    SkPictureRecorder rec;
+    rec.beginRecording({0,0, 20,20})->drawPath(SkPath().addCircle(10, 10, 8), SkPaint{});
+    sk_sp<SkPicture> nested = rec.finishRecordingAsPicture();
+
+    c->drawPath(SkPath().moveTo(10, 10).quadTo(90, 10, 90, 90).lineTo(10, 60), paint);
+    c->drawPath(SkPath().addRRect(SkRRect::MakeRectXY({20,20, 60,60}, 5, 5)), paint);
+    c->drawImage(image, 70, 70);
+    c->save();
+        c->clipPath(SkPath().addOval({0,50, 50,100}), true);
+        c->drawPicture(nested, nullptr, nullptr);
+        c->translate(20, 50);
+        c->drawPicture(nested, nullptr, nullptr);
+    c->restore();
+}
+
+static SkBitmap draw_100x100(const SkPicture* pic) {
+    SkBitmap dst;
+    dst.allocN32Pixels(100, 100);
+    SkCanvas canvas(dst);
+    canvas.clear(SK_ColorWHITE);
+    canvas.drawPicture(pic);
+    return dst;
+}
+
+static void check_cut_short_pictures_fail(skiatest::Reporter* r, const SkData* data) {
+    for (size_t size : {data->size() / 4, data->size() / 2, data->size() - 4}) {
+        sk_sp<SkData> part = SkData::MakeSubset(data, 0, size);
+        REPORTER_ASSERT(r, !SkPicture::MakeFromData(part.get()));
+        REPORTER_ASSERT(r, !SkPicture::MakeLazyFromData(part));
+    }
+}
+
+DEF_TEST(Picture_lazy, r) {
+    SkPictureRecorder rec;
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    draw_loading_test_content(rec.beginRecording({0,0, 100,100}), paint, make_blue_image());
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    sk_sp<SkPicture> eager = SkPicture::MakeFromData(data.get()),
+                     lazy  = SkPicture::MakeLazyFromData(data);
+    REPORTER_ASSERT(r, eager && lazy);
+    if (!eager || !lazy) {
+        return;
+    }
+    REPORTER_ASSERT(r, lazy->cullRect() == eager->cullRect());
+    REPORTER_ASSERT(r, lazy->approximateOpCount() > 0);
+
+    SkBitmap expected = draw_100x100(eager.get());
+    // The second time, the paths and image have already been decoded.
+    for (int i = 0; i < 2; i++) {
+        SkBitmap actual = draw_100x100(lazy.get());
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()));
+    }
+
+    // Lazy pictures serialize like any other.
+    sk_sp<SkPicture> reloaded = SkPicture::MakeFromData(lazy->serialize().get());
+    REPORTER_ASSERT(r, reloaded);
+    if (reloaded) {
+        SkBitmap actual = draw_100x100(reloaded.get());
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()));
+    }
+
+    check_cut_short_pictures_fail(r, data.get());
+}
+
+// Reads data without making its memory available, like a file or network stream.
+class ReadOnlyStream : public SkStream {
+public:
+    explicit ReadOnlyStream(const SkData* data) : fStream(data->data(), data->size()) {}
+    size_t read(void* buffer, size_t size) override { return fStream.read(buffer, size); }
+    bool isAtEnd() const override { return fStream.isAtEnd(); }
+
+private:
+    SkMemoryStream fStream;
+};
+
+DEF_TEST(Picture_record_serial, r) {
+    SkPictureRecorder rec;
+    SkCanvas* c = rec.beginRecording({0,0, 100,100});
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    paint.setAntiAlias(true);
+    sk_sp<SkImage> image = make_blue_image();
+    draw_loading_test_content(c, paint, image);
+    c->saveLayerAlpha(nullptr, 0x80);
+        c->drawRRect(SkRRect::MakeRectXY({5,60, 45,95}, 3, 7), paint);
+        c->drawImageRect(image, {40,70, 60,90}, nullptr);
+    c->restore();
+    const SkPoint pts[] = {{10.5f, 5}, {30, 5.25f}, {50, 1.0f / 3}};
+    paint.setStrokeWidth(2);
+    c->drawPoints(SkCanvas::kPolygon_PointMode, SK_ARRAY_COUNT(pts), pts, paint);
+    c->drawTextBlob(SkTextBlob::MakeFromString("Skia", SkFont(nullptr, 12)), 10, 40, paint);
+    // The same path, with the same gen ID, drawn with two fill types.
+    SkPath circles = SkPath().addCircle(70, 25, 8).addCircle(76, 25, 8);
+    paint.setColor(SK_ColorGREEN);
+    c->drawPath(circles, paint);
+    circles.setFillType(SkPathFillType::kEvenOdd);
+    c->translate(0, 20);
+    c->drawPath(circles, paint);
+    sk_sp<SkPicture> picture = rec.finishRecordingAsPicture();
+
+    sk_sp<SkData> legacy = picture->serialize(),
+                  data   = SkPicturePriv::SerializeRecord(picture.get());
+    REPORTER_ASSERT(r, data->size() < legacy->size(),
+                    "%zu bytes, legacy format is %zu\n", data->size(), legacy->size());
+
+    sk_sp<SkPicture> loaded = SkPicture::MakeFromData(data.get());
+    REPORTER_ASSERT(r, loaded);
+    if (!loaded) {
+        return;
+    }
+    // The commands are loaded straight into an SkBigPicture, with a bounding box hierarchy.
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(loaded);
+    REPORTER_ASSERT(r, big && big->bbh());
+    REPORTER_ASSERT(r, loaded->cullRect() == picture->cullRect());
+    REPORTER_ASSERT(r, loaded->approximateOpCount() > 0);
+
+    // Images are decoded the same way from either format.
+    SkBitmap expected = draw_100x100(SkPicture::MakeFromData(legacy.get()).get()),
+             actual   = draw_100x100(loaded.get());
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+
+    // Memory is read in place, and images share it when it is SkData. Other streams are copied
+    // first.
+    ReadOnlyStream stream(data.get());
+    for (const sk_sp<SkPicture>& other : {SkPicture::MakeLazyFromData(data),
+                                          SkPicture::MakeFromStream(&stream)}) {
+        REPORTER_ASSERT(r, other);
+        if (other) {
+            actual = draw_100x100(other.get());
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                           expected.computeByteSize()));
+        }
+    }
+
+    // Loaded pictures write the same data again.
+    REPORTER_ASSERT(r, SkPicturePriv::SerializeRecord(loaded.get())->equals(data.get()));
+
+    check_cut_short_pictures_fail(r, data.get());
+}
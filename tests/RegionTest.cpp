@@ -515,3 +515,39 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+// Intervals that only one operand has on a span, before or after all of the other operand's,
+// are copied as a block; they must still join intervals they touch.
+DEF_TEST(region_op_disjoint_spans, reporter) {
+    SkRegion a, b;
+    for (int i = 0; i < 8; ++i) {
+        a.op(SkIRect::MakeXYWH(i * 10, 0, 5, 10), SkRegion::kUnion_Op);
+        b.op(SkIRect::MakeXYWH(75 + i * 10, 5, 5, 10), SkRegion::kUnion_Op);
+    }
+
+    SkRegion result;
+    result.op(a, b, SkRegion::kUnion_Op);
+    REPORTER_ASSERT(reporter, result.computeRegionComplexity() == 8 + 15 + 8);
+    // a's last interval, [70, 75), joins b's first, [75, 80), where both have rows.
+    REPORTER_ASSERT(reporter, result.contains(SkIRect::MakeLTRB(70, 5, 80, 10)));
+    REPORTER_ASSERT(reporter, !result.contains(75, 2));
+    REPORTER_ASSERT(reporter, !result.contains(70, 12));
+
+    for (int x = -1; x < 160; ++x) {
+        for (int y = -1; y < 16; ++y) {
+            bool inA = a.contains(x, y),
+                 inB = b.contains(x, y);
+            SkRegion r;
+            r.op(a, b, SkRegion::kUnion_Op);
+            REPORTER_ASSERT(reporter, r.contains(x, y) == (inA || inB));
+            r.op(a, b, SkRegion::kXOR_Op);
+            REPORTER_ASSERT(reporter, r.contains(x, y) == (inA != inB));
+            r.op(a, b, SkRegion::kDifference_Op);
+            REPORTER_ASSERT(reporter, r.contains(x, y) == (inA && !inB));
+            r.op(a, b, SkRegion::kReverseDifference_Op);
+            REPORTER_ASSERT(reporter, r.contains(x, y) == (inB && !inA));
+            r.op(a, b, SkRegion::kIntersect_Op);
+            REPORTER_ASSERT(reporter, r.contains(x, y) == (inA && inB));
+        }
+    }
+}
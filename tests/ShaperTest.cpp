@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace {
 struct RunHandler final : public SkShaper::RunHandler {
@@ -91,8 +92,64 @@ void cluster_test(skiatest::Reporter* reporter, const char* resource) {
     shaper_test(reporter, resource, data.get());
 }
 
+struct GlyphCollector final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<uint32_t> fClusters;
+    std::unique_ptr<SkPoint[]> fPositions;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        size_t start = fGlyphs.size();
+        fGlyphs.resize(start + info.glyphCount);
+        fClusters.resize(start + info.glyphCount);
+        fPositions.reset(new SkPoint[info.glyphCount]);
+        return { fGlyphs.data() + start, fPositions.get(), nullptr, fClusters.data() + start,
+                 {0, 0} };
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override {}
+};
+
 }  // namespace
 
+#ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+DEF_TEST(Shaper_word_cache, reporter) {
+    auto data = GetResourceAsData("text/english.txt");
+    auto shaper = SkShaper::MakeShapeThenWrap();
+    if (!data || !shaper) {
+        return;
+    }
+    const char* text = (const char*)data->data();
+    SkFont font(SkTypeface::MakeDefault());
+
+    auto shape = [&](GlyphCollector* collector) {
+        shaper->shape(text, data->size(), font, true, 400, collector);
+    };
+
+    GlyphCollector uncached;
+    shape(&uncached);
+
+    SkShaper::PurgeWordCache();
+    SkShaper::SetWordCacheEnabled(true);
+    GlyphCollector first, second;
+    shape(&first);
+    SkShaper::WordCacheStats afterFirst = SkShaper::GetWordCacheStats();
+    shape(&second);
+    SkShaper::WordCacheStats afterSecond = SkShaper::GetWordCacheStats();
+    SkShaper::SetWordCacheEnabled(false);
+    SkShaper::PurgeWordCache();
+
+    REPORTER_ASSERT(reporter, afterFirst.fCount > 0);
+    REPORTER_ASSERT(reporter, afterSecond.fMisses == afterFirst.fMisses);
+    REPORTER_ASSERT(reporter, afterSecond.fHits > afterFirst.fHits);
+    REPORTER_ASSERT(reporter, first.fGlyphs == second.fGlyphs);
+    REPORTER_ASSERT(reporter, first.fClusters == second.fClusters);
+    REPORTER_ASSERT(reporter, uncached.fClusters == first.fClusters);
+}
+#endif
+
 DEF_TEST(Shaper_cluster_empty, r) { shaper_test(r, "empty", SkData::MakeEmpty().get()); }
 
 #define SHAPER_TEST(X) DEF_TEST(Shaper_cluster_ ## X, r) { cluster_test(r, "text/" #X ".txt"); }
@@ -1,6 +1,7 @@
 // Copyright 2019 Google LLC.
 #include <sstream>
 #include <thread>
+#include "include/core/SkExecutor.h"
 #include "modules/skparagraph/include/TypefaceFontProvider.h"
 #include "modules/skparagraph/src/ParagraphBuilderImpl.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
@@ -4796,6 +4797,51 @@ DEF_TEST(SkParagraph_CacheStyles, reporter) {
     test(2, false);
 }
 
+DEF_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto make = [&](int i) {
+        SkString text;
+        for (int j = 0; j <= i % 7; ++j) {
+            text.appendf("Paragraph %d has some words to wrap. ", i);
+        }
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    constexpr int kCount = 64;
+    std::vector<std::unique_ptr<Paragraph>> serial, parallel;
+    std::vector<Paragraph*> batch;
+    for (int i = 0; i < kCount; ++i) {
+        serial.push_back(make(i));
+        serial.back()->layout(TestCanvasWidth / 4);
+        parallel.push_back(make(i));
+        batch.push_back(parallel.back().get());
+    }
+
+    fontCollection->getParagraphCache()->reset();
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    layoutAll(SkMakeSpan(batch), TestCanvasWidth / 4, *executor);
+
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, serial[i]->lineNumber() == parallel[i]->lineNumber());
+        REPORTER_ASSERT(reporter, serial[i]->getHeight() == parallel[i]->getHeight());
+        REPORTER_ASSERT(reporter, serial[i]->getLongestLine() == parallel[i]->getLongestLine());
+    }
+}
+
 DEF_TEST(SkParagraph_EmptyParagraphWithLineBreak, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     if (!fontCollection->fontsFound()) return;
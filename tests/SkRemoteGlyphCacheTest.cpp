@@ -491,6 +491,56 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_DrawTextAsPath, reporter,
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_CompactWireFormat, reporter, ctxInfo) {
+    auto serverTf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTf, glyphCount);
+    auto props = FindSurfaceProps(ctxInfo.grContext());
+
+    // Send both masks and, using a hairline, paths.
+    SkPaint maskPaint;
+    SkPaint pathPaint;
+    pathPaint.setStyle(SkPaint::kStroke_Style);
+    pathPaint.setStrokeWidth(0);
+
+    size_t strikeDataSize[2];
+    for (bool compact : {false, true}) {
+        sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
+        SkStrikeServer server(discardableManager.get());
+        server.setCompactWireFormat(compact);
+        SkStrikeClient client(discardableManager, false);
+
+        // Server.
+        auto serverTfData = server.serializeTypeface(serverTf.get());
+        SkTextBlobCacheDiffCanvas cache_diff_canvas(
+                10, 10, props, &server, ctxInfo.grContext()->supportsDistanceFieldText());
+        cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, maskPaint);
+        cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, pathPaint);
+
+        std::vector<uint8_t> serverStrikeData;
+        server.writeStrikeData(&serverStrikeData);
+        strikeDataSize[compact] = serverStrikeData.size();
+
+        // Client.
+        auto clientTf = client.deserializeTypeface(serverTfData->data(), serverTfData->size());
+        REPORTER_ASSERT(reporter,
+                        client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+        auto clientBlob = buildTextBlob(clientTf, glyphCount);
+
+        for (const SkPaint& paint : {maskPaint, pathPaint}) {
+            SkBitmap expected = RasterBlob(serverBlob, 10, 10, paint, ctxInfo.grContext());
+            SkBitmap actual = RasterBlob(clientBlob, 10, 10, paint, ctxInfo.grContext());
+            compare_blobs(expected, actual, reporter, 1);
+        }
+        REPORTER_ASSERT(reporter, !discardableManager->hasCacheMiss());
+
+        // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+        discardableManager->unlockAndDeleteAll();
+    }
+
+    REPORTER_ASSERT(reporter, strikeDataSize[true] < strikeDataSize[false]);
+}
+
 sk_sp<SkTextBlob> make_blob_causing_fallback(
         sk_sp<SkTypeface> targetTf, const SkTypeface* glyphTf, skiatest::Reporter* reporter) {
     SkFont font;
@@ -6,14 +6,21 @@
  */
 
 #include "include/core/SkFont.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/core/SkTypeface.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkScalerCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkStrikeCache.h"
 #include "src/core/SkTaskGroup.h"
+#include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
+#include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 
 #include <atomic>
+#include <cstdio>
+#include <cstring>
 
 class Barrier {
 public:
@@ -83,3 +90,138 @@ DEF_TEST(SkScalerCacheMultiThread, Reporter) {
         SkTaskGroup(*executor).batch(kThreadCount, perThread);
     }
 }
+
+DEF_TEST(SkStrikeCachePersistent, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (tmpDir.isEmpty() || typeface == nullptr) {
+        return;
+    }
+
+    SkFont font{typeface, 24};
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    SkGlyphID glyphIDs[4];
+    font.textToGlyphs("Skia", 4, SkTextEncoding::kUTF8, glyphIDs, 4);
+    SkPackedGlyphID packedIDs[4];
+    for (int i = 0; i < 4; i++) {
+        packedIDs[i] = SkPackedGlyphID{glyphIDs[i]};
+    }
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    const SkGlyph* glyphs[4];
+    std::vector<std::vector<uint8_t>> images;
+    {
+        SkStrikeCache cache;
+        cache.setPersistentCacheDirectory(tmpDir.c_str());
+        SkExclusiveStrikePtr strike = strikeSpec.findOrCreateExclusiveStrike(&cache);
+        strike->prepareImages(SkMakeSpan(packedIDs), glyphs);
+        for (const SkGlyph* glyph : glyphs) {
+            auto image = static_cast<const uint8_t*>(glyph->image());
+            images.emplace_back(image, image + (image ? glyph->imageSize() : 0));
+        }
+        cache.writePersistentCache();
+    }
+
+    // A new cache using the same directory starts with the glyphs already generated.
+    {
+        SkStrikeCache cache;
+        cache.setPersistentCacheDirectory(tmpDir.c_str());
+        SkExclusiveStrikePtr strike = strikeSpec.findOrCreateExclusiveStrike(&cache);
+        REPORTER_ASSERT(reporter, strike->fScalerCache.countCachedGlyphs() == 4);
+        strike->prepareImages(SkMakeSpan(packedIDs), glyphs);
+        for (int i = 0; i < 4; i++) {
+            auto image = static_cast<const uint8_t*>(glyphs[i]->image());
+            std::vector<uint8_t> loaded(image, image + (image ? glyphs[i]->imageSize() : 0));
+            REPORTER_ASSERT(reporter, loaded == images[i]);
+        }
+    }
+
+    SkOSFile::Iter iter(tmpDir.c_str(), ".strike");
+    for (SkString name; iter.next(&name);) {
+        std::remove(SkOSPath::Join(tmpDir.c_str(), name.c_str()).c_str());
+    }
+}
+
+// Keep the atlas's hit and miss counts from a memory dump.
+class AtlasCountsDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char* valueName, const char* units,
+                          uint64_t value) override {
+        if (0 == strcmp(valueName, "hits")) {
+            fHits = value;
+        } else if (0 == strcmp(valueName, "misses")) {
+            fMisses = value;
+        }
+    }
+    void setMemoryBacking(const char* dumpName, const char* backingType,
+                          const char* backingObjectId) override { }
+    void setDiscardableMemoryBacking(
+        const char* dumpName,
+        const SkDiscardableMemory& discardableMemoryObject) override { }
+    LevelOfDetail getRequestedDetails() const override {
+        return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+    }
+
+    uint64_t fHits = 0;
+    uint64_t fMisses = 0;
+};
+
+DEF_TEST(SkScalerCacheAtlas, reporter) {
+    sk_sp<SkTypeface> typeface = ToolUtils::create_portable_typeface("serif", SkFontStyle());
+
+    // The space has no image, and must not keep the run off the lock-free path.
+    SkFont font{typeface, 24};
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    SkGlyphID glyphIDs[5];
+    font.textToGlyphs("Sk ia", 5, SkTextEncoding::kUTF8, glyphIDs, 5);
+    SkPoint positions[5];
+    for (int i = 0; i < 5; i++) {
+        positions[i] = {20.0f * i, 30.0f};
+    }
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    SkScalerContextEffects effects;
+    std::unique_ptr<SkScalerContext> ctx{
+            typeface->createScalerContext(effects, &strikeSpec.descriptor())};
+    SkScalerCache scalerCache{strikeSpec.descriptor(), std::move(ctx)};
+
+    // The first draw packs the glyphs under the lock, which the atlas counts as misses. The
+    // second finds them without locking, which it counts as hits.
+    for (int draw = 0; draw < 2; draw++) {
+        SkDrawableGlyphBuffer drawables;
+        drawables.ensureSize(5);
+        drawables.startDevice(SkMakeZip(glyphIDs, positions), {0, 0}, SkMatrix::I(),
+                              scalerCache.roundingSpec());
+        scalerCache.prepareForDrawingMasksCPU(&drawables);
+
+        int drawn = 0;
+        for (auto [variant, pos] : drawables.drawable()) {
+            const SkGlyph* glyph = variant.glyph();
+            SkMask mask = glyph->mask(pos),
+                   atlasMask = glyph->atlasMask(pos);
+            REPORTER_ASSERT(reporter, SkGlyphAtlas::Contains(*glyph));
+            REPORTER_ASSERT(reporter, mask.fBounds == atlasMask.fBounds);
+            REPORTER_ASSERT(reporter, mask.fImage != atlasMask.fImage);
+            for (int y = 0; y < mask.fBounds.height(); y++) {
+                REPORTER_ASSERT(reporter,
+                                0 == memcmp(mask.fImage + y * mask.fRowBytes,
+                                            atlasMask.fImage + y * atlasMask.fRowBytes,
+                                            mask.fBounds.width()));
+            }
+            drawn++;
+        }
+        REPORTER_ASSERT(reporter, drawn == 4);
+
+        AtlasCountsDump dump;
+        scalerCache.dumpAtlasMemoryStatistics(&dump, "atlas");
+        REPORTER_ASSERT(reporter, dump.fHits == (draw == 0 ? 0 : 4));
+        REPORTER_ASSERT(reporter, dump.fMisses == 4);
+    }
+}
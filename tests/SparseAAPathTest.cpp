@@ -0,0 +1,289 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/core/SkStrokeRec.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+#include "tests/Test.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Sets the AA globals so that AntiFillPath uses sparse AA wherever it can, and puts them back
+// when it goes out of scope.
+class AutoForceSparseAA {
+public:
+    AutoForceSparseAA()
+            : fForceAnalyticAA(gSkForceAnalyticAA.exchange(false))
+            , fUseSparseAA(gSkUseSparseAA.exchange(true))
+            , fForceSparseAA(gSkForceSparseAA.exchange(true)) {}
+    ~AutoForceSparseAA() {
+        gSkForceAnalyticAA = fForceAnalyticAA;
+        gSkUseSparseAA = fUseSparseAA;
+        gSkForceSparseAA = fForceSparseAA;
+    }
+
+private:
+    bool fForceAnalyticAA, fUseSparseAA, fForceSparseAA;
+};
+
+constexpr int kSize = 160;
+
+SkBitmap draw(const SkPath& path, const SkPaint& paint, const SkIRect* clip = nullptr) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(kSize, kSize));
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bitmap);
+    if (clip) {
+        canvas.clipRect(SkRect::Make(*clip));
+    }
+    canvas.drawPath(path, paint);
+    return bitmap;
+}
+
+// Draws the path without anti-aliasing at kScale times the size, and averages each kScale x
+// kScale block of samples into one pixel.
+SkBitmap draw_supersampled(const SkPath& path, const SkIRect* clip) {
+    constexpr int kScale = 16;
+    SkBitmap big;
+    big.allocPixels(SkImageInfo::MakeA8(kSize * kScale, kSize * kScale));
+    big.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(big);
+    canvas.scale(kScale, kScale);
+    if (clip) {
+        canvas.clipRect(SkRect::Make(*clip));
+    }
+    canvas.drawPath(path, SkPaint());
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(kSize, kSize));
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            int sum = 0;
+            for (int sy = 0; sy < kScale; ++sy) {
+                for (int sx = 0; sx < kScale; ++sx) {
+                    sum += *big.getAddr8(x * kScale + sx, y * kScale + sy);
+                }
+            }
+            *bitmap.getAddr8(x, y) = (uint8_t)((sum + kScale * kScale / 2) / (kScale * kScale));
+        }
+    }
+    return bitmap;
+}
+
+// Checks that actual is within tolerance of expected, except for the two pixels at most that
+// each edge crossing touches. Like AAA, sparse AA only approximates the coverage of pixels where
+// edges cross.
+void compare(skiatest::Reporter* r, const char* name, const SkBitmap& actual,
+             const SkBitmap& expected, int tolerance, int crossings) {
+    int outliers = 0;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            int a = *actual.getAddr8(x, y),
+                e = *expected.getAddr8(x, y);
+            if (std::abs(a - e) > tolerance && ++outliers > 2 * crossings) {
+                ERRORF(r, "%s: pixel (%d, %d) is %d, expected %d", name, x, y, a, e);
+                return;
+            }
+        }
+    }
+}
+
+// Checks the coverage of the path filled with sparse AA against 16x16 supersampled coverage.
+void check_coverage(skiatest::Reporter* r, const char* name, const SkPath& path, int tolerance,
+                    int crossings = 0, const SkIRect* clip = nullptr) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    SkBitmap actual;
+    {
+        AutoForceSparseAA force;
+        actual = draw(path, paint, clip);
+    }
+    compare(r, name, actual, draw_supersampled(path, clip), tolerance, crossings);
+}
+
+// A closed polygon of count points around (80, 80), where point i is step * i / count of the way
+// around, at radius(i, angle).
+template <typename Fn>
+SkPath polar_polygon(int count, int step, Fn&& radius) {
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        float angle = i * step * 2 * SK_FloatPI / count;
+        SkPoint p = SkPoint::Make(80, 80) + SkVector::Make(std::cos(angle), std::sin(angle)) *
+                                            radius(i, angle);
+        if (i == 0) {
+            path.moveTo(p);
+        } else {
+            path.lineTo(p);
+        }
+    }
+    path.close();
+    return path;
+}
+
+// A star with count points, every other one pulled in to innerRadius.
+SkPath star(int count, float innerRadius) {
+    return polar_polygon(count, 1, [=](int i, float) { return i % 2 ? innerRadius : 70; });
+}
+
+}  // namespace
+
+// Sparse AA accumulates the exact area under each line, so polygons are within a few pixel
+// values of the reference. Curves are flattened into lines within 1/16 of a pixel of them.
+DEF_TEST(SparseAAPath_coverage, r) {
+    check_coverage(r, "convex", star(40, 68), 8);
+    check_coverage(r, "concave", star(40, 30), 8);
+
+    SkPath curves;
+    curves.addCircle(80, 80, 50);
+    curves.addOval({55, 65, 105, 95}, SkPathDirection::kCCW);
+    curves.moveTo(120, 150);
+    curves.cubicTo(120, 120, 155, 120, 155, 150);
+    curves.cubicTo(150, 140, 125, 140, 120, 150);
+    check_coverage(r, "curves", curves, 16);
+
+    // A seven pointed star drawn without lifting the pen. Its edges cross 14 times, and its
+    // middle is wound twice.
+    SkPath crossing = polar_polygon(7, 3, [](int, float) { return 70; });
+    check_coverage(r, "winding", crossing, 8, 14);
+    crossing.setFillType(SkPathFillType::kEvenOdd);
+    check_coverage(r, "even-odd", crossing, 8, 14);
+
+    // Sparse AA leaves inverse fills to the scanline fillers, which may supersample 4x4.
+    SkPath inverse = star(40, 30);
+    inverse.setFillType(SkPathFillType::kInverseWinding);
+    check_coverage(r, "inverse", inverse, 32);
+    inverse.setFillType(SkPathFillType::kInverseEvenOdd);
+    check_coverage(r, "inverse even-odd", inverse, 32);
+
+    // Clipped by the clip, and by the edges of the bitmap.
+    const SkIRect clip = {30, 20, 120, 130};
+    check_coverage(r, "clipped", star(40, 30), 8, 0, &clip);
+    SkPath offscreen = star(40, 30);
+    offscreen.offset(-50, 60);
+    check_coverage(r, "offscreen", offscreen, 8);
+
+    // A path with enough points that AntiFillPath picks sparse AA without being forced to.
+    SkPath many = polar_polygon(4096, 1, [](int, float angle) {
+        return 55 + 10 * std::sin(7 * angle);
+    });
+    check_coverage(r, "many points", many, 8);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    SkBitmap forced;
+    {
+        AutoForceSparseAA force;
+        forced = draw(many, paint);
+    }
+    SkBitmap byDefault = draw(many, paint);
+    REPORTER_ASSERT(r, !memcmp(forced.getPixels(), byDefault.getPixels(),
+                               forced.computeByteSize()));
+}
+
+// Sparse AA strokes polylines without building their outline. Compare them with the outline
+// SkStroke builds, filled with 16x16 supersampling.
+DEF_TEST(SparseAAPath_stroke, r) {
+    // A zigzag that turns by a different angle at each point, from nearly straight back to
+    // nearly reversing.
+    SkPath zigzag;
+    zigzag.moveTo(20, 30);
+    const SkPoint zigs[] = {{50, 30}, {75, 45}, {100, 20}, {110, 60}, {60, 70}, {140, 75},
+                            {30, 90}, {70, 130}, {80, 105}, {135, 140}};
+    for (SkPoint p : zigs) {
+        zigzag.lineTo(p);
+    }
+    SkPath closed = star(10, 40);
+
+    const SkPaint::Join joins[] = {SkPaint::kMiter_Join, SkPaint::kRound_Join,
+                                   SkPaint::kBevel_Join};
+    const SkPaint::Cap caps[] = {SkPaint::kButt_Cap, SkPaint::kRound_Cap, SkPaint::kSquare_Cap};
+    for (SkPaint::Join join : joins) {
+        for (SkPaint::Cap cap : caps) {
+            // The default miter limit, and one low enough that only some joins are mitered.
+            for (SkScalar miter : {4.0f, 1.5f}) {
+                if (miter != 4 && join != SkPaint::kMiter_Join) {
+                    continue;
+                }
+                for (const SkPath* path : {&zigzag, &closed}) {
+                    SkPaint paint;
+                    paint.setAntiAlias(true);
+                    paint.setStyle(SkPaint::kStroke_Style);
+                    paint.setStrokeWidth(7);
+                    paint.setStrokeJoin(join);
+                    paint.setStrokeCap(cap);
+                    paint.setStrokeMiter(miter);
+
+                    SkPath outline;
+                    paint.getFillPath(*path, &outline);
+                    SkBitmap actual;
+                    {
+                        AutoForceSparseAA force;
+                        actual = draw(*path, paint);
+                    }
+                    // Both flatten round joins and caps to within a sixteenth of a pixel.
+                    SkString name = SkStringPrintf("%s stroke, join %d, cap %d, miter %g",
+                                                   path == &zigzag ? "open" : "closed",
+                                                   join, cap, miter);
+                    compare(r, name.c_str(), actual, draw_supersampled(outline, nullptr), 16, 0);
+                }
+            }
+        }
+    }
+}
+
+// Records how far right a blitter is asked to draw, and checks that each row of runs is whole.
+class RunCheckingBlitter : public SkBlitter {
+public:
+    RunCheckingBlitter(skiatest::Reporter* reporter) : fReporter(reporter) {}
+
+    void blitH(int x, int y, int width) override {
+        REPORTER_ASSERT(fReporter, width > 0);
+        fRight = std::max(fRight, x + width);
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        while (runs[0] != 0) {
+            if (runs[0] < 0) {
+                ERRORF(fReporter, "run of %d at (%d, %d)", runs[0], x, y);
+                return;
+            }
+            if (antialias[0] != 0) {
+                fRight = std::max(fRight, x + runs[0]);
+            }
+            x += runs[0];
+            antialias += runs[0];
+            runs += runs[0];
+        }
+    }
+
+    int right() const { return fRight; }
+
+private:
+    skiatest::Reporter* fReporter;
+    int fRight = 0;
+};
+
+// Sparse AA passes the blitter int16_t runs, so like AntiFillPath it only draws up to 32767.
+DEF_TEST(SparseAAPath_wide_stroke, r) {
+    SkPath path;
+    path.moveTo(10, 4);
+    path.lineTo(39990, 4);
+    SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+    rec.setStrokeStyle(2);
+    SkRasterClip clip(SkIRect::MakeWH(40000, 8));
+    RunCheckingBlitter blitter(r);
+    REPORTER_ASSERT(r, SkScan::SparseAAStrokePath(path, SkMatrix::I(), rec, nullptr, clip,
+                                                  &blitter));
+    REPORTER_ASSERT(r, blitter.right() == 32767, "drew up to %d", blitter.right());
+}
@@ -367,6 +367,41 @@ DEF_TEST(Typeface_glyph_to_char, reporter) {
     }
 }
 
+// The cmap cache answers runs of Latin-1 without asking the font host; check it gives the same
+// glyphs as single lookups, and that characters outside the Basic Multilingual Plane still work.
+DEF_TEST(Typeface_cmap_cache, reporter) {
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        return;
+    }
+
+    const SkUnichar chars[] = {
+        'T', 'h', 'e', ' ', 'q', 'u', 'i', 'c', 'k', ' ', 'b', 'r', 'o', 'w', 'n', ' ',
+        0xE9, 0x3A9, 'f', 'o', 'x', 0x1F600, -1, 0x110000, 'j', 'u', 'm', 'p', 's', '!',
+    };
+    constexpr int kCount = SK_ARRAY_COUNT(chars);
+
+    // Look up the characters one at a time on a new typeface, so each block is filled by a
+    // different path than the batch below takes.
+    sk_sp<SkTypeface> single = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    SkGlyphID expected[kCount];
+    for (int i = kCount; i --> 0;) {
+        expected[i] = single->unicharToGlyph(chars[i]);
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        SkGlyphID glyphs[kCount];
+        typeface->unicharsToGlyphs(chars, kCount, glyphs);
+        for (int i = 0; i < kCount; i++) {
+            REPORTER_ASSERT(reporter, glyphs[i] == expected[i],
+                            "pass:%d i:%d char:%d glyph:%d expected:%d",
+                            pass, i, chars[i], glyphs[i], expected[i]);
+        }
+    }
+
+    REPORTER_ASSERT(reporter, expected[0] != 0);
+}
+
 // This test makes sure the legacy typeface creation does not lose its specified
 // style. See https://bugs.chromium.org/p/skia/issues/detail?id=8447 for more
 // context.
@@ -38,6 +38,7 @@ bool CollectImages(CommandLineFlags::StringArray dir, SkTArray<SkString>* output
 void SetCtxOptionsFromCommonFlags(struct GrContextOptions*);
 
 /**
- *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA.
+ *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA,
+ *  and sparse tile anti-aliasing using --sparseAA and --forceSparseAA.
  */
 void SetAnalyticAAFromCommonFlags();
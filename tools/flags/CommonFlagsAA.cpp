@@ -9,8 +9,14 @@ static DEFINE_bool(forceAnalyticAA, false,
             "Force analytic anti-aliasing even if the path is complicated: "
             "whether it's concave or convex, we consider a path complicated"
             "if its number of points is comparable to its resolution.");
+static DEFINE_bool(sparseAA, true, "If false, disable sparse tile anti-aliasing");
+static DEFINE_bool(forceSparseAA, false,
+            "Force sparse tile anti-aliasing for every path that isn't inverse filled, "
+            "instead of only for paths with many points.");
 
 void SetAnalyticAAFromCommonFlags() {
     gSkUseAnalyticAA   = FLAGS_analyticAA;
     gSkForceAnalyticAA = FLAGS_forceAnalyticAA;
+    gSkUseSparseAA     = FLAGS_sparseAA;
+    gSkForceSparseAA   = FLAGS_forceSparseAA;
 }